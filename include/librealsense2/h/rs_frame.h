@@ -20,6 +20,7 @@ typedef enum rs2_timestamp_domain
 {
     RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK, /**< Frame timestamp was measured in relation to the camera clock */
     RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME,    /**< Frame timestamp was measured in relation to the OS system clock */
+    RS2_TIMESTAMP_DOMAIN_BACKEND_TIME,   /**< Frame timestamp was taken by the host driver when the frame completed, in OS system clock */
     RS2_TIMESTAMP_DOMAIN_COUNT           /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_timestamp_domain;
 const char* rs2_timestamp_domain_to_string(rs2_timestamp_domain info);
@@ -36,6 +37,7 @@ typedef enum rs2_frame_metadata_value
     RS2_FRAME_METADATA_AUTO_EXPOSURE        , /**< Auto Exposure Mode indicator. Zero corresponds to AE switched off. */
     RS2_FRAME_METADATA_WHITE_BALANCE        , /**< White Balance setting as a color temperature. Kelvin degrees*/
     RS2_FRAME_METADATA_TIME_OF_ARRIVAL      , /**< Time of arrival in system clock */
+    RS2_FRAME_METADATA_BACKEND_TIMESTAMP    , /**< Time the host driver completed the frame at, in system clock. usec*/
     RS2_FRAME_METADATA_COUNT
 } rs2_frame_metadata_value;
 const char* rs2_frame_metadata_to_string(rs2_frame_metadata_value metadata);
@@ -53,6 +55,19 @@ typedef struct rs2_pixel
     int ij[2];
 } rs2_pixel;
 
+/** \brief Samples of a batched motion frame, one array per attribute, all valid as long as the frame is held */
+typedef struct rs2_motion_batch
+{
+    int                         count;          /**< Number of samples in every array */
+    const double*               timestamps;     /**< Timestamp of every sample, in milliseconds */
+    const unsigned long long*   frame_numbers;  /**< Frame number of every sample */
+    const float*                x;
+    const float*                y;
+    const float*                z;
+    const unsigned char*        metadata;       /**< Raw metadata of every sample, metadata_size bytes each, zeroed for a sample that arrived without it */
+    int                         metadata_size;  /**< Bytes of metadata per sample, 0 when the sensor provides none */
+} rs2_motion_batch;
+
 
 /**
 * retrieve metadata from frame handle
@@ -128,6 +143,39 @@ int rs2_get_frame_height(const rs2_frame* frame, rs2_error** error);
 */
 int rs2_get_frame_stride_in_bytes(const rs2_frame* frame, rs2_error** error);
 
+/**
+* retrieve the dma-buf file descriptor of a frame captured into an exported kernel buffer (see RS2_EXTENSION_DMABUF_FRAME)
+* the descriptor is owned by the library, and refers to the frame pixels as long as the frame is not released
+* \param[in] frame      handle returned from a callback
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               dma-buf file descriptor
+*/
+int rs2_get_frame_dmabuf_fd(const rs2_frame* frame, rs2_error** error);
+
+/**
+* retrieve the offset of the first pixel of a frame within its dma-buf
+* \param[in] frame      handle returned from a callback
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               offset in bytes
+*/
+unsigned int rs2_get_frame_dmabuf_offset(const rs2_frame* frame, rs2_error** error);
+
+/**
+* retrieve the stride of a frame within its dma-buf, as laid out by the driver
+* \param[in] frame      handle returned from a callback
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return               stride in bytes
+*/
+unsigned int rs2_get_frame_dmabuf_stride(const rs2_frame* frame, rs2_error** error);
+
+/**
+* retrieve the samples of a batched motion frame (see RS2_EXTENSION_MOTION_BATCH_FRAME and RS2_OPTION_MOTION_BATCH_SIZE)
+* \param[in] frame      handle returned from a callback
+* \param[out] batch     receives the number of samples and the arrays holding them
+* \param[out] error     if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_motion_batch(const rs2_frame* frame, rs2_motion_batch* batch, rs2_error** error);
+
 /**
 * retrieve bits per pixels in the frame image
 * (note that bits per pixel is not necessarily divided by 8, as in 12bpp)
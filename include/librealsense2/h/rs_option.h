@@ -60,6 +60,14 @@ typedef enum rs2_option
     RS2_OPTION_FILTER_MAGNITUDE                           , /**< The 2D-filter effect. The specific interpretation is given within the context of the filter */
     RS2_OPTION_FILTER_SMOOTH_ALPHA                        , /**< 2D-filter parameter controls the weight/radius for smoothing.*/
     RS2_OPTION_FILTER_SMOOTH_DELTA                        , /**< 2D-filter range/validity threshold*/
+    RS2_OPTION_KERNEL_BUFFER_COUNT                        , /**< Number of frame buffers the kernel driver captures into, applied on the next stream start */
+    RS2_OPTION_ADAPTIVE_KERNEL_BUFFERS                    , /**< Add kernel frame buffers while streaming whenever the driver drops frames for lack of one */
+    RS2_OPTION_KERNEL_FRAME_DROPS                         , /**< Number of frames lost before reaching the library, either dropped by the kernel driver for lack of free buffers or lost on the USB link, as seen from gaps in the frame sequence */
+    RS2_OPTION_EXPORT_DMABUF                              , /**< Capture into frame buffers that can be shared as dma-bufs, applied on the next stream start */
+    RS2_OPTION_MOTION_BATCH_SIZE                          , /**< Number of motion samples delivered together in one frame, applied on the next stream start */
+    RS2_OPTION_WARM_RESTART                               , /**< Keep the negotiated formats, frame buffers and device power across close and open of the same profiles */
+    RS2_OPTION_OPEN_LATENCY                               , /**< Time the last open of the sensor took, in milliseconds */
+    RS2_OPTION_START_LATENCY                              , /**< Time from the last start of the sensor to its first frame, in milliseconds */
     RS2_OPTION_COUNT                                      , /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
 } rs2_option;
 const char* rs2_option_to_string(rs2_option option);
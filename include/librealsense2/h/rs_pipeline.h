@@ -15,6 +15,7 @@ extern "C" {
 #endif
 
 #include "rs_types.h"
+#include "rs_processing.h"
 
     /**
     * Create a pipeline instance
@@ -71,6 +72,17 @@ extern "C" {
     */
     int rs2_pipeline_poll_for_frames(rs2_pipeline* pipe, rs2_frame** output_frame, rs2_error ** error);
 
+    /**
+    * Retrieve statistics of the pipeline's frameset queue since the pipeline was started, including the wake latency of
+    * \c wait_for_frames() - the time from a frameset becoming ready to a waiting caller receiving it.
+    * The method is valid only while the pipeline is active.
+    *
+    * \param[in] pipe    the pipeline
+    * \param[out] stats  receives the statistics
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_pipeline_get_queue_stats(rs2_pipeline* pipe, rs2_frame_queue_stats* stats, rs2_error ** error);
+
 
     /**
     * Delete a pipeline instance.
@@ -286,6 +298,51 @@ extern "C" {
     */
     void rs2_config_disable_all_streams(rs2_config* config, rs2_error ** error);
 
+    /**
+    * Select how the pipeline hands framesets to \c wait_for_frames() and \c poll_for_frames().
+    * By default every complete frameset is queued until it is read. When latest-only is enabled, the pipeline keeps just
+    * the newest complete frameset, overwriting sets that were not read in time, and creates the frameset only when it is read.
+    * This suits applications that always process the most recent data and reduces the per-frame overhead of the pipeline.
+    *
+    * \param[in] config        A pointer to an instance of a config
+    * \param[in] latest_only   Non-zero to keep only the newest frameset, zero to queue all framesets
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_config_enable_latest_frameset_only(rs2_config* config, int latest_only, rs2_error ** error);
+
+    /**
+    * Make \c wait_for_frames() spin for up to the given budget before blocking.
+    * A spinning caller picks up a new frameset without the wake-up and scheduling latency of a blocked thread, at the price of
+    * keeping a core busy while waiting. This suits low-latency loops that dedicate a core to consuming frames.
+    *
+    * \param[in] config      A pointer to an instance of a config
+    * \param[in] budget_us   Max time in microseconds to spin before blocking, 0 blocks right away (default)
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_config_enable_busy_poll(rs2_config* config, unsigned int budget_us, rs2_error ** error);
+
+    /**
+    * Append a processing block to the post-processing stage of the pipeline.
+    * The blocks are applied in order to every complete frameset as serialized tasks on the processing executor the library
+    * shares between its processing blocks, so framesets reach \c wait_for_frames() already processed, and filtering overlaps
+    * with the application consuming the previous frameset. When processing falls behind, the oldest pending frameset is dropped.
+    * Each block receives the whole frameset, and the frames it outputs replace the frames of the same stream in the set.
+    * While the pipeline is streaming, the output of the blocks is redirected to the pipeline. Their previous output is restored when it stops.
+    *
+    * \param[in] config   A pointer to an instance of a config
+    * \param[in] block    The processing block to append
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_config_add_post_processing_block(rs2_config* config, rs2_processing_block* block, rs2_error ** error);
+
+    /**
+    * Remove all processing blocks from the post-processing stage of the pipeline.
+    *
+    * \param[in] config   A pointer to an instance of a config
+    * \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+    */
+    void rs2_config_clear_post_processing_blocks(rs2_config* config, rs2_error ** error);
+
     /**
     * Resolve the configuration filters, to find a matching device and streams profiles.
     * The method resolves the user configuration filters for the device and streams, and combines them with the requirements of
@@ -16,6 +16,38 @@ extern "C" {
 
 #include "rs_types.h"
 
+/** \brief Selects the implementation backing a frame queue */
+typedef enum rs2_frame_queue_type
+{
+    RS2_FRAME_QUEUE_TYPE_LOCKING,         /**< Mutex protected queue, any number of threads may enqueue and dequeue */
+    RS2_FRAME_QUEUE_TYPE_SINGLE_PRODUCER, /**< Lock-free ring, frames are enqueued from a single thread and dequeued from a single thread. Enqueuing from two threads at once corrupts the queue, and is only detected in debug builds */
+    RS2_FRAME_QUEUE_TYPE_MULTI_PRODUCER,  /**< Lock-free ring, frames are enqueued from any thread and dequeued from a single thread */
+    RS2_FRAME_QUEUE_TYPE_COUNT            /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_frame_queue_type;
+const char* rs2_frame_queue_type_to_string(rs2_frame_queue_type type);
+
+/** \brief Selects what a frame queue does with a frame arriving while it is full */
+typedef enum rs2_frame_queue_policy
+{
+    RS2_FRAME_QUEUE_POLICY_DROP_OLDEST, /**< Make room by dropping the oldest queued frame */
+    RS2_FRAME_QUEUE_POLICY_DROP_NEWEST, /**< Drop the arriving frame */
+    RS2_FRAME_QUEUE_POLICY_BLOCK,       /**< Block the producer until there is room or the block timeout expires, then drop the arriving frame */
+    RS2_FRAME_QUEUE_POLICY_KEEP_LATEST, /**< Drop all queued frames, so only the newest frame is kept */
+    RS2_FRAME_QUEUE_POLICY_COUNT        /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_frame_queue_policy;
+const char* rs2_frame_queue_policy_to_string(rs2_frame_queue_policy policy);
+
+/** \brief Frame queue statistics, accumulated since the queue was created. Frames are timed only after the statistics were first retrieved, so the residency and wake latency cover frames enqueued since then */
+typedef struct rs2_frame_queue_stats
+{
+    unsigned long long enqueued;  /**< Number of frames accepted into the queue */
+    unsigned long long dropped;   /**< Number of frames dropped by the queue policy */
+    int high_water_mark;          /**< Largest number of frames held by the queue at once */
+    double average_residency_ms;  /**< Average time dequeued frames spent in the queue */
+    double average_wake_latency_us; /**< Average time from enqueue to dequeue of frames a consumer was waiting for */
+    double max_wake_latency_us;   /**< Longest time from enqueue to dequeue of a frame a consumer was waiting for */
+} rs2_frame_queue_stats;
+
 /**
 * Creates Depth-Colorizer processing block that can be used to quickly visualize the depth data
 * This block will accept depth frames as input and replace them by depth frames with format RGB8
@@ -33,6 +65,17 @@ rs2_processing_block* rs2_create_colorizer(rs2_error** error);
 */
 rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error);
 
+/**
+* Creates Multi-Device Sync processing block. This block accepts frames from several devices and outputs composite frames
+* holding one frame of every active stream, all within the tolerance of each other
+* Hardware timestamps are mapped to host time through a per-device model of clock offset and drift
+* \param[in] tolerance_ms  Maximal difference, in milliseconds, between the timestamps of frames in the same frameset
+* \param[in] streams       Number of streams the frames come from, no frameset is output until all of them delivered a frame
+*                          or a second passed since the first frame, 0 to output framesets of the streams seen so far
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float tolerance_ms, int streams, rs2_error** error);
+
 /**
 * Creates Point-Cloud processing block. This block accepts depth frames and outputs Points frames
 * In addition, given non-depth frame, the block will align texture coordinate to the non-depth stream
@@ -74,12 +117,126 @@ void rs2_start_processing_queue(rs2_processing_block* block, rs2_frame_queue* qu
 */
 void rs2_process_frame(rs2_processing_block* block, rs2_frame* frame, rs2_error** error);
 
+/**
+* This method switches a processing block between synchronous and asynchronous execution
+* In asynchronous mode rs2_process_frame returns immediately and the frame is processed on the shared processing executor
+* Frames passed to the same block are still processed one at a time, in the order they were passed, so output order is preserved
+* Switching back to synchronous execution waits for the frames already passed to be processed, while deleting an asynchronous
+* block releases the frames it did not process yet
+* \param[in] block          Processing block
+* \param[in] async          Non-zero to process frames asynchronously, zero to process them on the calling thread
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_async_processing(rs2_processing_block* block, int async, rs2_error** error);
+
+/**
+* Configure the library-wide executor running asynchronous processing blocks
+* Tasks that did not start yet are kept and will run on the new set of workers
+* \param[in] worker_count       Number of worker threads, 0 selects the number of hardware threads
+* \param[in] cpu_affinity_mask  Bit-mask of the CPUs the workers are allowed to run on, 0 applies the affinity of RS2_THREAD_ROLE_PROCESSING
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_configure_processing_executor(int worker_count, unsigned long long cpu_affinity_mask, rs2_error** error);
+
+/**
+* Retrieve the number of worker threads of the library-wide processing executor
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return number of worker threads
+*/
+int rs2_get_processing_executor_worker_count(rs2_error** error);
+
 /**
 * Deletes the processing block
 * \param[in] block          Processing block
 */
 void rs2_delete_processing_block(rs2_processing_block* block);
 
+/**
+* Creates an empty processing graph. A processing graph is a directed acyclic graph of processing blocks,
+* where edges carry the frames of one stream type through a bounded queue
+* Nodes are scheduled on the shared processing executor, so independent branches of the graph run in parallel
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return           new processing graph, to be released by rs2_delete_processing_graph
+*/
+rs2_processing_graph* rs2_create_processing_graph(rs2_error** error);
+
+/**
+* Add a processing block as a node of the graph. The output of the block is redirected to the graph
+* \param[in] graph          Processing graph
+* \param[in] block          Processing block to add
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return           identifier of the new node
+*/
+int rs2_processing_graph_add_node(rs2_processing_graph* graph, rs2_processing_block* block, rs2_error** error);
+
+/**
+* Add a join node to the graph. A join node synchronizes the frames arriving on all its input edges and outputs matching framesets
+* \param[in] graph          Processing graph
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return           identifier of the new node
+*/
+int rs2_processing_graph_add_join(rs2_processing_graph* graph, rs2_error** error);
+
+/**
+* Connect the output of one node to the input of another node
+* \param[in] graph          Processing graph
+* \param[in] from           Source node identifier
+* \param[in] to             Target node identifier
+* \param[in] stream         Stream type carried by the edge, frames of other streams are not passed. RS2_STREAM_ANY passes all frames
+* \param[in] queue_size     Max number of frames waiting on the edge before older frames will start to get dropped
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_connect(rs2_processing_graph* graph, int from, int to, rs2_stream stream, int queue_size, rs2_error** error);
+
+/**
+* Connect the input of the graph to a node
+* \param[in] graph          Processing graph
+* \param[in] to             Target node identifier
+* \param[in] stream         Stream type carried by the edge, frames of other streams are not passed. RS2_STREAM_ANY passes all frames
+* \param[in] queue_size     Max number of frames waiting on the edge before older frames will start to get dropped
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_connect_input(rs2_processing_graph* graph, int to, rs2_stream stream, int queue_size, rs2_error** error);
+
+/**
+* Connect the output of a node to the output of the graph
+* \param[in] graph          Processing graph
+* \param[in] from           Source node identifier
+* \param[in] stream         Stream type to output, RS2_STREAM_ANY outputs all frames
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_connect_output(rs2_processing_graph* graph, int from, rs2_stream stream, rs2_error** error);
+
+/**
+* This method is used to direct the output of the graph to some callback. The callback may be invoked concurrently from several threads
+* \param[in] graph          Processing graph
+* \param[in] on_frame       Callback to be invoked every time a frame leaves the graph
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_start_processing_graph(rs2_processing_graph* graph, rs2_frame_callback* on_frame, rs2_error** error);
+
+/**
+* This method is used to direct the output of the graph to a dedicated queue object
+* \param[in] graph          Processing graph
+* \param[in] queue          Queue to place the processed frames to
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_start_processing_graph_queue(rs2_processing_graph* graph, rs2_frame_queue* queue, rs2_error** error);
+
+/**
+* This method is used to pass frame into the graph. The graph topology can not change once frames were passed to it
+* \param[in] graph          Processing graph
+* \param[in] frame          Frame to process, ownership is moved to the graph object
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_processing_graph_process_frame(rs2_processing_graph* graph, rs2_frame* frame, rs2_error** error);
+
+/**
+* Deletes the processing graph, frames still waiting in the graph are released
+* \param[in] graph          Processing graph
+*/
+void rs2_delete_processing_graph(rs2_processing_graph* graph);
+
 /**
 * create frame queue. frame queues are the simplest x-platform synchronization primitive provided by librealsense
 * to help developers who are not using async APIs
@@ -89,6 +246,38 @@ void rs2_delete_processing_block(rs2_processing_block* block);
 */
 rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error);
 
+/**
+* create frame queue backed by a specific implementation and drop policy
+* lock-free queues avoid taking a lock per frame and wake a waiting consumer faster, at the cost of restricting
+* the number of threads that may use them concurrently
+* \param[in] capacity max number of frames to allow to be stored in the queue before the policy starts dropping frames
+* \param[in] type     queue implementation, see rs2_frame_queue_type
+* \param[in] policy   what to do with a frame arriving while the queue is full, see rs2_frame_queue_policy
+* \param[in] block_timeout_ms max time a producer is blocked under RS2_FRAME_QUEUE_POLICY_BLOCK, ignored by other policies
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return handle to the frame queue, must be released using rs2_delete_frame_queue
+*/
+rs2_frame_queue* rs2_create_custom_frame_queue(int capacity, rs2_frame_queue_type type,
+                                               rs2_frame_queue_policy policy, unsigned int block_timeout_ms, rs2_error** error);
+
+/**
+* retrieve frame queue statistics
+* \param[in] queue the frame queue data structure
+* \param[out] stats receives the statistics
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_frame_queue_stats(const rs2_frame_queue* queue, rs2_frame_queue_stats* stats, rs2_error** error);
+
+/**
+* set a busy-poll budget for consumers waiting on the queue
+* a waiting consumer spins on the queue for up to the budget before parking, so it picks up a frame without the
+* wake-up and scheduling latency of a blocked thread, at the price of keeping a core busy
+* \param[in] queue the frame queue data structure
+* \param[in] budget_us max time in microseconds to spin before parking, 0 parks right away (default)
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_frame_queue_busy_poll(rs2_frame_queue* queue, unsigned int budget_us, rs2_error** error);
+
 /**
 * deletes frame queue and releases all frames inside it
 * \param[in] frame queue to delete
@@ -112,6 +301,17 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
 */
 int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_error** error);
 
+/**
+* wait until frames become available in the queue and dequeue up to max_frames of them at once
+* \param[in] queue the frame queue data structure
+* \param[out] output_frames array of at least max_frames elements, receives frame handles to be released using rs2_release_frame
+* \param[in] max_frames max number of frames to dequeue
+* \param[in] timeout_ms max time to wait for the first frame, 0 returns immediately
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+* \return number of frames stored to output_frames
+*/
+int rs2_dequeue_frames(rs2_frame_queue* queue, rs2_frame** output_frames, int max_frames, unsigned int timeout_ms, rs2_error** error);
+
 /**
 * enqueue new frame into a queue
 * \param[in] frame frame handle to enqueue (this operation passed ownership to the queue)
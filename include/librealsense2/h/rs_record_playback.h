@@ -37,6 +37,17 @@ typedef void (*rs2_playback_status_changed_callback_ptr)(rs2_playback_status);
  */
 rs2_device* rs2_create_record_device(const rs2_device* device, const char* file, rs2_error** error);
 
+/**
+ * Creates a recording device to record the given device and save it to the given file
+ * \param[in]  device              The device to record
+ * \param[in]  file                The desired path to which the recorder should save the data
+ * \param[in]  compression_enabled Non-zero to compress the recorded data with LZ4, zero to write it uncompressed
+ * \param[in]  chunk_threshold     Size in bytes of the chunks the data is written (and compressed) in, 0 for the default size
+ * \param[out] error               If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return A pointer to a device that records its data to file, or null in case of failure
+ */
+rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* file, int compression_enabled, unsigned int chunk_threshold, rs2_error** error);
+
 /**
 * Pause the recording device without stopping the actual device from streaming.
 * Pausing will cause the device to stop writing new data to the file, in particular, frames and changes to extensions
@@ -92,6 +103,34 @@ void rs2_playback_seek(const rs2_device* device, long long int time, rs2_error**
  */
 unsigned long long int rs2_playback_get_position(const rs2_device* device, rs2_error** error);
 
+/**
+ * Gets the number of frames of a stream in the played file
+ * \param[in] device     A playback device
+ * \param[in] stream     A stream profile of the playback device
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return Number of frames of the stream
+ */
+unsigned long long int rs2_playback_get_frame_count(const rs2_device* device, const rs2_stream_profile* stream, rs2_error** error);
+
+/**
+ * Set the playback to the time point of a frame of a stream
+ * \param[in] device       A playback device
+ * \param[in] stream       A stream profile of the playback device
+ * \param[in] frame_number The frame to seek to, frames of a stream are numbered from 0 in the order they were recorded
+ * \param[out] error       If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_seek_to_frame(const rs2_device* device, const rs2_stream_profile* stream, unsigned long long int frame_number, rs2_error** error);
+
+/**
+ * Move the playback a number of frames of a stream forward or backward from the current position
+ * Stepping stops at the first and the last frames of the stream
+ * \param[in] device     A playback device
+ * \param[in] stream     A stream profile of the playback device
+ * \param[in] frames     Number of frames to move, negative values move backward
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_step_frames(const rs2_device* device, const rs2_stream_profile* stream, int frames, rs2_error** error);
+
 /**
  * Pauses the playback
  * Calling pause() in "Paused" status does nothing
@@ -131,6 +170,40 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
  */
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error);
 
+/**
+ * Set how much of the file the playback reads ahead, on a background thread
+ *
+ * Reading ahead keeps disk access and deserialization out of the pacing and delivery of the playback.
+ * Data is read until either limit is reached, a single frame is read ahead even if it exceeds max_bytes.
+ * \param[in] device     A playback device
+ * \param[in] max_frames Number of frames to keep ready, up to 64. 0 disables reading ahead
+ * \param[in] max_bytes  Size of frame data to keep ready, in bytes
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_read_ahead(const rs2_device* device, int max_frames, unsigned long long max_bytes, rs2_error** error);
+
+/**
+ * Set the playback to work in batch mode, for offline processing of the file
+ *
+ * In batch mode, playback does not follow the recorded timing and delivers frames as fast as the application accepts them.
+ * No frames are dropped: reading waits while the callback of a stream is behind, and each stream keeps its order.
+ * The file is decoded by several readers in parallel, each opening the file and decoding its own parts of it.
+ * Batch mode can only be changed while the sensors of the playback are not streaming.
+ * \param[in] device         A playback device
+ * \param[in] batch_mode     Indicates if batch mode is requested, 0 means false, otherwise true
+ * \param[in] decode_threads Number of readers decoding the file, up to 16. 0 uses one per hardware thread, 1 decodes on a single thread
+ * \param[out] error         If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ */
+void rs2_playback_device_set_batch_mode(const rs2_device* device, int batch_mode, int decode_threads, rs2_error** error);
+
+/**
+ * Indicates if playback is in batch mode
+ * \param[in] device A playback device
+ * \param[out] error     If non-null, receives any error that occurs during this call, otherwise, errors are ignored
+ * \return True iff playback is in batch mode. 0 means false, otherwise true
+ */
+int rs2_playback_device_is_batch_mode(const rs2_device* device, rs2_error** error);
+
 /**
  * Register to receive callback from playback device upon its status changes
  *
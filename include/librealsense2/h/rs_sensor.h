@@ -389,6 +389,26 @@ void rs2_get_extrinsics(const rs2_stream_profile* from,
  */
 void rs2_get_video_stream_intrinsics(const rs2_stream_profile* from, rs2_intrinsics* intrinsics, rs2_error** error);
 
+/** \brief Latency of the frames of a stream, from their completion by the host driver to the invocation of the user callback */
+typedef struct rs2_latency_stats
+{
+    unsigned long long frames; /**< Number of frames measured since the stream was started */
+    double average_ms;         /**< Average latency */
+    double min_ms;             /**< Shortest latency */
+    double max_ms;             /**< Longest latency */
+    double last_ms;            /**< Latency of the most recent frame */
+} rs2_latency_stats;
+
+/**
+* Retrieve the end-to-end latency statistics of a stream of the sensor since it was started
+* Only frames timestamped by the host driver are measured, on other backends and in playback the statistics remain empty
+* \param[in] sensor   the sensor streaming the profile
+* \param[in] profile  the stream profile the sensor was opened with
+* \param[out] stats   receives the statistics
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_get_stream_latency_stats(const rs2_sensor* sensor, const rs2_stream_profile* profile, rs2_latency_stats* stats, rs2_error** error);
+
 
 #ifdef __cplusplus
 }
@@ -75,6 +75,29 @@ typedef enum rs2_log_severity {
 } rs2_log_severity;
 const char* rs2_log_severity_to_string(rs2_log_severity info);
 
+/** \brief Groups of library threads that share affinity, scheduling and naming settings */
+typedef enum rs2_thread_role {
+    RS2_THREAD_ROLE_CAPTURE        , /**< Threads reading frames from video devices */
+    RS2_THREAD_ROLE_MOTION_CAPTURE , /**< Threads reading samples from motion (HID) devices */
+    RS2_THREAD_ROLE_DISPATCH       , /**< Threads delivering frames and notifications to user callbacks */
+    RS2_THREAD_ROLE_PLAYBACK       , /**< Threads reading and delivering frames of a recording */
+    RS2_THREAD_ROLE_RECORD         , /**< Threads writing frames to a recording */
+    RS2_THREAD_ROLE_AUTO_EXPOSURE  , /**< Threads running the software auto-exposure */
+    RS2_THREAD_ROLE_DEVICE_WATCHER , /**< Threads watching for connected and disconnected devices */
+    RS2_THREAD_ROLE_PROCESSING     , /**< Workers of the shared processing executor */
+    RS2_THREAD_ROLE_COUNT            /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_thread_role;
+const char* rs2_thread_role_to_string(rs2_thread_role role);
+
+/** \brief Scheduling policy applied to the threads of a role */
+typedef enum rs2_scheduling_policy {
+    RS2_SCHEDULING_POLICY_DEFAULT     , /**< Regular time-sharing scheduling (SCHED_OTHER on Linux), even when the thread was spawned by a real-time thread */
+    RS2_SCHEDULING_POLICY_FIFO        , /**< Real-time first-in first-out scheduling (SCHED_FIFO on Linux) */
+    RS2_SCHEDULING_POLICY_ROUND_ROBIN , /**< Real-time round-robin scheduling (SCHED_RR on Linux) */
+    RS2_SCHEDULING_POLICY_COUNT         /**< Number of enumeration values. Not a valid input: intended to be used in for-loops. */
+} rs2_scheduling_policy;
+const char* rs2_scheduling_policy_to_string(rs2_scheduling_policy policy);
+
 /** \brief Specifies advanced interfaces (capabilities) objects may implement */
 typedef enum rs2_extension
 {
@@ -95,6 +118,8 @@ typedef enum rs2_extension
     RS2_EXTENSION_RECORD,
     RS2_EXTENSION_VIDEO_PROFILE,
     RS2_EXTENSION_PLAYBACK,
+    RS2_EXTENSION_DMABUF_FRAME,
+    RS2_EXTENSION_MOTION_BATCH_FRAME,
     RS2_EXTENSION_COUNT
 } rs2_extension;
 const char* rs2_extension_type_to_string(rs2_extension type);
@@ -117,6 +142,7 @@ typedef struct rs2_syncer rs2_syncer;
 typedef struct rs2_device_serializer rs2_device_serializer;
 typedef struct rs2_source rs2_source;
 typedef struct rs2_processing_block rs2_processing_block;
+typedef struct rs2_processing_graph rs2_processing_graph;
 typedef struct rs2_frame_processor_callback rs2_frame_processor_callback;
 typedef struct rs2_playback_status_changed_callback rs2_playback_status_changed_callback;
 typedef struct rs2_context rs2_context;
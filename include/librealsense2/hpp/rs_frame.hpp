@@ -13,6 +13,7 @@ namespace rs2
     class syncer;
     class processing_block;
     class pointcloud;
+    class processing_graph;
     class sensor;
     class frame;
     class pipeline_profile;
@@ -307,6 +308,7 @@ namespace rs2
         friend class rs2::syncer;
         friend class rs2::processing_block;
         friend class rs2::pointcloud;
+        friend class rs2::processing_graph;
 
         rs2_frame* frame_ref;
     };
@@ -455,6 +457,74 @@ namespace rs2
             return r;
         }
     };
+    class dmabuf_frame : public video_frame
+    {
+    public:
+        dmabuf_frame(const frame& f)
+            : video_frame(f)
+        {
+            rs2_error* e = nullptr;
+            if (!f || (rs2_is_frame_extendable_to(f.get(), RS2_EXTENSION_DMABUF_FRAME, &e) == 0 && !e))
+            {
+                reset();
+            }
+            error::handle(e);
+        }
+
+        int get_dmabuf_fd() const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_dmabuf_fd(get(), &e);
+            error::handle(e);
+            return r;
+        }
+
+        unsigned int get_dmabuf_offset() const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_dmabuf_offset(get(), &e);
+            error::handle(e);
+            return r;
+        }
+
+        unsigned int get_dmabuf_stride() const
+        {
+            rs2_error* e = nullptr;
+            auto r = rs2_get_frame_dmabuf_stride(get(), &e);
+            error::handle(e);
+            return r;
+        }
+    };
+
+    class motion_batch_frame : public frame
+    {
+    public:
+        motion_batch_frame(const frame& f)
+            : frame(f)
+        {
+            rs2_error* e = nullptr;
+            if (!f || (rs2_is_frame_extendable_to(f.get(), RS2_EXTENSION_MOTION_BATCH_FRAME, &e) == 0 && !e))
+            {
+                reset();
+            }
+            error::handle(e);
+        }
+
+        rs2_motion_batch get_samples() const
+        {
+            rs2_error* e = nullptr;
+            rs2_motion_batch batch;
+            rs2_get_motion_batch(get(), &batch, &e);
+            error::handle(e);
+            return batch;
+        }
+
+        size_t size() const
+        {
+            return static_cast<size_t>(get_samples().count);
+        }
+    };
+
     class frameset : public frame
     {
     public:
@@ -7,6 +7,7 @@
 #include "rs_types.hpp"
 #include "rs_frame.hpp"
 #include "rs_context.hpp"
+#include "rs_processing.hpp"
 
 namespace rs2
 {
@@ -268,6 +269,69 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Keep only the newest complete frameset instead of queuing every frameset until it is read.
+        * Framesets that were not read before a newer one completed are dropped.
+        *
+        * \param[in] latest_only   True to keep only the newest frameset, false to queue all framesets
+        */
+        void enable_latest_frameset_only(bool latest_only = true)
+        {
+            rs2_error* e = nullptr;
+            rs2_config_enable_latest_frameset_only(_config.get(), latest_only ? 1 : 0, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Make \c wait_for_frames() spin for up to the given budget before blocking, trading a busy core for lower wake latency.
+        *
+        * \param[in] budget_us   Max time in microseconds to spin before blocking, 0 blocks right away
+        */
+        void enable_busy_poll(unsigned int budget_us)
+        {
+            rs2_error* e = nullptr;
+            rs2_config_enable_busy_poll(_config.get(), budget_us, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Append a processing block to the post-processing stage of the pipeline.
+        * The blocks are applied in order to every complete frameset as serialized tasks on the processing executor the library
+        * shares between its processing blocks, so framesets reach \c wait_for_frames() already processed. When processing falls
+        * behind, the oldest pending frameset is dropped. Each block receives the whole frameset, and the frames it outputs replace
+        * the frames of the same stream in the set. While the pipeline is streaming, the output of the blocks is redirected to it.
+        *
+        * \param[in] block   The processing block to append
+        */
+        void add_post_processing_block(const processing_block& block)
+        {
+            rs2_error* e = nullptr;
+            rs2_config_add_post_processing_block(_config.get(), block._block.get(), &e);
+            error::handle(e);
+        }
+
+        /**
+        * Append one of the built-in filters (colorizer, pointcloud, align, decimation, spatial or temporal filter) to the
+        * post-processing stage of the pipeline.
+        *
+        * \param[in] filter  The filter to append
+        */
+        template<class T>
+        void add_post_processing_block(const T& filter)
+        {
+            add_post_processing_block(*filter._block);
+        }
+
+        /**
+        * Remove all processing blocks from the post-processing stage of the pipeline.
+        */
+        void clear_post_processing_blocks()
+        {
+            rs2_error* e = nullptr;
+            rs2_config_clear_post_processing_blocks(_config.get(), &e);
+            error::handle(e);
+        }
+
         /**
         * Resolve the configuration filters, to find a matching device and streams profiles.
         * The method resolves the user configuration filters for the device and streams, and combines them with the requirements
@@ -471,6 +535,21 @@ namespace rs2
             return res > 0;
         }
 
+        /**
+        * Retrieve statistics of the pipeline's frameset queue since the pipeline was started, including the wake latency of
+        * \c wait_for_frames(). The method is valid only while the pipeline is active.
+        *
+        * \return   The queue statistics
+        */
+        rs2_frame_queue_stats get_queue_stats() const
+        {
+            rs2_error* e = nullptr;
+            rs2_frame_queue_stats stats;
+            rs2_pipeline_get_queue_stats(_pipeline.get(), &stats, &e);
+            error::handle(e);
+            return stats;
+        }
+
         /**
         * Return the active device and streams profiles, used by the pipeline.
         * The pipeline streams profiles are selected during \c start(). The method returns a valid result only when the pipeline is active -
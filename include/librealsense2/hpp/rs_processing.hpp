@@ -102,6 +102,20 @@ namespace rs2
             invoke(std::move(f));
         }
 
+        /**
+        * Switch the block between synchronous and asynchronous execution
+        * Asynchronous blocks return from invoke immediately and process frames on the shared processing executor,
+        * one at a time and in the order they were passed
+        * Switching back to synchronous execution waits for the frames already passed to be processed
+        * \param[in] async      true to process frames asynchronously, false to process them on the calling thread
+        */
+        void set_async(bool async) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_async_processing(_block.get(), async ? 1 : 0, &e);
+            error::handle(e);
+        }
+
         processing_block(std::shared_ptr<rs2_processing_block> block)
             : options((rs2_options*)block.get()),_block(block)
         {
@@ -121,10 +135,33 @@ namespace rs2
         operator rs2_options*() const { return (rs2_options*)_block.get(); }
 
     private:
+        friend class processing_graph;
+        friend class config;
+
         std::shared_ptr<rs2_processing_block> _block;
     };
 
 
+    /**
+    * Configure the library-wide executor running asynchronous processing blocks
+    * \param[in] worker_count       Number of worker threads, 0 selects the number of hardware threads
+    * \param[in] cpu_affinity_mask  Bit-mask of the CPUs the workers are allowed to run on, 0 leaves the choice to the OS
+    */
+    inline void configure_processing_executor(int worker_count, unsigned long long cpu_affinity_mask = 0)
+    {
+        rs2_error* e = nullptr;
+        rs2_configure_processing_executor(worker_count, cpu_affinity_mask, &e);
+        error::handle(e);
+    }
+
+    inline int get_processing_executor_worker_count()
+    {
+        rs2_error* e = nullptr;
+        auto res = rs2_get_processing_executor_worker_count(&e);
+        error::handle(e);
+        return res;
+    }
+
     class frame_queue
     {
     public:
@@ -142,6 +179,24 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * create frame queue backed by a specific implementation and drop policy
+        * param[in] capacity size of the frame queue
+        * param[in] type implementation of the queue, lock-free types restrict the threads that may use the queue
+        * param[in] policy what to do with a frame arriving while the queue is full
+        * param[in] block_timeout_ms max time a producer is blocked under RS2_FRAME_QUEUE_POLICY_BLOCK
+        */
+        frame_queue(unsigned int capacity, rs2_frame_queue_type type,
+                    rs2_frame_queue_policy policy = RS2_FRAME_QUEUE_POLICY_DROP_OLDEST,
+                    unsigned int block_timeout_ms = 0)
+        {
+            rs2_error* e = nullptr;
+            _queue = std::shared_ptr<rs2_frame_queue>(
+                    rs2_create_custom_frame_queue(capacity, type, policy, block_timeout_ms, &e),
+                    rs2_delete_frame_queue);
+            error::handle(e);
+        }
+
         frame_queue() : frame_queue(1) {}
 
         /**
@@ -181,6 +236,48 @@ namespace rs2
             return res > 0;
         }
 
+        /**
+        * wait until frames become available in the queue and dequeue up to max_frames of them at once
+        * \param[in] max_frames max number of frames to dequeue
+        * \param[in] timeout_ms max time to wait for the first frame, 0 returns immediately
+        * \return the dequeued frames, empty if none arrived in time
+        */
+        std::vector<frame> dequeue_frames(int max_frames, unsigned int timeout_ms = 5000) const
+        {
+            rs2_error* e = nullptr;
+            std::vector<rs2_frame*> frame_refs(max_frames);
+            auto count = rs2_dequeue_frames(_queue.get(), frame_refs.data(), max_frames, timeout_ms, &e);
+            error::handle(e);
+
+            std::vector<frame> results;
+            for (int i = 0; i < count; i++)
+                results.push_back(frame(frame_refs[i]));
+            return results;
+        }
+
+        /**
+        * retrieve the number of enqueued and dropped frames, the high-water mark and the average residency time of the queue
+        */
+        rs2_frame_queue_stats get_stats() const
+        {
+            rs2_error* e = nullptr;
+            rs2_frame_queue_stats stats;
+            rs2_get_frame_queue_stats(_queue.get(), &stats, &e);
+            error::handle(e);
+            return stats;
+        }
+
+        /**
+        * let waiting consumers spin on the queue for up to budget_us before parking, trading a busy core for lower wake latency
+        * \param[in] budget_us max time in microseconds to spin, 0 parks right away
+        */
+        void set_busy_poll(unsigned int budget_us) const
+        {
+            rs2_error* e = nullptr;
+            rs2_set_frame_queue_busy_poll(_queue.get(), budget_us, &e);
+            error::handle(e);
+        }
+
         void operator()(frame f) const
         {
             enqueue(std::move(f));
@@ -221,6 +318,8 @@ namespace rs2
         }
     private:
         friend class context;
+        friend class processing_graph;
+        friend class config;
 
         std::shared_ptr<processing_block> _block;
         frame_queue _queue;
@@ -298,6 +397,65 @@ namespace rs2
         frame_queue _results;
     };
 
+    /**
+        Synchronizes the streams of several devices into common framesets
+        Frames from all devices are passed in, and a frameset is produced once every active stream has a frame within the tolerance
+    */
+    class multi_device_syncer
+    {
+    public:
+        /**
+            Create multi-device sync processing block
+            * \param[in] tolerance_ms   Maximal difference, in milliseconds, between the timestamps of frames in the same frameset
+            * \param[in] streams        Number of streams the frames come from, framesets are output once all of them delivered a frame
+        */
+        explicit multi_device_syncer(float tolerance_ms = 15.f, int streams = 0)
+        {
+            rs2_error* e = nullptr;
+            _processing_block = std::make_shared<processing_block>(
+                    std::shared_ptr<rs2_processing_block>(
+                                        rs2_create_multi_device_sync_processing_block(tolerance_ms, streams, &e),
+                                        rs2_delete_processing_block));
+            error::handle(e);
+
+            _processing_block->start(_results);
+        }
+
+        /**
+        * Wait until coherent set of frames from all devices becomes available
+        * \param[in] timeout_ms   Max time in milliseconds to wait until an exception will be thrown
+        * \return Set of coherent frames
+        */
+        frameset wait_for_frames(unsigned int timeout_ms = 5000) const
+        {
+            return frameset(_results.wait_for_frame(timeout_ms));
+        }
+
+        /**
+        * Check if a coherent set of frames from all devices is available
+        * \param[out] result      New coherent frame-set
+        * \return true if new frame-set was stored to result
+        */
+        bool poll_for_frames(frameset* fs) const
+        {
+            frame result;
+            if (_results.poll_for_frame(&result))
+            {
+                *fs = frameset(result);
+                return true;
+            }
+            return false;
+        }
+
+        void operator()(frame f) const
+        {
+            _processing_block->operator()(std::move(f));
+        }
+    private:
+        std::shared_ptr<processing_block> _processing_block;
+        frame_queue _results;
+    };
+
     /**
         Auxiliary processing block that performs image alignment using depth data and camera calibration
     */
@@ -345,6 +503,8 @@ namespace rs2
         }
     private:
         friend class context;
+        friend class processing_graph;
+        friend class config;
 
         std::shared_ptr<processing_block> _block;
         frame_queue _queue;
@@ -381,6 +541,9 @@ namespace rs2
         video_frame operator()(frame depth) const { return colorize(depth); }
 
      private:
+         friend class processing_graph;
+         friend class config;
+
          std::shared_ptr<processing_block> _block;
          frame_queue _queue;
      };
@@ -417,6 +580,8 @@ namespace rs2
         }
     private:
         friend class context;
+        friend class processing_graph;
+        friend class config;
 
         std::shared_ptr<processing_block> _block;
         frame_queue _queue;
@@ -454,6 +619,8 @@ namespace rs2
         }
     private:
         friend class context;
+        friend class processing_graph;
+        friend class config;
 
         std::shared_ptr<processing_block> _block;
         frame_queue _queue;
@@ -491,9 +658,136 @@ namespace rs2
         }
     private:
         friend class context;
+        friend class processing_graph;
+        friend class config;
 
         std::shared_ptr<processing_block> _block;
         frame_queue _queue;
     };
+
+    /**
+    * Directed acyclic graph of processing blocks
+    * Nodes are processing blocks and edges carry the frames of one stream type through a bounded queue
+    * Nodes run on the shared processing executor, so independent branches are processed in parallel,
+    * and frames fanned-out to several nodes are shared rather than copied
+    * Once frames were passed to the graph, its topology can no longer change
+    */
+    class processing_graph
+    {
+    public:
+        processing_graph()
+        {
+            rs2_error* e = nullptr;
+            _graph = std::shared_ptr<rs2_processing_graph>(
+                rs2_create_processing_graph(&e),
+                rs2_delete_processing_graph);
+            error::handle(e);
+        }
+
+        /**
+        * Add a processing block as a node of the graph. The output of the block is redirected to the graph
+        * \param[in] block      Processing block to add
+        * \return identifier of the new node
+        */
+        int add(const processing_block& block) const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_processing_graph_add_node(_graph.get(), block._block.get(), &e);
+            error::handle(e);
+            return res;
+        }
+
+        /**
+        * Add one of the built-in filters (colorizer, pointcloud, align, decimation, spatial or temporal filter) as a node of the graph
+        * \param[in] filter     Filter to add, from now on its output is redirected to the graph
+        * \return identifier of the new node
+        */
+        template<class T>
+        int add(const T& filter) const
+        {
+            return add(*filter._block);
+        }
+
+        /**
+        * Add a join node, matching the frames of all its input edges into framesets
+        * \return identifier of the new node
+        */
+        int add_join() const
+        {
+            rs2_error* e = nullptr;
+            auto res = rs2_processing_graph_add_join(_graph.get(), &e);
+            error::handle(e);
+            return res;
+        }
+
+        /**
+        * Connect the output of one node to the input of another node
+        * \param[in] from           Source node identifier
+        * \param[in] to             Target node identifier
+        * \param[in] stream         Stream type carried by the edge, RS2_STREAM_ANY passes all frames
+        * \param[in] queue_size     Max number of frames waiting on the edge before older frames are dropped
+        */
+        void connect(int from, int to, rs2_stream stream = RS2_STREAM_ANY, int queue_size = 1) const
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_graph_connect(_graph.get(), from, to, stream, queue_size, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Connect the input of the graph to a node
+        * \param[in] to             Target node identifier
+        * \param[in] stream         Stream type carried by the edge, RS2_STREAM_ANY passes all frames
+        * \param[in] queue_size     Max number of frames waiting on the edge before older frames are dropped
+        */
+        void connect_input(int to, rs2_stream stream = RS2_STREAM_ANY, int queue_size = 1) const
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_graph_connect_input(_graph.get(), to, stream, queue_size, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Connect the output of a node to the output of the graph
+        * \param[in] from           Source node identifier
+        * \param[in] stream         Stream type to output, RS2_STREAM_ANY outputs all frames
+        */
+        void connect_output(int from, rs2_stream stream = RS2_STREAM_ANY) const
+        {
+            rs2_error* e = nullptr;
+            rs2_processing_graph_connect_output(_graph.get(), from, stream, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Start delivering the output of the graph. The callback may be invoked concurrently from several threads
+        * \param[in] on_frame       Callback or frame_queue to receive the frames leaving the graph
+        */
+        template<class S>
+        void start(S on_frame)
+        {
+            rs2_error* e = nullptr;
+            rs2_start_processing_graph(_graph.get(), new frame_callback<S>(on_frame), &e);
+            error::handle(e);
+        }
+
+        void invoke(frame f) const
+        {
+            rs2_frame* ptr = nullptr;
+            std::swap(f.frame_ref, ptr);
+
+            rs2_error* e = nullptr;
+            rs2_processing_graph_process_frame(_graph.get(), ptr, &e);
+            error::handle(e);
+        }
+
+        void operator()(frame f) const
+        {
+            invoke(std::move(f));
+        }
+
+    private:
+        std::shared_ptr<rs2_processing_graph> _graph;
+    };
 }
 #endif // LIBREALSENSE_RS2_PROCESSING_HPP
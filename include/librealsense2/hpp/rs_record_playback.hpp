@@ -85,6 +85,44 @@ namespace rs2
             return duration;
         }
 
+        /**
+        * Retrieves the number of frames of a stream in the file
+        * \param[in] stream  A stream profile of the playback device
+        * \return Number of frames of the stream
+        */
+        uint64_t get_frame_count(const stream_profile& stream) const
+        {
+            rs2_error* e = nullptr;
+            uint64_t count = rs2_playback_get_frame_count(_dev.get(), stream.get(), &e);
+            error::handle(e);
+            return count;
+        }
+
+        /**
+        * Sets the playback to the time point of a frame of a stream
+        * \param[in] stream        A stream profile of the playback device
+        * \param[in] frame_number  The frame to seek to, frames of a stream are numbered from 0 in the order they were recorded
+        */
+        void seek_to_frame(const stream_profile& stream, uint64_t frame_number)
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_seek_to_frame(_dev.get(), stream.get(), frame_number, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Moves the playback a number of frames of a stream forward or backward from the current position
+        * Stepping stops at the first and the last frames of the stream
+        * \param[in] stream  A stream profile of the playback device
+        * \param[in] frames  Number of frames to move, negative values move backward
+        */
+        void step_frames(const stream_profile& stream, int frames)
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_step_frames(_dev.get(), stream.get(), frames, &e);
+            error::handle(e);
+        }
+
         /**
         * Sets the playback to a specified time point of the played data
         * \param[in] time  The time point to which playback should seek, expressed in units of nanoseconds (zero value = start)
@@ -126,6 +164,47 @@ namespace rs2
             error::handle(e);
         }
 
+        /**
+        * Set how much of the file the playback reads ahead, on a background thread
+        * Data is read until either limit is reached, a single frame is read ahead even if it exceeds max_bytes
+        * \param[in] max_frames  Number of frames to keep ready, up to 64. 0 disables reading ahead
+        * \param[in] max_bytes   Size of frame data to keep ready, in bytes
+        */
+        void set_read_ahead(int max_frames, unsigned long long max_bytes) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_read_ahead(_dev.get(), max_frames, max_bytes, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Set the playback to work in batch mode, for offline processing of the file
+        *
+        * In batch mode, playback does not follow the recorded timing and delivers frames as fast as the application accepts them.
+        * No frames are dropped: reading waits while the callback of a stream is behind, and each stream keeps its order.
+        * The file is decoded by several readers in parallel. Batch mode can only be changed while the sensors are not streaming.
+        * \param[in] batch_mode      Indicates if batch mode is requested
+        * \param[in] decode_threads  Number of readers decoding the file, up to 16. 0 uses one per hardware thread, 1 decodes on a single thread
+        */
+        void set_batch_mode(bool batch_mode, int decode_threads = 0) const
+        {
+            rs2_error* e = nullptr;
+            rs2_playback_device_set_batch_mode(_dev.get(), (batch_mode ? 1 : 0), decode_threads, &e);
+            error::handle(e);
+        }
+
+        /**
+        * Indicates if playback is in batch mode
+        * \return True iff playback is in batch mode
+        */
+        bool is_batch_mode() const
+        {
+            rs2_error* e = nullptr;
+            bool batch_mode = rs2_playback_device_is_batch_mode(_dev.get(), &e) != 0;
+            error::handle(e);
+            return batch_mode;
+        }
+
         /**
         * Set the playing speed
         * \param[in] speed  Indicates a multiplication of the speed to play (e.g: 1 = normal, 0.5 twice as slow)
@@ -219,6 +298,22 @@ namespace rs2
             rs2::error::handle(e);
         }
 
+        /**
+        * Creates a recording device to record the given device and save it to the given file as rosbag format
+        * \param[in]  file                The desired path to which the recorder should save the data
+        * \param[in]  device              The device to record
+        * \param[in]  compression_enabled Whether to compress the recorded data with LZ4
+        * \param[in]  chunk_threshold     Size in bytes of the chunks the data is written in, 0 for the default size
+        */
+        recorder(const std::string& file, rs2::device device, bool compression_enabled, unsigned int chunk_threshold = 0)
+        {
+            rs2_error* e = nullptr;
+            _dev = std::shared_ptr<rs2_device>(
+                rs2_create_record_device_ex(device.get().get(), file.c_str(), compression_enabled, chunk_threshold, &e),
+                rs2_delete_device);
+            rs2::error::handle(e);
+        }
+
         /**
         * Pause the recording device without stopping the actual device from streaming.
         */
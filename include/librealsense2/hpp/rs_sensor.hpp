@@ -374,6 +374,19 @@ namespace rs2
             return intrin;
         }
 
+        /**
+         * returns the latency of a stream from frame completion by the host driver to the user callback
+         * \param profile  stream profile the sensor was opened with
+         */
+        rs2_latency_stats get_latency_stats(const stream_profile& profile) const
+        {
+            rs2_error* e = nullptr;
+            rs2_latency_stats stats;
+            rs2_get_stream_latency_stats(_sensor.get(), profile.get(), &stats, &e);
+            error::handle(e);
+            return stats;
+        }
+
         sensor& operator=(const std::shared_ptr<rs2_sensor> other)
         {
             options::operator=(other);
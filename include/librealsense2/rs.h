@@ -79,6 +79,35 @@ void rs2_log_to_file(rs2_log_severity min_severity, const char * file_path, rs2_
  */
 void rs2_log(rs2_log_severity severity, const char * message, rs2_error ** error);
 
+/**
+* Restrict the threads of a role to a set of CPUs
+* Applies to threads spawned after the call, typically on the next sensor open or start
+* \param[in] role               Group of library threads
+* \param[in] cpu_affinity_mask  Bit-mask of the CPUs the threads are allowed to run on, 0 allows all the CPUs of the process
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_thread_role_affinity(rs2_thread_role role, unsigned long long cpu_affinity_mask, rs2_error** error);
+
+/**
+* Select the scheduling policy and priority of the threads of a role
+* Applies to threads spawned after the call. Real-time policies usually require elevated privileges,
+* threads that can not be given the policy log a warning and keep running with the default one
+* \param[in] role      Group of library threads
+* \param[in] policy    Scheduling policy
+* \param[in] priority  Real-time priority between 1 and 99, ignored by the default policy
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_thread_role_scheduling(rs2_thread_role role, rs2_scheduling_policy policy, int priority, rs2_error** error);
+
+/**
+* Set the name given to the threads of a role, as shown by debuggers and system tools
+* Applies to threads spawned after the call. Names are truncated to 15 characters
+* \param[in] role  Group of library threads
+* \param[in] name  Thread name, empty to leave the threads unnamed
+* \param[out] error  if non-null, receives any error that occurs during this call, otherwise, errors are ignored
+*/
+void rs2_set_thread_role_name(rs2_thread_role role, const char* name, rs2_error** error);
+
 float rs2_depth_frame_get_distance(const rs2_frame* frame_ref, int x, int y, rs2_error** error);
 
 /**
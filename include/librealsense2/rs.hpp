@@ -30,6 +30,38 @@ namespace rs2
         error::handle(e);
     }
 
+    /**
+    * Restrict the library threads of a role to a set of CPUs, applies to threads spawned afterwards
+    * \param[in] role               Group of library threads
+    * \param[in] cpu_affinity_mask  Bit-mask of the CPUs the threads are allowed to run on, 0 allows all the CPUs of the process
+    */
+    inline void set_thread_role_affinity(rs2_thread_role role, unsigned long long cpu_affinity_mask)
+    {
+        rs2_error* e = nullptr;
+        rs2_set_thread_role_affinity(role, cpu_affinity_mask, &e);
+        error::handle(e);
+    }
+
+    /**
+    * Select the scheduling policy and priority of the library threads of a role, applies to threads spawned afterwards
+    * \param[in] role      Group of library threads
+    * \param[in] policy    Scheduling policy
+    * \param[in] priority  Real-time priority between 1 and 99, ignored by the default policy
+    */
+    inline void set_thread_role_scheduling(rs2_thread_role role, rs2_scheduling_policy policy, int priority = 1)
+    {
+        rs2_error* e = nullptr;
+        rs2_set_thread_role_scheduling(role, policy, priority, &e);
+        error::handle(e);
+    }
+
+    inline void set_thread_role_name(rs2_thread_role role, const std::string& name)
+    {
+        rs2_error* e = nullptr;
+        rs2_set_thread_role_name(role, name.c_str(), &e);
+        error::handle(e);
+    }
+
 	inline void log(rs2_log_severity severity, const char* message)
 	{
 		rs2_error* e = nullptr;
@@ -43,6 +75,8 @@ inline std::ostream & operator << (std::ostream & o, rs2_format format) { return
 inline std::ostream & operator << (std::ostream & o, rs2_distortion distortion) { return o << rs2_distortion_to_string(distortion); }
 inline std::ostream & operator << (std::ostream & o, rs2_option option) { return o << rs2_option_to_string(option); }
 inline std::ostream & operator << (std::ostream & o, rs2_log_severity severity) { return o << rs2_log_severity_to_string(severity); }
+inline std::ostream & operator << (std::ostream & o, rs2_thread_role role) { return o << rs2_thread_role_to_string(role); }
+inline std::ostream & operator << (std::ostream & o, rs2_scheduling_policy policy) { return o << rs2_scheduling_policy_to_string(policy); }
 inline std::ostream & operator << (std::ostream & o, rs2_camera_info camera_info) { return o << rs2_camera_info_to_string(camera_info); }
 inline std::ostream & operator << (std::ostream & o, rs2_frame_metadata_value metadata) { return o << rs2_frame_metadata_to_string(metadata); }
 inline std::ostream & operator << (std::ostream & o, rs2_timestamp_domain domain) { return o << rs2_timestamp_domain_to_string(domain); }
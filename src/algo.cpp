@@ -46,6 +46,8 @@ auto_exposure_mechanism::auto_exposure_mechanism(option& gain_option, option& ex
     _exposure_thread = std::make_shared<std::thread>(
                 [this]()
     {
+        apply_thread_role(RS2_THREAD_ROLE_AUTO_EXPOSURE);
+
         while (_keep_alive)
         {
             std::unique_lock<std::mutex> lk(_queue_mtx);
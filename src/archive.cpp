@@ -253,6 +253,9 @@ namespace librealsense
         case RS2_EXTENSION_MOTION_FRAME:
             return std::make_shared<frame_archive<frame>>(in_max_frame_queue_size, ts, parsers);
 
+        case RS2_EXTENSION_MOTION_BATCH_FRAME:
+            return std::make_shared<frame_archive<motion_batch_frame>>(in_max_frame_queue_size, ts, parsers);
+
         case RS2_EXTENSION_POINTS:
             return std::make_shared<frame_archive<points>>(in_max_frame_queue_size, ts, parsers);
 
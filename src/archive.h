@@ -24,6 +24,7 @@ struct frame_additional_data
     rs2_timestamp_domain timestamp_domain = RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK;
     rs2_time_t      system_time = 0;
     rs2_time_t      frame_callback_started = 0;
+    rs2_time_t      backend_timestamp = 0;
     uint32_t        metadata_size = 0;
     bool            fisheye_ae_mode = false;
     std::array<uint8_t,MAX_META_DATA_SIZE> metadata_blob;
@@ -89,6 +90,7 @@ namespace librealsense
         }
 
         rs2_time_t get_frame_system_time() const override;
+        rs2_time_t get_frame_backend_time() const override { return additional_data.backend_timestamp; }
 
         std::shared_ptr<stream_profile_interface> get_stream() const override { return stream; }
         void set_stream(std::shared_ptr<stream_profile_interface> sp) override { stream = std::move(sp); }
@@ -101,6 +103,7 @@ namespace librealsense
         frame_interface* publish(std::shared_ptr<archive_interface> new_owner) override;
         void attach_continuation(frame_continuation&& continuation) override { on_release = std::move(continuation); }
         void disable_continuation() override { on_release.reset(); }
+        const platform::dmabuf_descriptor* get_dmabuf() const override { return on_release.get_dmabuf(); }
 
         archive_interface* get_owner() const override { return owner.get(); }
 
@@ -186,6 +189,10 @@ namespace librealsense
         {
             return first()->get_frame_system_time();
         }
+        rs2_time_t get_frame_backend_time() const override
+        {
+            return first()->get_frame_backend_time();
+        }
         std::shared_ptr<sensor_interface> get_sensor() const override
         {
             return first()->get_sensor();
@@ -316,6 +323,81 @@ namespace librealsense
 
     //TODO: Define Motion Frame
 
+    // Several motion samples delivered in one frame
+    // The samples are stored as a structure of arrays - timestamps, frame numbers, each axis, then the raw metadata -
+    // and the frame itself carries the timestamp and frame number of its last sample
+    class motion_batch_frame : public frame
+    {
+    public:
+        motion_batch_frame() : frame(), _capacity(0), _metadata_size(0), _count(0) {}
+
+        static size_t get_data_size(size_t capacity, size_t metadata_size)
+        {
+            return capacity * (get_sample_size() + metadata_size);
+        }
+
+        void assign(size_t capacity, size_t metadata_size)
+        {
+            _capacity = capacity;
+            _metadata_size = metadata_size;
+            _count = 0;
+        }
+
+        bool is_full() const { return _count == _capacity; }
+        size_t get_sample_count() const { return _count; }
+
+        // metadata holds get_metadata_size() bytes, or is null for a sample that arrived without metadata
+        void add_sample(const float xyz[3], double timestamp, unsigned long long frame_number, const void* metadata)
+        {
+            auto data = const_cast<byte*>(get_frame_data());
+            reinterpret_cast<double*>(data)[_count] = timestamp;
+            reinterpret_cast<unsigned long long*>(data + _capacity * sizeof(double))[_count] = frame_number;
+            for (auto axis = 0; axis < 3; axis++)
+                const_cast<float*>(get_axis(axis))[_count] = xyz[axis];
+
+            auto md = const_cast<byte*>(get_metadata()) + _count * _metadata_size;
+            if (metadata)
+                std::copy(static_cast<const byte*>(metadata), static_cast<const byte*>(metadata) + _metadata_size, md);
+            else
+                std::fill(md, md + _metadata_size, byte(0));
+            _count++;
+
+            additional_data.timestamp = timestamp;
+            additional_data.frame_number = frame_number;
+        }
+
+        const double* get_timestamps() const
+        {
+            return reinterpret_cast<const double*>(get_frame_data());
+        }
+
+        const unsigned long long* get_frame_numbers() const
+        {
+            return reinterpret_cast<const unsigned long long*>(get_frame_data() + _capacity * sizeof(double));
+        }
+
+        const float* get_axis(int axis) const
+        {
+            auto axes = get_frame_data() + _capacity * (sizeof(double) + sizeof(unsigned long long));
+            return reinterpret_cast<const float*>(axes) + axis * _capacity;
+        }
+
+        // Raw metadata of every sample, get_metadata_size() bytes each
+        const byte* get_metadata() const
+        {
+            return get_frame_data() + _capacity * get_sample_size();
+        }
+
+        size_t get_metadata_size() const { return _metadata_size; }
+
+    private:
+        static size_t get_sample_size() { return sizeof(double) + sizeof(unsigned long long) + 3 * sizeof(float); }
+
+        size_t _capacity, _metadata_size, _count;
+    };
+
+    MAP_EXTENSION(RS2_EXTENSION_MOTION_BATCH_FRAME, librealsense::motion_batch_frame);
+
     class archive_interface : public sensor_part
     {
     public:
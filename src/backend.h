@@ -25,6 +25,7 @@
 const uint16_t MAX_RETRIES                = 100;
 const uint16_t VID_INTEL_CAMERA           = 0x8086;
 const uint8_t  DEFAULT_V4L2_FRAME_BUFFERS = 4;
+const uint8_t  MAX_V4L2_FRAME_BUFFERS     = 32;
 const uint16_t DELAY_FOR_RETRIES          = 50;
 
 const uint8_t MAX_META_DATA_SIZE          = 0xff; // UVC Metadata total length
@@ -164,12 +165,22 @@ namespace librealsense
 
         constexpr uint8_t uvc_header_size = sizeof(uvc_header);
 
+        // A frame buffer that other processes and devices can map without copying
+        struct dmabuf_descriptor
+        {
+            int             fd;     // Owned by the backend, valid as long as the frame buffer is held
+            uint32_t        offset; // Offset of the first pixel within the dma-buf, in bytes
+            uint32_t        stride; // Bytes from the start of one line to the next
+        };
+
         struct frame_object
         {
             size_t          frame_size;
             uint8_t         metadata_size;
             const void *    pixels;
             const void *    metadata;
+            const dmabuf_descriptor* dmabuf; // Null when the frame buffer is not exported
+            double          backend_time; // System clock time the driver completed the frame at, in milliseconds. 0 when not reported
         };
 
         typedef std::function<void(stream_profile, frame_object, std::function<void()>)> frame_callback;
@@ -304,10 +315,24 @@ namespace librealsense
             uint32_t value;
         };
 
+        // One or more samples of a HID sensor, read together
+        // fo describes the first sample, the others follow it sample_stride bytes apart
         struct sensor_data
         {
             hid_sensor sensor;
             frame_object fo;
+            uint32_t sample_count = 1;
+            uint32_t sample_stride = 0;
+
+            frame_object get_sample(uint32_t index) const
+            {
+                auto sample = fo;
+                auto offset = index * sample_stride;
+                sample.pixels = static_cast<const uint8_t*>(fo.pixels) + offset;
+                if (fo.metadata)
+                    sample.metadata = static_cast<const uint8_t*>(fo.metadata) + offset;
+                return sample;
+            }
         };
 
         struct hid_profile
@@ -387,6 +412,20 @@ namespace librealsense
 
             virtual std::string get_device_location() const = 0;
 
+            // Frames the driver captured but could not hand over because all buffers were taken
+            // Backends that can not detect kernel drops report none
+            virtual unsigned long long get_dropped_frames() const { return 0; }
+            // Whether the number of frame buffers passed to probe_and_commit, and adaptive buffers, take effect
+            virtual bool supports_frame_buffers() const { return false; }
+            // When enabled, the backend grows its buffer pool when the driver drops frames for lack of a buffer, up to MAX_V4L2_FRAME_BUFFERS
+            virtual void enable_adaptive_buffers(bool enable) {}
+            // When enabled, the next probe_and_commit allocates frame buffers that can be exported as dma-bufs
+            // Frames that reference these buffers directly expose them through frame_object::dmabuf
+            virtual void enable_dmabuf_export(bool enable) {}
+            // When enabled, close keeps the negotiated format and the frame buffers of the profile,
+            // and the next probe_and_commit of the same profile reuses them instead of negotiating again
+            // Disabling releases whatever is kept from the last close
+            virtual void enable_warm_restart(bool enable) {}
 
             virtual ~uvc_device() = default;
 
@@ -511,6 +550,31 @@ namespace librealsense
             void lock() const override { _dev->lock(); }
             void unlock() const override { _dev->unlock(); }
 
+            unsigned long long get_dropped_frames() const override
+            {
+                return _dev->get_dropped_frames();
+            }
+
+            bool supports_frame_buffers() const override
+            {
+                return _dev->supports_frame_buffers();
+            }
+
+            void enable_adaptive_buffers(bool enable) override
+            {
+                _dev->enable_adaptive_buffers(enable);
+            }
+
+            void enable_dmabuf_export(bool enable) override
+            {
+                _dev->enable_dmabuf_export(enable);
+            }
+
+            void enable_warm_restart(bool enable) override
+            {
+                _dev->enable_warm_restart(enable);
+            }
+
         private:
             std::shared_ptr<uvc_device> _dev;
         };
@@ -792,6 +856,45 @@ namespace librealsense
                 }
             }
 
+            unsigned long long get_dropped_frames() const override
+            {
+                unsigned long long dropped = 0;
+                for (auto& elem : _dev)
+                {
+                    dropped += elem->get_dropped_frames();
+                }
+                return dropped;
+            }
+
+            bool supports_frame_buffers() const override
+            {
+                return std::all_of(_dev.begin(), _dev.end(), [](const std::shared_ptr<uvc_device>& elem) { return elem->supports_frame_buffers(); });
+            }
+
+            void enable_adaptive_buffers(bool enable) override
+            {
+                for (auto& elem : _dev)
+                {
+                    elem->enable_adaptive_buffers(enable);
+                }
+            }
+
+            void enable_dmabuf_export(bool enable) override
+            {
+                for (auto& elem : _dev)
+                {
+                    elem->enable_dmabuf_export(enable);
+                }
+            }
+
+            void enable_warm_restart(bool enable) override
+            {
+                for (auto& elem : _dev)
+                {
+                    elem->enable_warm_restart(enable);
+                }
+            }
+
         private:
             uint32_t get_dev_index_by_profiles(const stream_profile& profile) const
             {
@@ -822,6 +925,14 @@ namespace librealsense
         public:
             virtual void start(device_changed_callback callback) = 0;
             virtual void stop() = 0;
+
+            // The devices the next change is reported against, as enumerated when the watcher started or by its latest change
+            virtual backend_device_group get_devices() const = 0;
+
+            // Watchers driven by OS events cost nothing while devices do not change,
+            // so they can be kept running just to maintain the device list of the context
+            virtual bool is_event_driven() const { return false; }
+
             virtual ~device_watcher() {};
         };
     }
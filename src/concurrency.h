@@ -8,17 +8,331 @@
 #include <thread>
 #include <atomic>
 #include <functional>
+#include <vector>
+#include <memory>
+#include <chrono>
+#include <cstddef>
+#include <algorithm>
+#include <type_traits>
+#include <cassert>
+
+#include "thread-roles.h"
+
+#if defined(_MSC_VER) && (defined(_M_IX86) || defined(_M_X64))
+#include <intrin.h>
+#define CPU_RELAX() _mm_pause()
+#elif defined(__i386__) || defined(__x86_64__)
+#include <immintrin.h>
+#define CPU_RELAX() _mm_pause()
+#elif defined(__aarch64__)
+#define CPU_RELAX() __asm__ __volatile__("yield")
+#else
+#define CPU_RELAX() std::atomic_signal_fence(std::memory_order_seq_cst)
+#endif
 
 const int QUEUE_MAX_SIZE = 10;
+
+// Spins on pred for up to budget_us before giving up, pausing the core between checks
+// A consumer with a dedicated core avoids the futex wake-up and scheduling latency of parking,
+// at the price of burning the core while it waits
+template<class P>
+bool busy_poll(unsigned int budget_us, P pred)
+{
+    const int CHECKS_PER_CLOCK_READ = 64;
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::microseconds(budget_us);
+    do
+    {
+        for (int i = 0; i < CHECKS_PER_CLOCK_READ; i++)
+        {
+            if (pred()) return true;
+            CPU_RELAX();
+        }
+    } while (std::chrono::steady_clock::now() < deadline);
+    return pred();
+}
+
+// Growable circular buffer
+// Popped slots are reused, so a queue that reached its working size no longer allocates
+template<class T>
+class circular_buffer
+{
+    std::vector<T> _items;
+    size_t _head = 0;
+    size_t _count = 0;
+
+    void grow()
+    {
+        std::vector<T> items(std::max<size_t>(4, _items.size() * 2));
+        for (size_t i = 0; i < _count; i++)
+            items[i] = std::move(_items[(_head + i) % _items.size()]);
+        _items.swap(items);
+        _head = 0;
+    }
+public:
+    size_t size() const { return _count; }
+    T& front() { return _items[_head]; }
+
+    void push_back(T&& item)
+    {
+        if (_count == _items.size()) grow();
+        _items[(_head + _count) % _items.size()] = std::move(item);
+        _count++;
+    }
+
+    void pop_front()
+    {
+        _items[_head] = T(); // Release whatever the moved-from item still holds
+        _head = (_head + 1) % _items.size();
+        _count--;
+    }
+
+    void clear()
+    {
+        while (_count) pop_front();
+    }
+};
+
+// Move-only type-erased callable
+// Targets of up to Size bytes are stored inline, so constructing and moving the callable does not allocate
+// Larger targets are supported, but are stored on the heap
+template<class Signature, size_t Size = 96>
+class inplace_function;
+
+template<class R, class... Args, size_t Size>
+class inplace_function<R(Args...), Size>
+{
+    typedef typename std::aligned_storage<Size, alignof(std::max_align_t)>::type storage;
+
+    struct operations
+    {
+        R (*invoke)(void* target, Args&&... args);
+        void (*move)(void* to, void* from);
+        void (*destroy)(void* target);
+    };
+
+    template<class F>
+    struct inline_target
+    {
+        static R invoke(void* target, Args&&... args) { return (*static_cast<F*>(target))(std::forward<Args>(args)...); }
+        static void move(void* to, void* from) { new (to) F(std::move(*static_cast<F*>(from))); }
+        static void destroy(void* target) { static_cast<F*>(target)->~F(); }
+        static const operations* get() { static const operations ops = { &invoke, &move, &destroy }; return &ops; }
+    };
+
+    template<class F>
+    struct heap_target
+    {
+        static F*& ptr(void* target) { return *static_cast<F**>(target); }
+        static R invoke(void* target, Args&&... args) { return (*ptr(target))(std::forward<Args>(args)...); }
+        static void move(void* to, void* from) { new (to) F*(ptr(from)); ptr(from) = nullptr; }
+        static void destroy(void* target) { delete ptr(target); }
+        static const operations* get() { static const operations ops = { &invoke, &move, &destroy }; return &ops; }
+    };
+
+    storage _storage;
+    const operations* _ops = nullptr;
+
+    void reset()
+    {
+        if (_ops) _ops->destroy(&_storage);
+        _ops = nullptr;
+    }
+
+    template<class T, class F>
+    void construct(F&& f, std::true_type /* fits inline */)
+    {
+        new (&_storage) T(std::forward<F>(f));
+        _ops = inline_target<T>::get();
+    }
+
+    template<class T, class F>
+    void construct(F&& f, std::false_type /* fits inline */)
+    {
+        new (&_storage) T*(new T(std::forward<F>(f)));
+        _ops = heap_target<T>::get();
+    }
+public:
+    inplace_function() {}
+
+    template<class F, class = typename std::enable_if<!std::is_same<typename std::decay<F>::type, inplace_function>::value>::type>
+    inplace_function(F&& f)
+    {
+        typedef typename std::decay<F>::type target;
+        construct<target>(std::forward<F>(f), std::integral_constant<bool,
+            sizeof(target) <= Size && alignof(target) <= alignof(std::max_align_t)>());
+    }
+
+    inplace_function(inplace_function&& other)
+        : _ops(other._ops)
+    {
+        if (_ops) _ops->move(&_storage, &other._storage);
+        other.reset();
+    }
+
+    inplace_function& operator=(inplace_function&& other)
+    {
+        if (this != &other)
+        {
+            reset();
+            _ops = other._ops;
+            if (_ops) _ops->move(&_storage, &other._storage);
+            other.reset();
+        }
+        return *this;
+    }
+
+    inplace_function(const inplace_function&) = delete;
+    inplace_function& operator=(const inplace_function&) = delete;
+
+    ~inplace_function() { reset(); }
+
+    explicit operator bool() const { return _ops != nullptr; }
+
+    R operator()(Args... args)
+    {
+        return _ops->invoke(&_storage, std::forward<Args>(args)...);
+    }
+};
+
+// What a bounded queue does with an item arriving while it is full
+enum class queue_policy
+{
+    drop_oldest, // Make room by dropping the oldest item
+    drop_newest, // Drop the arriving item
+    block,       // Wait for room up to a timeout, then drop the arriving item
+    keep_latest  // Drop every queued item, so only the newest one is kept
+};
+
+struct queue_stats
+{
+    unsigned long long enqueued = 0;
+    unsigned long long dropped = 0;
+    size_t high_water_mark = 0;
+    double average_residency_ms = 0; // Time between enqueue and dequeue of the dequeued items
+    double average_wake_latency_us = 0; // Time between enqueue and dequeue of items a consumer was waiting for
+    double max_wake_latency_us = 0;
+};
+
+// Counters shared by the bounded queues, updated without locking
+// Timing items costs a clock read per enqueue, so items are only stamped once the stats
+// were read for the first time, and the residency and wake latency cover items enqueued since
+class queue_counters
+{
+public:
+    typedef std::chrono::steady_clock clock;
+
+    // Enqueue time of an item, or a zero time point while no one reads the stats
+    clock::time_point stamp() const
+    {
+        return _timed.load(std::memory_order_relaxed) ? clock::now() : clock::time_point();
+    }
+
+    void on_enqueue(size_t size)
+    {
+        _enqueued.fetch_add(1, std::memory_order_relaxed);
+        auto high = _high_water_mark.load(std::memory_order_relaxed);
+        while (size > high && !_high_water_mark.compare_exchange_weak(high, size, std::memory_order_relaxed)) {}
+    }
+
+    void on_drop(size_t count = 1)
+    {
+        _dropped.fetch_add(count, std::memory_order_relaxed);
+    }
+
+    void on_dequeue(clock::time_point enqueued_at)
+    {
+        if (enqueued_at == clock::time_point()) return;
+        auto residency = std::chrono::duration_cast<std::chrono::microseconds>(clock::now() - enqueued_at).count();
+        _residency_us.fetch_add(static_cast<unsigned long long>(residency), std::memory_order_relaxed);
+        _dequeued.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    // Called for items that arrived while the consumer was waiting, on top of on_dequeue
+    void on_wake(clock::time_point enqueued_at)
+    {
+        if (enqueued_at == clock::time_point()) return;
+        auto latency = static_cast<unsigned long long>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(clock::now() - enqueued_at).count());
+        _wake_latency_ns.fetch_add(latency, std::memory_order_relaxed);
+        _wakes.fetch_add(1, std::memory_order_relaxed);
+        auto max = _max_wake_latency_ns.load(std::memory_order_relaxed);
+        while (latency > max && !_max_wake_latency_ns.compare_exchange_weak(max, latency, std::memory_order_relaxed)) {}
+    }
+
+    queue_stats get() const
+    {
+        _timed.store(true, std::memory_order_relaxed);
+        queue_stats stats;
+        stats.enqueued = _enqueued.load(std::memory_order_relaxed);
+        stats.dropped = _dropped.load(std::memory_order_relaxed);
+        stats.high_water_mark = _high_water_mark.load(std::memory_order_relaxed);
+        auto dequeued = _dequeued.load(std::memory_order_relaxed);
+        if (dequeued)
+            stats.average_residency_ms = _residency_us.load(std::memory_order_relaxed) / 1000.0 / dequeued;
+        auto wakes = _wakes.load(std::memory_order_relaxed);
+        if (wakes)
+            stats.average_wake_latency_us = _wake_latency_ns.load(std::memory_order_relaxed) / 1000.0 / wakes;
+        stats.max_wake_latency_us = _max_wake_latency_ns.load(std::memory_order_relaxed) / 1000.0;
+        return stats;
+    }
+
+private:
+    std::atomic<unsigned long long> _enqueued{ 0 };
+    std::atomic<unsigned long long> _dropped{ 0 };
+    std::atomic<size_t> _high_water_mark{ 0 };
+    std::atomic<unsigned long long> _dequeued{ 0 };
+    std::atomic<unsigned long long> _residency_us{ 0 };
+    std::atomic<unsigned long long> _wakes{ 0 };
+    std::atomic<unsigned long long> _wake_latency_ns{ 0 };
+    std::atomic<unsigned long long> _max_wake_latency_ns{ 0 };
+    mutable std::atomic<bool> _timed{ false };
+};
+
+// Common interface of the bounded queues that can back a user frame queue
+template<class T>
+class bounded_queue
+{
+public:
+    virtual void enqueue(T&& item) = 0;
+    virtual bool dequeue(T* item, unsigned int timeout_ms) = 0;
+    virtual bool try_dequeue(T* item) = 0;
+
+    // Waits up to timeout_ms for the first item, then drains whatever else is ready, up to max_items
+    virtual size_t dequeue_batch(std::vector<T>* items, size_t max_items, unsigned int timeout_ms) = 0;
+
+    virtual void clear() = 0;
+    virtual void start() = 0;
+    virtual size_t size() = 0;
+
+    // Makes waiting consumers spin for up to budget_us before parking, 0 parks right away
+    virtual void set_busy_poll(unsigned int budget_us) = 0;
+
+    virtual queue_stats get_stats() const = 0;
+
+    virtual ~bounded_queue() = default;
+};
+
 // Simplest implementation of a blocking concurrent queue for thread messaging
 template<class T>
-class single_consumer_queue
+class single_consumer_queue : public bounded_queue<T>
 {
-    std::deque<T> q;
+    struct entry
+    {
+        T item;
+        queue_counters::clock::time_point enqueued_at;
+    };
+
+    circular_buffer<entry> q;
     std::mutex mutex;
     std::condition_variable cv; // not empty signal
+    std::condition_variable not_full_cv; // used by the blocking policy only
     unsigned int cap;
+    queue_policy policy;
+    unsigned int block_timeout_ms;
     bool accepting;
+    queue_counters counters;
+    std::atomic<unsigned int> busy_poll_us;
+    std::atomic<size_t> available; // Mirrors q.size() for consumers polling without the lock
 
     // flush mechanism is required to abort wait on cv
     // when need to stop
@@ -26,33 +340,93 @@ class single_consumer_queue
     std::atomic<bool> was_flushed;
     std::condition_variable was_flushed_cv;
     std::mutex was_flushed_mutex;
+
+    void pop_front(T* item)
+    {
+        counters.on_dequeue(q.front().enqueued_at);
+        *item = std::move(q.front().item);
+        q.pop_front();
+        available = q.size();
+        if (policy == queue_policy::block) not_full_cv.notify_one();
+    }
+
+    template<class P>
+    bool wait_ready(std::unique_lock<std::mutex>& lock, unsigned int timeout_ms, P ready)
+    {
+        auto timeout = std::chrono::microseconds(timeout_ms * 1000ULL);
+        auto budget = std::min<unsigned long long>(busy_poll_us, timeout.count());
+        if (budget)
+        {
+            auto start = std::chrono::steady_clock::now();
+            lock.unlock();
+            busy_poll(static_cast<unsigned int>(budget), [this]() { return available > 0 || need_to_flush; });
+            lock.lock();
+            if (ready()) return true;
+            timeout -= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        }
+        return cv.wait_for(lock, timeout, ready);
+    }
 public:
-    explicit single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE)
-        : q(), mutex(), cv(), cap(cap), need_to_flush(false), was_flushed(false), accepting(true)
+    explicit single_consumer_queue<T>(unsigned int cap = QUEUE_MAX_SIZE,
+                                      queue_policy policy = queue_policy::drop_oldest,
+                                      unsigned int block_timeout_ms = 0)
+        : q(), mutex(), cv(), cap(cap), policy(policy), block_timeout_ms(block_timeout_ms),
+          accepting(true), busy_poll_us(0), available(0), need_to_flush(false), was_flushed(false)
     {}
 
-    void enqueue(T&& item)
+    void enqueue(T&& item) override
     {
         std::unique_lock<std::mutex> lock(mutex);
         if (accepting)
         {
-            q.push_back(std::move(item));
+            switch (policy)
+            {
+            case queue_policy::drop_newest:
+                if (q.size() >= cap)
+                {
+                    counters.on_drop();
+                    return;
+                }
+                break;
+            case queue_policy::block:
+                if (q.size() >= cap &&
+                    !not_full_cv.wait_for(lock, std::chrono::milliseconds(block_timeout_ms),
+                                          [this]() { return q.size() < cap || !accepting; }))
+                {
+                    counters.on_drop();
+                    return;
+                }
+                if (!accepting) return;
+                break;
+            case queue_policy::keep_latest:
+                counters.on_drop(q.size());
+                q.clear();
+                break;
+            default:
+                break;
+            }
+
+            q.push_back({ std::move(item), counters.stamp() });
             if (q.size() > cap)
             {
                 q.pop_front();
+                counters.on_drop();
             }
+            available = q.size();
+            counters.on_enqueue(q.size());
         }
         lock.unlock();
         cv.notify_one();
     }
 
-    bool dequeue(T* item ,unsigned int timeout_ms = 5000)
+    bool dequeue(T* item ,unsigned int timeout_ms = 5000) override
     {
         std::unique_lock<std::mutex> lock(mutex);
         accepting = true;
         was_flushed = false;
         const auto ready = [this]() { return (q.size() > 0) || need_to_flush; };
-        if (!ready() && !cv.wait_for(lock, std::chrono::milliseconds(timeout_ms), ready))
+        auto waited = !ready();
+        if (waited && !wait_ready(lock, timeout_ms, ready))
         {
             return false;
         }
@@ -61,8 +435,8 @@ public:
         {
             return false;
         }
-        *item = std::move(q.front());
-        q.pop_front();
+        if (waited) counters.on_wake(q.front().enqueued_at);
+        pop_front(item);
         return true;
     }
 
@@ -74,25 +448,47 @@ public:
         {
             return false;
         }
-        *item = &q.front();
+        *item = &q.front().item;
         return true;
     }
 
-    bool try_dequeue(T* item)
+    bool try_dequeue(T* item) override
     {
         std::unique_lock<std::mutex> lock(mutex);
         accepting = true;
         if (q.size() > 0)
         {
-            auto val = std::move(q.front());
-            q.pop_front();
-            *item = std::move(val);
+            pop_front(item);
             return true;
         }
         return false;
     }
 
-    void clear()
+    size_t dequeue_batch(std::vector<T>* items, size_t max_items, unsigned int timeout_ms) override
+    {
+        std::unique_lock<std::mutex> lock(mutex);
+        accepting = true;
+        was_flushed = false;
+        const auto ready = [this]() { return (q.size() > 0) || need_to_flush; };
+        auto waited = !ready();
+        if (waited && !wait_ready(lock, timeout_ms, ready))
+        {
+            return 0;
+        }
+        if (waited && q.size() > 0) counters.on_wake(q.front().enqueued_at);
+
+        size_t count = 0;
+        T item;
+        while (q.size() > 0 && count < max_items)
+        {
+            pop_front(&item);
+            items->push_back(std::move(item));
+            count++;
+        }
+        return count;
+    }
+
+    void clear() override
     {
         std::unique_lock<std::mutex> lock(mutex);
 
@@ -104,23 +500,326 @@ public:
             auto item = std::move(q.front());
             q.pop_front();
         }
+        available = 0;
         cv.notify_all();
+        not_full_cv.notify_all();
     }
 
-    void start()
+    void start() override
     {
         std::unique_lock<std::mutex> lock(mutex);
         need_to_flush = false;
         accepting = true;
     }
 
-    size_t size()
+    size_t size() override
     {
         std::unique_lock<std::mutex> lock(mutex);
         return q.size();
     }
+
+    void set_busy_poll(unsigned int budget_us) override
+    {
+        busy_poll_us = budget_us;
+    }
+
+    queue_stats get_stats() const override
+    {
+        return counters.get();
+    }
 };
 
+// Bounded lock-free ring buffer queue (after D. Vyukov's bounded MPMC queue)
+// Every cell carries a sequence number telling whether it is ready to be written or read,
+// so producers and consumer only contend on their own position counter
+// With a single producer the write position is advanced without compare-and-swap,
+// so enqueue must never be called from two threads at once (debug builds assert on it)
+// Consumers spin briefly before parking on a condition variable, and producers
+// touch the condition variable only while a consumer is parked
+// Under the blocking policy producers wait for room the same way
+template<class T>
+class ring_queue : public bounded_queue<T>
+{
+    struct cell
+    {
+        std::atomic<size_t> sequence;
+        T data;
+        queue_counters::clock::time_point enqueued_at;
+    };
+
+    static const int SPIN_COUNT = 64;
+    static const int YIELD_COUNT = 16;
+
+    std::unique_ptr<cell[]> _cells;
+    size_t _cap;
+    bool _multiple_producers;
+    queue_policy _policy;
+    unsigned int _block_timeout_ms;
+
+    // Kept on separate cache lines, producers and consumer write them concurrently
+    char _pad0[64];
+    std::atomic<size_t> _enqueue_pos;
+    char _pad1[64];
+    std::atomic<size_t> _dequeue_pos;
+    char _pad2[64];
+
+    std::atomic<bool> _accepting;
+    std::atomic<bool> _need_to_flush;
+    queue_counters _counters;
+
+    std::mutex _park_mutex;
+    std::condition_variable _park_cv;
+    std::atomic<int> _parked;
+
+    std::condition_variable _not_full_cv;
+    std::atomic<int> _blocked;
+
+    std::atomic<unsigned int> _busy_poll_us;
+
+#ifndef NDEBUG
+    std::atomic<int> _producers{ 0 };
+#endif
+
+    bool try_push(T& item)
+    {
+        auto pos = _enqueue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& c = _cells[pos % _cap];
+            auto seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos);
+            if (diff == 0)
+            {
+                if (!_multiple_producers)
+                {
+                    _enqueue_pos.store(pos + 1, std::memory_order_relaxed);
+                }
+                else if (!_enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    continue;
+                }
+                c.data = std::move(item);
+                c.enqueued_at = _counters.stamp();
+                c.sequence.store(pos + 1);
+                return true;
+            }
+            if (diff < 0) return false; // Full
+            pos = _enqueue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool try_pop(T* item, bool count = true, bool woken = false)
+    {
+        auto pos = _dequeue_pos.load(std::memory_order_relaxed);
+        while (true)
+        {
+            auto& c = _cells[pos % _cap];
+            auto seq = c.sequence.load(std::memory_order_acquire);
+            auto diff = static_cast<std::ptrdiff_t>(seq) - static_cast<std::ptrdiff_t>(pos + 1);
+            if (diff == 0)
+            {
+                // The consumer position is always advanced by compare-and-swap,
+                // since a producer facing a full ring evicts the oldest item through it
+                if (_dequeue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                {
+                    *item = std::move(c.data);
+                    if (count) _counters.on_dequeue(c.enqueued_at);
+                    if (woken) _counters.on_wake(c.enqueued_at);
+                    c.sequence.store(pos + _cap);
+                    if (_blocked.load()) wake(_not_full_cv);
+                    return true;
+                }
+                continue;
+            }
+            if (diff < 0) return false; // Empty
+            pos = _dequeue_pos.load(std::memory_order_relaxed);
+        }
+    }
+
+    bool ready()
+    {
+        auto pos = _dequeue_pos.load();
+        return _cells[pos % _cap].sequence.load() == pos + 1 || _need_to_flush;
+    }
+
+    bool has_room()
+    {
+        auto pos = _enqueue_pos.load();
+        return _cells[pos % _cap].sequence.load() == pos || !_accepting;
+    }
+
+    void wake(std::condition_variable& cv)
+    {
+        std::lock_guard<std::mutex> lock(_park_mutex);
+        cv.notify_all();
+    }
+
+    template<class P>
+    bool spin_then_park(std::condition_variable& cv, std::atomic<int>& parked, unsigned int timeout_ms, P pred,
+                        unsigned int busy_poll_us = 0)
+    {
+        auto timeout = std::chrono::microseconds(timeout_ms * 1000ULL);
+        auto budget = std::min<unsigned long long>(busy_poll_us, timeout.count());
+        if (budget)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (busy_poll(static_cast<unsigned int>(budget), pred)) return true;
+            timeout -= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        }
+        else
+        {
+            for (int i = 0; i < SPIN_COUNT + YIELD_COUNT; i++)
+            {
+                if (pred()) return true;
+                if (i >= SPIN_COUNT) std::this_thread::yield();
+            }
+        }
+
+        parked.fetch_add(1);
+        bool res;
+        {
+            std::unique_lock<std::mutex> lock(_park_mutex);
+            res = cv.wait_for(lock, timeout, pred);
+        }
+        parked.fetch_sub(1);
+        return res;
+    }
+
+    bool wait_ready(unsigned int timeout_ms)
+    {
+        return spin_then_park(_park_cv, _parked, timeout_ms, [this]() { return ready(); }, _busy_poll_us);
+    }
+
+public:
+    explicit ring_queue(unsigned int cap = QUEUE_MAX_SIZE, bool multiple_producers = true,
+                        queue_policy policy = queue_policy::drop_oldest, unsigned int block_timeout_ms = 0)
+        : _cells(new cell[cap ? cap : 1]), _cap(cap ? cap : 1), _multiple_producers(multiple_producers),
+          _policy(policy), _block_timeout_ms(block_timeout_ms),
+          _enqueue_pos(0), _dequeue_pos(0), _accepting(true), _need_to_flush(false), _parked(0), _blocked(0), _busy_poll_us(0)
+    {
+        for (size_t i = 0; i < _cap; i++)
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    void enqueue(T&& item) override
+    {
+#ifndef NDEBUG
+        struct producer_check
+        {
+            ring_queue* owner;
+            explicit producer_check(ring_queue* owner) : owner(owner)
+            {
+                auto producers = owner->_producers.fetch_add(1);
+                assert(owner->_multiple_producers || producers == 0);
+                (void)producers;
+            }
+            ~producer_check() { owner->_producers.fetch_sub(1); }
+        } check(this);
+#endif
+        if (!_accepting) return;
+
+        T dropped;
+        if (_policy == queue_policy::keep_latest)
+        {
+            while (try_pop(&dropped, false))
+                _counters.on_drop();
+        }
+
+        while (!try_push(item))
+        {
+            if (_policy == queue_policy::drop_newest)
+            {
+                _counters.on_drop();
+                return;
+            }
+            if (_policy == queue_policy::block)
+            {
+                if (!spin_then_park(_not_full_cv, _blocked, _block_timeout_ms, [this]() { return has_room(); })
+                    || !_accepting)
+                {
+                    _counters.on_drop();
+                    return;
+                }
+                continue;
+            }
+
+            // Make room by dropping the oldest item
+            if (try_pop(&dropped, false))
+                _counters.on_drop();
+        }
+        _counters.on_enqueue(size());
+        if (_parked.load()) wake(_park_cv);
+    }
+
+    bool dequeue(T* item, unsigned int timeout_ms = 5000) override
+    {
+        _accepting = true;
+        if (try_pop(item)) return true;
+        if (!wait_ready(timeout_ms)) return false;
+        return try_pop(item, true, true);
+    }
+
+    bool try_dequeue(T* item) override
+    {
+        _accepting = true;
+        return try_pop(item);
+    }
+
+    size_t dequeue_batch(std::vector<T>* items, size_t max_items, unsigned int timeout_ms) override
+    {
+        _accepting = true;
+        size_t count = 0;
+        T item;
+        auto waited = max_items && !ready();
+        if (waited && !wait_ready(timeout_ms))
+            return 0;
+
+        while (count < max_items && try_pop(&item, true, waited && !count))
+        {
+            items->push_back(std::move(item));
+            count++;
+        }
+        return count;
+    }
+
+    void clear() override
+    {
+        _accepting = false;
+        _need_to_flush = true;
+
+        {
+            T item;
+            while (try_pop(&item, false)) {}
+        }
+
+        std::lock_guard<std::mutex> lock(_park_mutex);
+        _park_cv.notify_all();
+        _not_full_cv.notify_all();
+    }
+
+    void start() override
+    {
+        _need_to_flush = false;
+        _accepting = true;
+    }
+
+    size_t size() override
+    {
+        auto enqueued = _enqueue_pos.load();
+        auto dequeued = _dequeue_pos.load();
+        return enqueued > dequeued ? enqueued - dequeued : 0;
+    }
+
+    void set_busy_poll(unsigned int budget_us) override
+    {
+        _busy_poll_us = budget_us;
+    }
+
+    queue_stats get_stats() const override
+    {
+        return _counters.get();
+    }
+};
 
 class dispatcher
 {
@@ -145,17 +844,23 @@ public:
         dispatcher* _owner;
     };
 
-    dispatcher(unsigned int cap)
-        : _queue(cap),
+    // Tasks are stored inline, so that dispatching a frame does not allocate
+    typedef inplace_function<void(cancellable_timer)> task;
+
+    dispatcher(unsigned int cap, rs2_thread_role role = RS2_THREAD_ROLE_DISPATCH,
+               queue_policy policy = queue_policy::drop_oldest, unsigned int block_timeout_ms = 0)
+        : _queue(cap, policy, block_timeout_ms),
           _was_stopped(true),
           _was_flushed(false),
           _is_alive(true)
     {
-        _thread = std::thread([&]()
+        _thread = std::thread([this, role]()
         {
+            librealsense::apply_thread_role(role);
+
             while (_is_alive)
             {
-                std::function<void(cancellable_timer)> item;
+                task item;
 
                 if (_queue.dequeue(&item))
                 {
@@ -241,7 +946,7 @@ public:
     }
 private:
     friend cancellable_timer;
-    single_consumer_queue<std::function<void(cancellable_timer)>> _queue;
+    single_consumer_queue<task> _queue;
     std::thread _thread;
 
     std::atomic<bool> _was_stopped;
@@ -259,8 +964,8 @@ template<class T = std::function<void(dispatcher::cancellable_timer)>>
 class active_object
 {
 public:
-    active_object(T operation)
-        : _operation(std::move(operation)), _dispatcher(1), _stopped(true)
+    active_object(T operation, rs2_thread_role role = RS2_THREAD_ROLE_DISPATCH)
+        : _operation(std::move(operation)), _dispatcher(1, role), _stopped(true)
     {
     }
 
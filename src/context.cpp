@@ -75,7 +75,8 @@ namespace librealsense
                      const char* filename,
                      const char* section,
                      rs2_recording_mode mode)
-        : _devices_changed_callback(nullptr, [](rs2_devices_changed_callback*){})
+        : _watching(false),
+          _devices_changed_callback(nullptr, [](rs2_devices_changed_callback*){})
     {
         LOG_DEBUG("Librealsense " << std::string(std::begin(rs2_api_version),std::end(rs2_api_version)));
 
@@ -99,6 +100,16 @@ namespace librealsense
        _device_watcher = _backend->create_device_watcher();
     }
 
+    context::context(std::shared_ptr<platform::backend> backend)
+        : _backend(backend),
+          _watching(false),
+          _devices_changed_callback(nullptr, [](rs2_devices_changed_callback*){})
+    {
+        environment::get_instance().set_time_service(_backend->create_time_service());
+
+        _device_watcher = _backend->create_device_watcher();
+    }
+
 
     class recovery_info : public device_info
     {
@@ -269,10 +280,56 @@ namespace librealsense
 
     std::vector<std::shared_ptr<device_info>> context::query_devices() const
     {
+        // Watchers that do not poll are started on demand, so that repeated queries do not enumerate the devices again
+        if (!_watching && _device_watcher->is_event_driven())
+            const_cast<context*>(this)->start_device_watcher();
 
-        platform::backend_device_group devices(_backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices());
+        if (!_watching)
+        {
+            platform::backend_device_group devices(_backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices());
+            return create_devices(devices, _playback_devices);
+        }
 
-        return create_devices(devices, _playback_devices);
+        devices_info list;
+        {
+            std::lock_guard<std::mutex> lock(_devices_mutex);
+            list = _devices;
+        }
+        for (auto&& item : _playback_devices)
+        {
+            list.push_back(item.second);
+        }
+        return list;
+    }
+
+    void context::start_device_watcher()
+    {
+        // The devices lock is not held here, stopping the watcher waits for callbacks that take it
+        std::lock_guard<std::mutex> lock(_watcher_mutex);
+        if (_watching) return;
+
+        // Watchers only start from a stopped state, whichever way they were created
+        _device_watcher->stop();
+        _device_watcher->start([this](platform::backend_device_group old, platform::backend_device_group curr)
+        {
+            on_device_changed(curr);
+        });
+
+        // The watcher enumerated the devices as it started, and reports its changes against that enumeration
+        auto devices = create_devices(_device_watcher->get_devices(), {});
+        {
+            std::lock_guard<std::mutex> devices_lock(_devices_mutex);
+            _devices = devices;
+            _watching = true;
+        }
+        _devices_ready.notify_all();
+    }
+
+    void context::stop()
+    {
+        std::lock_guard<std::mutex> lock(_watcher_mutex);
+        _device_watcher->stop();
+        _watching = false;
     }
 
     std::vector<std::shared_ptr<device_info>> context::create_devices(platform::backend_device_group devices,
@@ -305,14 +362,32 @@ namespace librealsense
     }
 
 
-    void context::on_device_changed(platform::backend_device_group old,
-                                    platform::backend_device_group curr,
-                                    const std::map<std::string, std::shared_ptr<device_info>>& old_playback_devices,
-                                    const std::map<std::string, std::shared_ptr<device_info>>& new_playback_devices)
+    void context::on_device_changed(const platform::backend_device_group& curr)
     {
-        auto old_list = create_devices(old, old_playback_devices);
-        auto new_list = create_devices(curr, new_playback_devices);
+        auto new_list = create_devices(curr, {});
+
+        devices_info old_list;
+        {
+            // Changes raised while the watcher starts are diffed against its initial enumeration
+            std::unique_lock<std::mutex> lock(_devices_mutex);
+            _devices_ready.wait(lock, [this]() { return _watching.load(); });
+            old_list = _devices;
+
+            // Devices that stayed connected keep their device_info, only the difference is built anew
+            for (auto&& dev : new_list)
+            {
+                auto it = std::find_if(old_list.begin(), old_list.end(), [&](const std::shared_ptr<device_info>& old_dev) { return *old_dev == *dev; });
+                if (it != old_list.end())
+                    dev = *it;
+            }
+            _devices = new_list;
+        }
 
+        notify_devices_changed(old_list, new_list);
+    }
+
+    void context::notify_devices_changed(const devices_info& old_list, const devices_info& new_list)
+    {
         if (librealsense::list_changed<std::shared_ptr<device_info>>(old_list, new_list, [](std::shared_ptr<device_info> first, std::shared_ptr<device_info> second) {return *first == *second; }))
         {
 
@@ -335,9 +410,11 @@ namespace librealsense
             }
 
             std::map<uint64_t, devices_changed_callback_ptr> devices_changed_callbacks;
+            devices_changed_callback_ptr devices_changed_callback;
             {
                 std::lock_guard<std::mutex> lock(_devices_changed_callbacks_mtx);
                 devices_changed_callbacks = _devices_changed_callbacks;
+                devices_changed_callback = _devices_changed_callback;
             }
 
             for (auto& kvp : devices_changed_callbacks)
@@ -353,11 +430,11 @@ namespace librealsense
                 }
             }
 
-            if (_devices_changed_callback)
+            if (devices_changed_callback)
             {
                 try
                 {
-                    _devices_changed_callback->on_devices_changed(new rs2_device_list({ shared_from_this(), rs2_devices_info_removed }),
+                    devices_changed_callback->on_devices_changed(new rs2_device_list({ shared_from_this(), rs2_devices_info_removed }),
                         new rs2_device_list({ shared_from_this(), rs2_devices_info_added }));
                 }
                 catch (...)
@@ -379,13 +456,11 @@ namespace librealsense
 
     void context::set_devices_changed_callback(devices_changed_callback_ptr callback)
     {
-        _device_watcher->stop();
-
-        _devices_changed_callback = std::move(callback);
-        _device_watcher->start([this](platform::backend_device_group old, platform::backend_device_group curr)
         {
-            on_device_changed(old, curr, _playback_devices, _playback_devices);
-        });
+            std::lock_guard<std::mutex> lock(_devices_changed_callbacks_mtx);
+            _devices_changed_callback = std::move(callback);
+        }
+        start_device_watcher();
     }
 
     void context::unregister_internal_device_callback(uint64_t cb_id)
@@ -433,9 +508,9 @@ namespace librealsense
         }
         auto playack_dev = std::make_shared<playback_device>(shared_from_this(), std::make_shared<ros_reader>(file, shared_from_this()));
         auto dinfo = std::make_shared<playback_device_info>(playack_dev);
-        auto prev_playback_devices = _playback_devices;
+        auto prev_playback_devices = create_devices({}, _playback_devices);
         _playback_devices[file] = dinfo;
-        on_device_changed({}, {}, prev_playback_devices, _playback_devices);
+        notify_devices_changed(prev_playback_devices, create_devices({}, _playback_devices));
         return playack_dev;
     }
 
@@ -447,9 +522,9 @@ namespace librealsense
             //Not found
             return;
         }
-        auto prev_playback_devices =_playback_devices;
+        auto prev_playback_devices = create_devices({}, _playback_devices);
         _playback_devices.erase(it);
-        on_device_changed({},{}, prev_playback_devices, _playback_devices);
+        notify_devices_changed(prev_playback_devices, create_devices({}, _playback_devices));
     }
 
     std::vector<std::vector<platform::uvc_device_info>> group_devices_by_unique_id(const std::vector<platform::uvc_device_info>& devices)
@@ -110,8 +110,9 @@ namespace librealsense
             const char* filename = nullptr,
             const char* section = nullptr,
             rs2_recording_mode mode = RS2_RECORDING_MODE_COUNT);
+        explicit context(std::shared_ptr<platform::backend> backend);
 
-        void stop(){_device_watcher->stop();}
+        void stop();
         ~context();
         std::vector<std::shared_ptr<device_info>> query_devices() const;
         const platform::backend& get_backend() const { return *_backend; }
@@ -128,7 +129,9 @@ namespace librealsense
         void remove_device(const std::string& file);
 
     private:
-        void on_device_changed(platform::backend_device_group old, platform::backend_device_group curr, const std::map<std::string, std::shared_ptr<device_info>>& old_playback_devices, const std::map<std::string, std::shared_ptr<device_info>>& new_playback_devices);
+        void start_device_watcher();
+        void on_device_changed(const platform::backend_device_group& curr);
+        void notify_devices_changed(const devices_info& old_list, const devices_info& new_list);
 
         int find_stream_profile(const stream_interface& p);
         std::shared_ptr<lazy<rs2_extrinsics>> fetch_edge(int from, int to);
@@ -137,6 +140,13 @@ namespace librealsense
 
         std::shared_ptr<platform::device_watcher> _device_watcher;
         std::map<std::string, std::shared_ptr<device_info>> _playback_devices;
+
+        // While the device watcher runs, the backend devices are cached and updated from its events
+        std::mutex _watcher_mutex; // Serializes starting and stopping the watcher, never taken by its callbacks
+        mutable std::mutex _devices_mutex;
+        std::condition_variable _devices_ready; // Signaled once the initial devices are cached
+        std::atomic<bool> _watching;
+        devices_info _devices;
         std::map<uint64_t, devices_changed_callback_ptr> _devices_changed_callbacks;
 
 
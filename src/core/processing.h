@@ -30,6 +30,8 @@ namespace librealsense
                                                       rs2_extension frame_type = RS2_EXTENSION_VIDEO_FRAME) = 0;
 
         virtual frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) = 0;
+        // Takes the frames out of the holders, so callers can keep reusing their own storage
+        virtual frame_interface* allocate_composite_frame(frame_holder* frames, size_t count) = 0;
 
         virtual frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original) = 0;
 
@@ -42,6 +44,7 @@ namespace librealsense
     public:
         virtual void set_processing_callback(frame_processor_callback_ptr callback) = 0;
         virtual void set_output_callback(frame_callback_ptr callback) = 0;
+        virtual frame_callback_ptr get_output_callback() = 0;
         virtual void invoke(frame_holder frame) = 0;
         virtual synthetic_source_interface& get_source() = 0;
 
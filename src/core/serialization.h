@@ -306,6 +306,12 @@ namespace librealsense
             virtual void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) = 0;
             virtual void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) = 0;
             virtual const std::string& get_file_name() const = 0;
+
+            // Frames of a stream are numbered from 0 in the order of their timestamps
+            virtual size_t query_frame_count(const stream_identifier& stream_id) = 0;
+            virtual nanoseconds query_frame_time(const stream_identifier& stream_id, size_t frame_number) = 0;
+            // Number of the last frame at or before the given time, 0 when the stream starts later
+            virtual size_t query_frame_number(const stream_identifier& stream_id, const nanoseconds& time) = 0;
         };
     }
 }
@@ -74,6 +74,7 @@ namespace librealsense
 
         virtual void set_timestamp_domain(rs2_timestamp_domain timestamp_domain) = 0;
         virtual rs2_time_t get_frame_system_time() const = 0;
+        virtual rs2_time_t get_frame_backend_time() const = 0;
 
         virtual std::shared_ptr<stream_profile_interface> get_stream() const = 0;
         virtual void set_stream(std::shared_ptr<stream_profile_interface> sp) = 0;
@@ -86,6 +87,7 @@ namespace librealsense
         virtual frame_interface* publish(std::shared_ptr<archive_interface> new_owner) = 0;
         virtual void attach_continuation(frame_continuation&& continuation) = 0;
         virtual void disable_continuation() = 0;
+        virtual const platform::dmabuf_descriptor* get_dmabuf() const = 0;
 
         virtual void log_callback_start(rs2_time_t timestamp) = 0;
         virtual void log_callback_end(rs2_time_t timestamp) const = 0;
@@ -98,6 +100,16 @@ namespace librealsense
     using on_frame = std::function<void(frame_interface*)>;
     using stream_profiles = std::vector<std::shared_ptr<stream_profile_interface>>;
 
+    // Time from the completion of frames by the host driver to the invocation of the user callback
+    struct latency_stats
+    {
+        unsigned long long frames = 0;
+        double average_ms = 0;
+        double min_ms = 0;
+        double max_ms = 0;
+        double last_ms = 0;
+    };
+
     class sensor_interface : public virtual info_interface, public virtual options_interface
     {
     public:
@@ -114,6 +126,8 @@ namespace librealsense
 
         virtual const device_interface& get_device() = 0;
 
+        virtual latency_stats get_latency_stats(int stream_id) const = 0;
+
         virtual ~sensor_interface() = default;
     };
 
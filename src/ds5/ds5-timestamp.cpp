@@ -124,6 +124,8 @@ namespace librealsense
     rs2_time_t ds5_timestamp_reader::get_frame_timestamp(const request_mapping& mode, const platform::frame_object& fo)
     {
         std::lock_guard<std::recursive_mutex> lock(_mtx);
+        if (fo.backend_time)
+            return fo.backend_time;
         return _ts->get_time();
     }
 
@@ -139,7 +141,7 @@ namespace librealsense
 
     rs2_timestamp_domain ds5_timestamp_reader::get_frame_timestamp_domain(const request_mapping & mode, const platform::frame_object& fo) const
     {
-        return RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME;
+        return fo.backend_time ? RS2_TIMESTAMP_DOMAIN_BACKEND_TIME : RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME;
     }
 
     ds5_iio_hid_timestamp_reader::ds5_iio_hid_timestamp_reader()
@@ -4,6 +4,7 @@
 #pragma once
 #include "core/streaming.h"
 #include "types.h"
+#include "executor.h"
 #include <memory>
 #include <mutex>
 
@@ -69,6 +70,8 @@ namespace librealsense
         void set_time_service(std::shared_ptr<platform::time_service> ts);
         std::shared_ptr<platform::time_service> get_time_service();
 
+        executor& get_processing_executor() { return _executor; }
+
         environment(const environment&) = delete;
         environment(const environment&&) = delete;
         environment operator=(const environment&) = delete;
@@ -78,6 +81,7 @@ namespace librealsense
         extrinsics_graph _extrinsics;
         std::atomic<int> _stream_id;
         std::shared_ptr<platform::time_service> _ts;
+        executor _executor;
 
         environment(){_stream_id = 0;}
 
@@ -0,0 +1,370 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include "executor.h"
+#include "types.h"
+#include "thread-roles.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace librealsense
+{
+    // Identifies the executor and the worker index of the calling thread,
+    // so that tasks posted from a worker land on its own deque
+    static thread_local const executor* current_executor = nullptr;
+    static thread_local const void* current_set = nullptr;
+    static thread_local size_t current_worker = 0;
+
+    const int SERIAL_EXECUTOR_BATCH = 16;
+
+#if defined(__linux__) && !defined(ANDROID)
+    // Affinity of the process when the library was loaded, before any thread was pinned
+    static cpu_set_t get_process_affinity()
+    {
+        cpu_set_t cpus;
+        if (sched_getaffinity(0, sizeof(cpus), &cpus))
+        {
+            CPU_ZERO(&cpus);
+            for (int cpu = 0; cpu < CPU_SETSIZE; cpu++)
+                CPU_SET(cpu, &cpus);
+        }
+        return cpus;
+    }
+    static const cpu_set_t process_affinity = get_process_affinity();
+#endif
+
+    void set_current_thread_affinity(unsigned long long cpu_affinity_mask)
+    {
+        // Threads inherit the affinity of the thread creating them, which may well be a pinned library thread,
+        // so no mask explicitly restores the affinity of the process
+#ifdef _WIN32
+        if (!cpu_affinity_mask)
+        {
+            DWORD_PTR process_mask, system_mask;
+            if (GetProcessAffinityMask(GetCurrentProcess(), &process_mask, &system_mask))
+                cpu_affinity_mask = process_mask;
+        }
+        if (cpu_affinity_mask && !SetThreadAffinityMask(GetCurrentThread(), static_cast<DWORD_PTR>(cpu_affinity_mask)))
+            LOG_WARNING("Could not set thread affinity mask " << std::hex << cpu_affinity_mask);
+#elif defined(__linux__) && !defined(ANDROID)
+        cpu_set_t cpus = process_affinity;
+        if (cpu_affinity_mask)
+        {
+            CPU_ZERO(&cpus);
+            for (int cpu = 0; cpu < 64; cpu++)
+            {
+                if (cpu_affinity_mask & (1ULL << cpu))
+                    CPU_SET(cpu, &cpus);
+            }
+        }
+        if (pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus))
+            LOG_WARNING("Could not set thread affinity mask " << std::hex << cpu_affinity_mask);
+#else
+        if (cpu_affinity_mask)
+            LOG_WARNING("Thread affinity is not supported on this platform");
+#endif
+    }
+
+    static size_t resolve_worker_count(size_t worker_count)
+    {
+        return worker_count ? worker_count : std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    executor::worker_set::worker_set(const executor* owner, size_t worker_count, unsigned long long cpu_affinity_mask)
+        : owner(owner),
+          worker_count(worker_count),
+          cpu_affinity_mask(cpu_affinity_mask),
+          started(false),
+          stopped(false),
+          pending(0),
+          stopping(false)
+    {
+        for (size_t i = 0; i < worker_count; i++)
+            queues.emplace_back(new worker_queue());
+    }
+
+    void executor::worker_set::start()
+    {
+        std::lock_guard<std::mutex> lock(control_mutex);
+        if (started || stopped) return;
+
+        // Marked first, the new workers post too and must not try to start the set again
+        started = true;
+        for (size_t i = 0; i < worker_count; i++)
+            workers.push_back(std::thread([this, i]() { worker_loop(this, i); }));
+    }
+
+    void executor::worker_set::stop()
+    {
+        std::vector<std::thread> joined;
+        {
+            std::lock_guard<std::mutex> lock(control_mutex);
+            stopped = true;
+            joined.swap(workers);
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            stopping = true;
+        }
+        sleep_cv.notify_all();
+
+        for (auto&& t : joined)
+            t.join();
+    }
+
+    void executor::worker_set::push(size_t index, task t)
+    {
+        {
+            auto& q = *queues[index % queues.size()];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            q.tasks.push_back(std::move(t));
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex);
+            pending.fetch_add(1);
+        }
+        sleep_cv.notify_one();
+    }
+
+    executor::executor(size_t worker_count, unsigned long long cpu_affinity_mask)
+        : _set(std::make_shared<worker_set>(this, resolve_worker_count(worker_count), cpu_affinity_mask)),
+          _next_queue(0)
+    {
+    }
+
+    executor::~executor()
+    {
+        std::lock_guard<std::mutex> lock(_config_mutex);
+        std::atomic_load(&_set)->stop();
+    }
+
+    void executor::post(task t)
+    {
+        while (true)
+        {
+            auto set = std::atomic_load(&_set);
+
+            // Threads are spawned lazily, so that a library that never
+            // runs asynchronous work does not pay for idle workers
+            if (!set->started) set->start();
+
+            auto index = (current_executor == this && current_set == set.get()) ? current_worker
+                                                                                : _next_queue.fetch_add(1) % set->queues.size();
+            auto& q = *set->queues[index];
+            {
+                std::lock_guard<std::mutex> lock(q.mutex);
+
+                // The set was replaced after it was loaded, post to the new one instead
+                if (q.retired) continue;
+                q.tasks.push_back(std::move(t));
+            }
+
+            {
+                std::lock_guard<std::mutex> lock(set->sleep_mutex);
+                set->pending.fetch_add(1);
+            }
+            set->sleep_cv.notify_one();
+            return;
+        }
+    }
+
+    void executor::configure(size_t worker_count, unsigned long long cpu_affinity_mask)
+    {
+        if (current_executor == this)
+            throw wrong_api_call_sequence_exception("Processing executor can not be configured from one of its own tasks!");
+
+        std::lock_guard<std::mutex> lock(_config_mutex);
+        auto old_set = std::atomic_load(&_set);
+        auto new_set = std::make_shared<worker_set>(this, resolve_worker_count(worker_count), cpu_affinity_mask);
+        std::atomic_store(&_set, new_set);
+
+        // Tasks running on the old workers may post (and so reach the new set) while they are joined
+        old_set->stop();
+        retire(*old_set);
+
+        if (old_set->started)
+            new_set->start();
+    }
+
+    void executor::retire(worker_set& set)
+    {
+        // Whatever the old workers did not run yet, including tasks posted while they stopped, moves to the current set
+        auto current = std::atomic_load(&_set);
+        size_t index = 0;
+        for (auto&& q : set.queues)
+        {
+            std::deque<task> leftovers;
+            {
+                std::lock_guard<std::mutex> lock(q->mutex);
+                q->retired = true;
+                leftovers.swap(q->tasks);
+            }
+            for (auto&& t : leftovers)
+                current->push(index++, std::move(t));
+        }
+        if (index) current->start();
+    }
+
+    size_t executor::get_worker_count() const
+    {
+        return std::atomic_load(&_set)->worker_count;
+    }
+
+    unsigned long long executor::get_cpu_affinity_mask() const
+    {
+        return std::atomic_load(&_set)->cpu_affinity_mask;
+    }
+
+    bool executor::try_pop(worker_set* set, size_t index, task* t)
+    {
+        auto& queues = set->queues;
+        {
+            auto& own = *queues[index];
+            std::lock_guard<std::mutex> lock(own.mutex);
+            if (own.tasks.size())
+            {
+                *t = std::move(own.tasks.back());
+                own.tasks.pop_back();
+                return true;
+            }
+        }
+
+        for (size_t i = 1; i < queues.size(); i++)
+        {
+            auto& victim = *queues[(index + i) % queues.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (victim.tasks.size())
+            {
+                *t = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void executor::worker_loop(worker_set* set, size_t index)
+    {
+        current_executor = set->owner;
+        current_set = set;
+        current_worker = index;
+        // An affinity given to the executor itself takes precedence over the one of the role
+        apply_thread_role(RS2_THREAD_ROLE_PROCESSING);
+        if (set->cpu_affinity_mask)
+            set_current_thread_affinity(set->cpu_affinity_mask);
+
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(set->sleep_mutex);
+                set->sleep_cv.wait(lock, [set]() { return set->pending > 0 || set->stopping; });
+                if (set->stopping) break;
+                // Claiming a task before popping it guarantees one is available,
+                // since tasks are pushed before they are counted
+                set->pending.fetch_sub(1);
+            }
+
+            task t;
+            while (!try_pop(set, index, &t))
+                std::this_thread::yield();
+
+            try
+            {
+                t();
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR("Exception was thrown by an executor task: " << ex.what());
+            }
+            catch (...)
+            {
+                LOG_ERROR("Unknown exception was thrown by an executor task!");
+            }
+        }
+
+        current_executor = nullptr;
+        current_set = nullptr;
+    }
+
+    serial_executor::serial_executor(executor& owner)
+        : _owner(owner)
+    {
+    }
+
+    void serial_executor::post(executor::task t)
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_stopped) return;
+
+        _tasks.push_back(std::move(t));
+        if (_scheduled) return;
+        _scheduled = true;
+        lock.unlock();
+
+        auto self = shared_from_this();
+        _owner.post([self]() { self->drain(); });
+    }
+
+    void serial_executor::drain()
+    {
+        for (auto i = 0; i < SERIAL_EXECUTOR_BATCH; i++)
+        {
+            executor::task t;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_stopped || _tasks.empty())
+                {
+                    _scheduled = false;
+                    _running_thread = std::thread::id();
+                    _idle_cv.notify_all();
+                    return;
+                }
+                t = std::move(_tasks.front());
+                _tasks.pop_front();
+                _running_thread = std::this_thread::get_id();
+            }
+            try
+            {
+                t();
+            }
+            catch (...)
+            {
+                LOG_ERROR("Exception was thrown by a serial executor task!");
+            }
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _running_thread = std::thread::id();
+        }
+
+        // Yield the worker to other serial executors and continue later
+        auto self = shared_from_this();
+        _owner.post([self]() { self->drain(); });
+    }
+
+    void serial_executor::flush()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        if (_running_thread == std::this_thread::get_id()) return;
+        _idle_cv.wait(lock, [this]() { return !_scheduled; });
+    }
+
+    void serial_executor::stop()
+    {
+        std::unique_lock<std::mutex> lock(_mutex);
+        _stopped = true;
+        _tasks.clear();
+
+        // Stopping from within one of our own tasks must not wait for itself
+        if (_running_thread == std::this_thread::get_id()) return;
+        _idle_cv.wait(lock, [this]() { return !_scheduled; });
+    }
+}
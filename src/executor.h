@@ -0,0 +1,117 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include <thread>
+#include <atomic>
+#include <functional>
+#include <memory>
+
+#include "concurrency.h"
+
+namespace librealsense
+{
+    // Work-stealing thread pool shared by the library for asynchronous work
+    // Every worker owns a task deque: it pops its own work from the back and
+    // steals from the front of its siblings' deques when it runs dry
+    // Tasks are independent - ordering between them is provided by serial_executor
+    class executor
+    {
+    public:
+        // Tasks are move-only and stored inline, so posting a task does not allocate
+        typedef inplace_function<void()> task;
+
+        // worker_count of 0 selects std::thread::hardware_concurrency()
+        // cpu_affinity_mask of 0 applies the affinity of the processing thread role
+        explicit executor(size_t worker_count = 0, unsigned long long cpu_affinity_mask = 0);
+        ~executor();
+
+        void post(task t);
+
+        // Re-creates the workers, tasks that did not start yet are kept
+        // Tasks may keep posting while the old workers finish, only configure itself waits for them
+        void configure(size_t worker_count, unsigned long long cpu_affinity_mask);
+
+        size_t get_worker_count() const;
+        unsigned long long get_cpu_affinity_mask() const;
+
+        executor(const executor&) = delete;
+        executor& operator=(const executor&) = delete;
+
+    private:
+        struct worker_queue
+        {
+            std::mutex mutex;
+            std::deque<task> tasks;
+            bool retired = false; // The tasks were moved to a newer set of workers
+        };
+
+        // The workers of one configuration, replaced as a whole by configure
+        // Posting only locks the deque it pushes to, never the configuration
+        struct worker_set
+        {
+            worker_set(const executor* owner, size_t worker_count, unsigned long long cpu_affinity_mask);
+
+            void start();
+            void stop();
+            void push(size_t index, task t);
+
+            const executor* const owner;
+            const size_t worker_count;
+            const unsigned long long cpu_affinity_mask;
+            std::vector<std::unique_ptr<worker_queue>> queues;
+
+            std::mutex control_mutex;
+            std::vector<std::thread> workers;
+            std::atomic<bool> started;
+            bool stopped;
+
+            std::mutex sleep_mutex;
+            std::condition_variable sleep_cv;
+            std::atomic<int> pending;
+            std::atomic<bool> stopping;
+        };
+
+        static void worker_loop(worker_set* set, size_t index);
+        static bool try_pop(worker_set* set, size_t index, task* t);
+        void retire(worker_set& set);
+
+        std::mutex _config_mutex; // Serializes configure and destruction
+        std::shared_ptr<worker_set> _set; // Accessed with std::atomic_load / std::atomic_store
+        std::atomic<size_t> _next_queue;
+    };
+
+    // Runs the tasks posted to it one at a time and in posting order,
+    // on the threads of the shared executor
+    class serial_executor : public std::enable_shared_from_this<serial_executor>
+    {
+    public:
+        explicit serial_executor(executor& owner);
+
+        void post(executor::task t);
+
+        // Waits for the tasks posted so far to run, returns at once when called from one of them
+        void flush();
+
+        // Drops the tasks that did not start yet and waits for the running one
+        void stop();
+
+    private:
+        void drain();
+
+        executor& _owner;
+        std::mutex _mutex;
+        std::condition_variable _idle_cv;
+        std::deque<executor::task> _tasks;
+        std::thread::id _running_thread;
+        bool _scheduled = false;
+        bool _stopped = false;
+    };
+
+    void set_current_thread_affinity(unsigned long long cpu_affinity_mask);
+}
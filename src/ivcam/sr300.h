@@ -50,6 +50,9 @@ namespace librealsense
         double get_frame_timestamp(const request_mapping& /*mode*/, const platform::frame_object& fo) override
         {
             std::lock_guard<std::recursive_mutex> lock(_mtx);
+            if (uses_backend_time(fo))
+                return fo.backend_time;
+
             // Timestamps are encoded within the first 32 bits of the image and provided in 10nsec units
             uint32_t rolling_timestamp = *reinterpret_cast<const uint32_t *>(fo.pixels);
             if (!started)
@@ -76,9 +79,18 @@ namespace librealsense
         {
             if(fo.metadata_size >= platform::uvc_header_size )
                 return RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK;
+            else if (uses_backend_time(fo))
+                return RS2_TIMESTAMP_DOMAIN_BACKEND_TIME;
             else
                 return RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME;
         }
+
+    private:
+        // Without metadata, prefer the completion time the kernel stamped on the buffer
+        static bool uses_backend_time(const platform::frame_object& fo)
+        {
+            return fo.metadata_size < platform::uvc_header_size && fo.backend_time;
+        }
     };
 
     class sr300_timestamp_reader_from_metadata : public frame_timestamp_reader
@@ -260,10 +260,16 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this, read_device_path_str](){
+                apply_thread_role(RS2_THREAD_ROLE_MOTION_CAPTURE);
                 static const uint32_t buf_len = 128;
                 const uint32_t channel_size = 24; // TODO: why 24?
                 std::vector<uint8_t> raw_data(channel_size * buf_len);
 
+                // All the samples of a read are handed over at once
+                sensor_data sens_data{};
+                sens_data.sensor = hid_sensor{get_sensor_name()};
+                sens_data.sample_stride = channel_size;
+
                 do {
                     fd_set fds;
                     FD_ZERO(&fds);
@@ -302,17 +308,12 @@ namespace librealsense
                             continue;
                         }
 
-                        for (auto i = 0; i < read_size / channel_size; ++i)
-                        {
-                            auto p_raw_data = raw_data.data() + channel_size * i;
-
-                            // TODO: code refactoring to reduce latency
-                            sensor_data sens_data{};
-                            sens_data.sensor = hid_sensor{get_sensor_name()};
+                        sens_data.sample_count = static_cast<uint32_t>(read_size / channel_size);
+                        if (!sens_data.sample_count)
+                            continue;
 
-                            sens_data.fo = {channel_size, channel_size, p_raw_data, p_raw_data};
-                            this->_callback(sens_data);
-                        }
+                        sens_data.fo = {channel_size, channel_size, raw_data.data(), raw_data.data()};
+                        this->_callback(sens_data);
                     }
                     else
                     {
@@ -509,12 +510,19 @@ namespace librealsense
             _callback = sensor_callback;
             _is_capturing = true;
             _hid_thread = std::unique_ptr<std::thread>(new std::thread([this](){
+                apply_thread_role(RS2_THREAD_ROLE_MOTION_CAPTURE);
                 const uint32_t channel_size = get_channel_size();
                 auto raw_data_size = channel_size*buf_len;
 
                 std::vector<uint8_t> raw_data(raw_data_size);
                 auto metadata = has_metadata();
 
+                // All the samples of a read are handed over at once
+                auto hid_data_size = channel_size - HID_METADATA_SIZE;
+                sensor_data sens_data{};
+                sens_data.sensor = hid_sensor{get_sensor_name()};
+                sens_data.sample_stride = channel_size;
+
                 do {
                     fd_set fds;
                     FD_ZERO(&fds);
@@ -553,19 +561,14 @@ namespace librealsense
                             continue;
                         }
 
-                        // TODO: code refactoring to reduce latency
-                        for (auto i = 0; i < read_size / channel_size; ++i)
-                        {
-                            auto p_raw_data = raw_data.data() + channel_size * i;
-                            sensor_data sens_data{};
-                            sens_data.sensor = hid_sensor{get_sensor_name()};
-
-                            auto hid_data_size = channel_size - HID_METADATA_SIZE;
+                        sens_data.sample_count = read_size / channel_size;
+                        if (!sens_data.sample_count)
+                            continue;
 
-                            sens_data.fo = {hid_data_size, metadata?HID_METADATA_SIZE: uint8_t(0),  p_raw_data,  metadata?p_raw_data + hid_data_size:nullptr};
+                        auto p_raw_data = raw_data.data();
+                        sens_data.fo = {hid_data_size, metadata?HID_METADATA_SIZE: uint8_t(0),  p_raw_data,  metadata?p_raw_data + hid_data_size:nullptr};
 
-                            this->_callback(sens_data);
-                        }
+                        this->_callback(sens_data);
                     }
                     else
                     {
@@ -42,6 +42,11 @@
 #include <list>
 
 #include <sys/signalfd.h>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/socket.h>
+#include <linux/netlink.h>
+#include <poll.h>
 #include <signal.h>
 
 
@@ -49,6 +54,13 @@
 
 const size_t MAX_DEV_PARENT_DIR = 10;
 
+const int REACTOR_MAX_EVENTS = 16;
+const int REACTOR_TIMEOUT_CHECK_INTERVAL_MS = 1000;
+const int REACTOR_FRAMES_TIMEOUT_MS = 5000;
+// Plugging a camera raises a burst of uevents, devices are enumerated once it is over
+const int UEVENT_SETTLE_MS = 50;
+const size_t UEVENT_BUFFER_SIZE = 8192;
+
 
 #ifdef ANDROID
 
@@ -224,8 +236,28 @@ namespace librealsense
                 throw linux_backend_exception("xioctl(VIDIOC_QBUF) failed");
         }
 
+        void buffer::export_dmabuf(int fd, uint32_t stride)
+        {
+            v4l2_exportbuffer expbuf = {};
+            expbuf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            expbuf.index = _index;
+            expbuf.flags = O_RDONLY | O_CLOEXEC;
+            if (xioctl(fd, VIDIOC_EXPBUF, &expbuf) < 0)
+            {
+                LOG_WARNING("xioctl(VIDIOC_EXPBUF) failed, frames of buffer " << _index << " will not be shared as dma-buf! Last-error: " << strerror(errno));
+                return;
+            }
+
+            _dmabuf.fd = expbuf.fd;
+            _dmabuf.offset = 0;
+            _dmabuf.stride = stride;
+        }
+
         buffer::~buffer()
         {
+            if (_dmabuf.fd >= 0)
+                ::close(_dmabuf.fd);
+
             if (_use_memory_map)
             {
                if(munmap(_start, _length) < 0)
@@ -250,6 +282,24 @@ namespace librealsense
             _must_enqueue = false;
         }
 
+        bool buffer::is_attached()
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            return _must_enqueue;
+        }
+
+        bool v4l_sequence_tracker::on_frame(uint32_t sequence)
+        {
+            // The driver counts every frame it receives, including those it had no free buffer for,
+            // frames lost on the USB link also leave a gap
+            auto gap = sequence - _last_sequence;
+            auto lost = _has_sequence && gap > 1 && gap < 0x80000000u;
+            if (lost) _dropped_frames += gap - 1;
+            _last_sequence = sequence;
+            _has_sequence = true;
+            return lost && _starved;
+        }
+
         void buffer::request_next_frame(int fd)
         {
             std::lock_guard<std::mutex> lock(_mutex);
@@ -269,6 +319,193 @@ namespace librealsense
             }
         }
 
+        std::shared_ptr<v4l_capture_reactor> v4l_capture_reactor::get_shared()
+        {
+            static std::mutex mutex;
+            static std::weak_ptr<v4l_capture_reactor> shared;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto reactor = shared.lock();
+            if (!reactor)
+            {
+                size_t thread_count = 1;
+                static const char* threads_var_name = "LRS_V4L2_REACTOR_THREADS";
+                auto content = getenv(threads_var_name);
+                if (content && atoi(content) > 0)
+                    thread_count = static_cast<size_t>(atoi(content));
+
+                reactor = std::make_shared<v4l_capture_reactor>(thread_count);
+                shared = reactor;
+            }
+            return reactor;
+        }
+
+        v4l_capture_reactor::v4l_capture_reactor(size_t thread_count)
+            : _next_id(STOP_ID + 1)
+        {
+            _epoll_fd = epoll_create1(EPOLL_CLOEXEC);
+            if (_epoll_fd < 0)
+                throw linux_backend_exception("v4l_capture_reactor: Cannot create epoll instance!");
+
+            _stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_stop_fd < 0)
+            {
+                ::close(_epoll_fd);
+                throw linux_backend_exception("v4l_capture_reactor: Cannot create eventfd!");
+            }
+
+            // The stop event is level-triggered and never consumed, so it wakes up every thread
+            epoll_event ev = {};
+            ev.events = EPOLLIN;
+            ev.data.u64 = STOP_ID;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, _stop_fd, &ev) < 0)
+            {
+                ::close(_stop_fd);
+                ::close(_epoll_fd);
+                throw linux_backend_exception("v4l_capture_reactor: Cannot watch eventfd!");
+            }
+
+            for (size_t i = 0; i < thread_count; i++)
+                _threads.push_back(std::thread([this]() { apply_thread_role(RS2_THREAD_ROLE_CAPTURE); run(); }));
+        }
+
+        v4l_capture_reactor::~v4l_capture_reactor()
+        {
+            uint64_t value = 1;
+            if (write(_stop_fd, &value, sizeof(value)) < 0)
+                LOG_ERROR("v4l_capture_reactor: Could not signal capture threads to stop");
+
+            for (auto&& t : _threads)
+                t.join();
+
+            ::close(_stop_fd);
+            ::close(_epoll_fd);
+        }
+
+        uint64_t v4l_capture_reactor::add(int fd, ready_handler on_ready, timeout_handler on_timeout)
+        {
+            auto r = std::make_shared<registration>();
+            r->fd = fd;
+            r->on_ready = on_ready;
+            r->on_timeout = on_timeout;
+            r->active = true;
+            r->last_ready = std::chrono::steady_clock::now();
+
+            uint64_t id;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                id = _next_id++;
+                _registrations[id] = r;
+            }
+
+            // One-shot, so that a device is handled by a single thread at a time and its frames stay in order
+            epoll_event ev = {};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.u64 = id;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_ADD, fd, &ev) < 0)
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _registrations.erase(id);
+                throw linux_backend_exception("v4l_capture_reactor: Cannot watch video device!");
+            }
+            return id;
+        }
+
+        void v4l_capture_reactor::remove(uint64_t id)
+        {
+            std::shared_ptr<registration> r;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _registrations.find(id);
+                if (it == _registrations.end()) return;
+                r = it->second;
+                _registrations.erase(it);
+            }
+
+            epoll_ctl(_epoll_fd, EPOLL_CTL_DEL, r->fd, nullptr);
+
+            // Wait for a handler that is already running, later events for the id are ignored
+            std::lock_guard<std::mutex> lock(r->mutex);
+            r->active = false;
+        }
+
+        void v4l_capture_reactor::run()
+        {
+            epoll_event events[REACTOR_MAX_EVENTS];
+            while (true)
+            {
+                auto count = epoll_wait(_epoll_fd, events, REACTOR_MAX_EVENTS, REACTOR_TIMEOUT_CHECK_INTERVAL_MS);
+                if (count < 0)
+                {
+                    if (errno == EINTR) continue;
+                    LOG_ERROR("v4l_capture_reactor: epoll_wait failed! Last-error: " << strerror(errno));
+                    return;
+                }
+
+                for (int i = 0; i < count; i++)
+                {
+                    if (events[i].data.u64 == STOP_ID) return;
+                    dispatch(events[i].data.u64);
+                }
+
+                check_timeouts();
+            }
+        }
+
+        void v4l_capture_reactor::dispatch(uint64_t id)
+        {
+            std::shared_ptr<registration> r;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                auto it = _registrations.find(id);
+                if (it == _registrations.end()) return;
+                r = it->second;
+            }
+
+            std::lock_guard<std::mutex> lock(r->mutex);
+            if (!r->active) return;
+
+            r->last_ready = std::chrono::steady_clock::now();
+            if (!r->on_ready())
+            {
+                r->active = false;
+                return;
+            }
+
+            epoll_event ev = {};
+            ev.events = EPOLLIN | EPOLLONESHOT;
+            ev.data.u64 = id;
+            if (epoll_ctl(_epoll_fd, EPOLL_CTL_MOD, r->fd, &ev) < 0)
+                LOG_ERROR("v4l_capture_reactor: Cannot re-arm video device! Last-error: " << strerror(errno));
+        }
+
+        void v4l_capture_reactor::check_timeouts()
+        {
+            // A single thread is enough to watch for silent devices
+            std::unique_lock<std::mutex> check_lock(_timeout_mutex, std::try_to_lock);
+            if (!check_lock.owns_lock()) return;
+
+            std::vector<std::shared_ptr<registration>> registrations;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                for (auto&& r : _registrations)
+                    registrations.push_back(r.second);
+            }
+
+            auto now = std::chrono::steady_clock::now();
+            for (auto&& r : registrations)
+            {
+                std::unique_lock<std::mutex> lock(r->mutex, std::try_to_lock);
+                if (!lock.owns_lock() || !r->active) continue;
+
+                if (now - r->last_ready > std::chrono::milliseconds(REACTOR_FRAMES_TIMEOUT_MS))
+                {
+                    r->last_ready = now;
+                    r->on_timeout();
+                }
+            }
+        }
+
         static std::string get_usb_port_id(libusb_device* usb_device)
         {
             auto usb_bus = std::to_string(libusb_get_bus_number(usb_device));
@@ -288,6 +525,177 @@ namespace librealsense
             return usb_bus + "-" + port_path.str() + "-" + usb_dev;
         }
 
+        bool v4l_uevent_device_watcher::is_relevant_uevent(const char* data, size_t size)
+        {
+            static const std::set<std::string> actions = { "add", "remove", "bind", "unbind" };
+            static const std::set<std::string> subsystems = { "usb", "video4linux", "iio", "hid" };
+
+            std::string action, subsystem;
+            for (size_t pos = 0; pos < size;)
+            {
+                std::string field(data + pos, strnlen(data + pos, size - pos));
+                pos += field.size() + 1;
+
+                if (field.compare(0, 7, "ACTION=") == 0) action = field.substr(7);
+                else if (field.compare(0, 10, "SUBSYSTEM=") == 0) subsystem = field.substr(10);
+            }
+            return actions.count(action) && subsystems.count(subsystem);
+        }
+
+        v4l_uevent_device_watcher::v4l_uevent_device_watcher(const backend* backend_ref)
+            : _backend(backend_ref), _socket_fd(-1), _stop_fd(-1)
+        {
+            _socket_fd = socket(AF_NETLINK, SOCK_RAW | SOCK_CLOEXEC | SOCK_NONBLOCK, NETLINK_KOBJECT_UEVENT);
+            if (_socket_fd < 0)
+                throw linux_backend_exception("Could not open the uevent netlink socket");
+
+            sockaddr_nl address = {};
+            address.nl_family = AF_NETLINK;
+            address.nl_groups = 1; // Kernel events, udev may not be running
+            if (bind(_socket_fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0)
+            {
+                ::close(_socket_fd);
+                throw linux_backend_exception("Could not bind the uevent netlink socket");
+            }
+
+            _stop_fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+            if (_stop_fd < 0)
+            {
+                ::close(_socket_fd);
+                throw linux_backend_exception("Could not create the device watcher stop event");
+            }
+        }
+
+        v4l_uevent_device_watcher::~v4l_uevent_device_watcher()
+        {
+            stop();
+            ::close(_stop_fd);
+            ::close(_socket_fd);
+        }
+
+        void v4l_uevent_device_watcher::start(device_changed_callback callback)
+        {
+            stop();
+            _callback = std::move(callback);
+
+            // Events raised before the initial enumeration are already reflected in it
+            read_events();
+            {
+                std::lock_guard<std::mutex> lock(_devices_mutex);
+                _devices_data = { _backend->query_uvc_devices(),
+                                  _backend->query_usb_devices(),
+                                  _backend->query_hid_devices() };
+            }
+
+            _thread = std::unique_ptr<std::thread>(new std::thread([this]() { apply_thread_role(RS2_THREAD_ROLE_DEVICE_WATCHER); watch_loop(); }));
+        }
+
+        void v4l_uevent_device_watcher::stop()
+        {
+            if (_thread)
+            {
+                uint64_t value = 1;
+                if (write(_stop_fd, &value, sizeof(value)) < 0)
+                    LOG_ERROR("Could not signal the device watcher to stop! Last-error: " << strerror(errno));
+                _thread->join();
+                _thread.reset();
+
+                if (read(_stop_fd, &value, sizeof(value)) < 0)
+                    LOG_DEBUG("Device watcher stop event was not set");
+            }
+
+            _callback_inflight.wait_until_empty();
+        }
+
+        backend_device_group v4l_uevent_device_watcher::get_devices() const
+        {
+            std::lock_guard<std::mutex> lock(_devices_mutex);
+            return _devices_data;
+        }
+
+        void v4l_uevent_device_watcher::watch_loop()
+        {
+            auto pending = false;
+            auto deadline = std::chrono::steady_clock::now();
+
+            while (true)
+            {
+                auto timeout = -1;
+                if (pending)
+                {
+                    auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(deadline - std::chrono::steady_clock::now());
+                    timeout = std::max(0, static_cast<int>(remaining.count()));
+                }
+
+                pollfd fds[2] = { { _socket_fd, POLLIN, 0 }, { _stop_fd, POLLIN, 0 } };
+                if (::poll(fds, 2, timeout) < 0)
+                {
+                    if (errno == EINTR) continue;
+                    LOG_ERROR("Device watcher stopped, poll failed! Last-error: " << strerror(errno));
+                    return;
+                }
+
+                if (fds[1].revents) return;
+
+                if ((fds[0].revents & POLLIN) && read_events())
+                {
+                    pending = true;
+                    deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(UEVENT_SETTLE_MS);
+                }
+
+                if (pending && std::chrono::steady_clock::now() >= deadline)
+                {
+                    pending = false;
+                    rescan();
+                }
+            }
+        }
+
+        bool v4l_uevent_device_watcher::read_events()
+        {
+            auto relevant = false;
+            std::vector<char> buffer(UEVENT_BUFFER_SIZE);
+            while (true)
+            {
+                sockaddr_nl sender = {};
+                socklen_t sender_size = sizeof(sender);
+                auto size = recvfrom(_socket_fd, buffer.data(), buffer.size(), 0,
+                                     reinterpret_cast<sockaddr*>(&sender), &sender_size);
+                if (size < 0)
+                {
+                    if (errno == EINTR) continue;
+                    // Events were lost, so any device may have changed
+                    if (errno == ENOBUFS) { relevant = true; continue; }
+                    break;
+                }
+
+                // Anyone may send to the group, only the kernel is trusted
+                if (sender.nl_pid != 0) continue;
+
+                if (is_relevant_uevent(buffer.data(), static_cast<size_t>(size)))
+                    relevant = true;
+            }
+            return relevant;
+        }
+
+        void v4l_uevent_device_watcher::rescan()
+        {
+            backend_device_group curr(_backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices());
+
+            if (list_changed(_devices_data.uvc_devices, curr.uvc_devices) ||
+                list_changed(_devices_data.usb_devices, curr.usb_devices) ||
+                list_changed(_devices_data.hid_devices, curr.hid_devices))
+            {
+                callback_invocation_holder callback = { _callback_inflight.allocate(), &_callback_inflight };
+                if (callback)
+                {
+                    _callback(_devices_data, curr);
+                    std::lock_guard<std::mutex> lock(_devices_mutex);
+                    _devices_data = curr;
+                }
+            }
+        }
+
         v4l_usb_device::v4l_usb_device(const usb_device_info& info)
         {
             int status = libusb_init(&_usb_context);
@@ -494,7 +902,10 @@ namespace librealsense
               _thread(nullptr),
               _use_memory_map(use_memory_map),
               _is_started(false),
-              _stop_pipe_fd{}
+              _stop_pipe_fd{},
+              _default_memory_map(use_memory_map),
+              _export_dmabuf(false),
+              _adaptive_buffers(false)
         {
             foreach_uvc_device([&info, this](const uvc_device_info& i, const std::string& name)
             {
@@ -514,6 +925,7 @@ namespace librealsense
         v4l_uvc_device::~v4l_uvc_device()
         {
             _is_capturing = false;
+            if (_reactor) _reactor->remove(_reactor_id);
             if (_thread) _thread->join();
         }
 
@@ -521,6 +933,22 @@ namespace librealsense
         {
             if(!_is_capturing && !_callback)
             {
+                if (_has_warm_buffers)
+                {
+                    // Buffers still referenced by frames of the last session can not be queued again
+                    auto in_use = std::any_of(_buffers.begin(), _buffers.end(),
+                        [](const std::shared_ptr<buffer>& buf) { return buf.use_count() > 1; });
+
+                    if (!in_use && profile == _profile && buffers == _requested_buffers &&
+                        _use_memory_map == (_default_memory_map || _export_dmabuf))
+                    {
+                        _has_warm_buffers = false;
+                        _callback = callback;
+                        return;
+                    }
+                    release_buffers();
+                }
+
                 v4l2_fmtdesc pixel_format = {};
                 pixel_format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
                 while (ioctl(_fd, VIDIOC_ENUM_FMT, &pixel_format) == 0)
@@ -582,6 +1010,7 @@ namespace librealsense
                 }
 
                 LOG_INFO("Trying to configure fourcc " << fourcc_to_string(fmt.fmt.pix.pixelformat));
+                _bytes_per_line = fmt.fmt.pix.bytesperline;
 
                 v4l2_streamparm parm = {};
                 parm.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -593,6 +1022,9 @@ namespace librealsense
                 if(xioctl(_fd, VIDIOC_S_PARM, &parm) < 0)
                     throw linux_backend_exception("xioctl(VIDIOC_S_PARM) failed");
 
+                // Only kernel-allocated buffers can be exported, at the cost of the metadata appended to user buffers
+                _use_memory_map = _default_memory_map || _export_dmabuf;
+
                 // Init memory mapped IO
                 v4l2_requestbuffers req = {};
                 req.count = buffers;
@@ -606,13 +1038,18 @@ namespace librealsense
                         throw linux_backend_exception("xioctl(VIDIOC_REQBUFS) failed");
                 }
 
-                for(size_t i = 0; i < buffers; ++i)
+                // The driver may adjust the requested count to what it can provide
+                if (req.count != static_cast<uint32_t>(buffers))
+                    LOG_INFO(_name << " allocated " << req.count << " frame buffers out of " << buffers << " requested");
+
+                for(size_t i = 0; i < req.count; ++i)
                 {
-                    _buffers.push_back(std::make_shared<buffer>(_fd, _use_memory_map, i));
+                    _buffers.push_back(allocate_buffer(i));
                 }
 
                 _profile =  profile;
                 _callback = callback;
+                _requested_buffers = buffers;
             }
             else
             {
@@ -628,13 +1065,19 @@ namespace librealsense
 
                 // Start capturing
                 for (auto&& buf : _buffers) buf->prepare_for_streaming(_fd);
+                _sequence.restart();
 
                 v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
                 if(xioctl(_fd, VIDIOC_STREAMON, &type) < 0)
                     throw linux_backend_exception("xioctl(VIDIOC_STREAMON) failed");
 
                 _is_capturing = true;
-                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ capture_loop(); }));
+#ifdef V4L2_CAPTURE_REACTOR
+                _reactor = v4l_capture_reactor::get_shared();
+                _reactor_id = _reactor->add(_fd, [this]() { return drain(); }, [this]() { notify_frames_timeout(); });
+#else
+                _thread = std::unique_ptr<std::thread>(new std::thread([this](){ apply_thread_role(RS2_THREAD_ROLE_CAPTURE); capture_loop(); }));
+#endif
             }
         }
 
@@ -654,11 +1097,15 @@ namespace librealsense
             {
                 _is_capturing = false;
                 _is_started = false;
+#ifdef V4L2_CAPTURE_REACTOR
+                _reactor->remove(_reactor_id);
+                _reactor.reset();
+#else
                 signal_stop();
 
                 _thread->join();
                 _thread.reset();
-
+#endif
 
                 // Stop streamining
                 v4l2_buf_type type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
@@ -672,25 +1119,42 @@ namespace librealsense
                 {
                     _buffers[i]->detach_buffer();
                 }
-                _buffers.resize(0);
+                _callback = nullptr;
 
-                // Close memory mapped IO
-                struct v4l2_requestbuffers req = {};
-                req.count = 0;
-                req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                req.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-                if(xioctl(_fd, VIDIOC_REQBUFS, &req) < 0)
-                {
-                    if(errno == EINVAL)
-                        LOG_ERROR(_name + " does not support memory mapping");
-                    else
-                        throw linux_backend_exception("xioctl(VIDIOC_REQBUFS) failed");
-                }
+                // STREAMOFF returned all buffers to user space, so they are ready to be queued again as they are
+                if (_warm_restart)
+                    _has_warm_buffers = true;
+                else
+                    release_buffers();
+            }
+        }
 
-                _callback = nullptr;
+        void v4l_uvc_device::release_buffers()
+        {
+            _buffers.resize(0);
+            _has_warm_buffers = false;
+
+            // Close memory mapped IO
+            struct v4l2_requestbuffers req = {};
+            req.count = 0;
+            req.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            req.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+            if(xioctl(_fd, VIDIOC_REQBUFS, &req) < 0)
+            {
+                if(errno == EINVAL)
+                    LOG_ERROR(_name + " does not support memory mapping");
+                else
+                    throw linux_backend_exception("xioctl(VIDIOC_REQBUFS) failed");
             }
         }
 
+        void v4l_uvc_device::enable_warm_restart(bool enable)
+        {
+            _warm_restart = enable;
+            if (!enable && _has_warm_buffers)
+                release_buffers();
+        }
+
         std::string v4l_uvc_device::fourcc_to_string(uint32_t id) const
         {
             uint32_t device_fourcc = id;
@@ -750,83 +1214,182 @@ namespace librealsense
                 }
                 else if(FD_ISSET(_fd, &fds))
                 {
-                    FD_ZERO(&fds);
-                    FD_SET(_fd, &fds);
-                    v4l2_buffer buf = {};
-                    buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
-                    buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
-                    if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
-                    {
-                        if(errno == EAGAIN)
-                            return;
+                    // Hand over every buffer that is already filled, not just the one that woke us up
+                    while (_is_capturing && dequeue_frame()) {}
+                }
+                else
+                {
+                    throw linux_backend_exception("FD_ISSET returned false");
+                }
+            }
+            else
+            {
+                notify_frames_timeout();
+            }
+        }
 
-                        throw linux_backend_exception("xioctl(VIDIOC_DQBUF) failed");
-                    }
+        void v4l_uvc_device::notify_frames_timeout()
+        {
+            LOG_WARNING("Frames didn't arrived within 5 seconds");
+            librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
 
-                    bool moved_qbuff = false;
-                    auto buffer = _buffers[buf.index];
+            _error_handler(n);
+        }
 
-                    if (_is_started)
-                    {
-                        if((buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE) &&
-                                buf.bytesused > 0)
-                        {
-                            auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
-                            std::stringstream s;
-                            s << "Incomplete frame detected!\nSize " << buf.bytesused
-                              << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
-                            librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
+        bool v4l_uvc_device::drain()
+        {
+            try
+            {
+                while (_is_capturing && dequeue_frame()) {}
+                return _is_capturing;
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_ERROR(ex.what());
 
-                            _error_handler(n);
-                        }
-                        else
-                        {
-                            void* md_start = nullptr;
-                            uint8_t md_size = 0;
-                            if (has_metadata())
-                            {
-                                md_start = buffer->get_frame_start() + buffer->get_length_frame_only();
-                                md_size = (*(uint8_t*)md_start);
-                            }
+                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, ex.what()};
 
-                            frame_object fo{ buffer->get_length_frame_only(), md_size,
-                                buffer->get_frame_start(), md_start };
-
-                             if (buf.bytesused > 0)
-                             {
-                                 buffer->attach_buffer(buf);
-                                 moved_qbuff = true;
-                                 auto fd = _fd;
-                                 _callback(_profile, fo,
-                                           [fd, buffer]() mutable {
-                                     buffer->request_next_frame(fd);
-                                 });
-                             }
-                             else
-                             {
-                                 LOG_WARNING("Empty frame has arrived.");
-                             }
-                        }
-                    }
+                _error_handler(n);
+                return false;
+            }
+        }
 
-                    if (!moved_qbuff)
-                    {
-                        if (xioctl(_fd, VIDIOC_QBUF, &buf) < 0)
-                            throw linux_backend_exception("xioctl(VIDIOC_QBUF) failed");
-                    }
+        // Converts the time the driver completed the buffer at to the system clock used for frame arrival times
+        // The offset between the clocks is sampled per frame, so adjustments of the system clock are followed
+        static double buffer_time_to_system_time(const v4l2_buffer& buf)
+        {
+            if ((buf.flags & V4L2_BUF_FLAG_TIMESTAMP_MASK) != V4L2_BUF_FLAG_TIMESTAMP_MONOTONIC)
+                return 0;
+            if (!buf.timestamp.tv_sec && !buf.timestamp.tv_usec)
+                return 0;
+
+            timespec now = {};
+            if (clock_gettime(CLOCK_MONOTONIC, &now) < 0)
+                return 0;
+            auto system_now = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
+
+            auto age = (now.tv_sec - buf.timestamp.tv_sec) * 1000. + (now.tv_nsec / 1000 - buf.timestamp.tv_usec) / 1000.;
+            return system_now - age;
+        }
+
+        bool v4l_uvc_device::dequeue_frame()
+        {
+            v4l2_buffer buf = {};
+            buf.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            buf.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+            if(xioctl(_fd, VIDIOC_DQBUF, &buf) < 0)
+            {
+                if(errno == EAGAIN)
+                    return false;
+
+                throw linux_backend_exception("xioctl(VIDIOC_DQBUF) failed");
+            }
+
+            if (_sequence.on_frame(buf.sequence) && _adaptive_buffers)
+                grow_buffers();
+
+            bool moved_qbuff = false;
+            auto buffer = _buffers[buf.index];
+
+            if (_is_started)
+            {
+                if((buf.bytesused < buffer->get_full_length() - MAX_META_DATA_SIZE) &&
+                        buf.bytesused > 0)
+                {
+                    auto percentage = (100 * buf.bytesused) / buffer->get_full_length();
+                    std::stringstream s;
+                    s << "Incomplete frame detected!\nSize " << buf.bytesused
+                      << " out of " << buffer->get_full_length() << " bytes (" << percentage << "%)";
+                    librealsense::notification n = { RS2_NOTIFICATION_CATEGORY_FRAME_CORRUPTED, 0, RS2_LOG_SEVERITY_WARN, s.str()};
+
+                    _error_handler(n);
                 }
                 else
                 {
-                    throw linux_backend_exception("FD_ISSET returned false");
+                    void* md_start = nullptr;
+                    uint8_t md_size = 0;
+                    if (has_metadata())
+                    {
+                        md_start = buffer->get_frame_start() + buffer->get_length_frame_only();
+                        md_size = (*(uint8_t*)md_start);
+                    }
+
+                    frame_object fo{ buffer->get_length_frame_only(), md_size,
+                        buffer->get_frame_start(), md_start, buffer->get_dmabuf(),
+                        buffer_time_to_system_time(buf) };
+
+                     if (buf.bytesused > 0)
+                     {
+                         buffer->attach_buffer(buf);
+                         moved_qbuff = true;
+                         auto fd = _fd;
+                         _callback(_profile, fo,
+                                   [fd, buffer]() mutable {
+                             buffer->request_next_frame(fd);
+                         });
+                     }
+                     else
+                     {
+                         LOG_WARNING("Empty frame has arrived.");
+                     }
                 }
             }
-            else
+
+            if (!moved_qbuff)
             {
-                LOG_WARNING("Frames didn't arrived within 5 seconds");
-                librealsense::notification n = {RS2_NOTIFICATION_CATEGORY_FRAMES_TIMEOUT, 0, RS2_LOG_SEVERITY_WARN,  "Frames didn't arrived within 5 seconds"};
+                if (xioctl(_fd, VIDIOC_QBUF, &buf) < 0)
+                    throw linux_backend_exception("xioctl(VIDIOC_QBUF) failed");
+            }
 
-                _error_handler(n);
+            // Buffers only return to the driver until the next one completes, so it has the fewest queued now
+            if (_adaptive_buffers)
+            {
+                auto queued = std::count_if(_buffers.begin(), _buffers.end(), [](const std::shared_ptr<platform::buffer>& b) { return !b->is_attached(); });
+                _sequence.on_buffers_queued(queued);
+            }
+
+            return true;
+        }
+
+        std::shared_ptr<buffer> v4l_uvc_device::allocate_buffer(int index)
+        {
+            auto buf = std::make_shared<buffer>(_fd, _use_memory_map, index);
+            if (_export_dmabuf && _use_memory_map)
+                buf->export_dmabuf(_fd, _bytes_per_line);
+            return buf;
+        }
+
+        void v4l_uvc_device::grow_buffers()
+        {
+            // Runs on the capture thread, which is the only user of the buffer pool while streaming
+            if (_buffers.size() >= MAX_V4L2_FRAME_BUFFERS) return;
+
+            v4l2_create_buffers create = {};
+            create.count = 1;
+            create.memory = _use_memory_map ? V4L2_MEMORY_MMAP : V4L2_MEMORY_USERPTR;
+            create.format.type = V4L2_BUF_TYPE_VIDEO_CAPTURE;
+            if (xioctl(_fd, VIDIOC_G_FMT, &create.format) < 0 ||
+                xioctl(_fd, VIDIOC_CREATE_BUFS, &create) < 0)
+            {
+                LOG_WARNING(_name << " can not add frame buffers while streaming, adaptive buffering is disabled. Last-error: " << strerror(errno));
+                _adaptive_buffers = false;
+                return;
             }
+
+            if (create.index != _buffers.size())
+            {
+                LOG_WARNING(_name << " allocated frame buffer " << create.index << " out of order, adaptive buffering is disabled");
+                _adaptive_buffers = false;
+                return;
+            }
+
+            for (auto i = create.index; i < create.index + create.count; i++)
+            {
+                auto buf = allocate_buffer(i);
+                buf->prepare_for_streaming(_fd);
+                _buffers.push_back(buf);
+            }
+            LOG_INFO(_name << " grew to " << _buffers.size() << " frame buffers after dropping frames for lack of one");
         }
 
         void v4l_uvc_device::set_power_state(power_state state)
@@ -876,6 +1439,8 @@ namespace librealsense
             if (state == D3 && _state == D0)
             {
                 close(_profile);
+                if (_has_warm_buffers)
+                    release_buffers();
                 if(::close(_fd) < 0)
                     throw linux_backend_exception("v4l_uvc_device: close(_fd) failed");
 
@@ -1192,8 +1757,7 @@ namespace librealsense
 
         bool v4l_uvc_device::has_metadata()
         {
-           if(!_use_memory_map)
-               return true;
+           return !_use_memory_map;
         }
 
         std::shared_ptr<uvc_device> v4l_backend::create_uvc_device(uvc_device_info info) const
@@ -1255,7 +1819,15 @@ namespace librealsense
 
         std::shared_ptr<device_watcher> v4l_backend::create_device_watcher() const
         {
-            return std::make_shared<polling_device_watcher>(this);
+            try
+            {
+                return std::make_shared<v4l_uevent_device_watcher>(this);
+            }
+            catch (const std::exception& ex)
+            {
+                LOG_WARNING("Device events are not available, polling for devices instead. " << ex.what());
+                return std::make_shared<polling_device_watcher>(this);
+            }
         }
 
         std::shared_ptr<backend> create_backend()
@@ -38,6 +38,8 @@
 #include <fts.h>
 #include <regex>
 #include <list>
+#include <map>
+#include <mutex>
 
 #pragma GCC diagnostic ignored "-Wpedantic"
 #include <libusb.h>
@@ -92,11 +94,17 @@ namespace librealsense
 
             void request_next_frame(int fd);
 
+            // Attached buffers are held by frames until they request the next one, the others are queued in the driver
+            bool is_attached();
+
             size_t get_full_length() const { return _length; }
             size_t get_length_frame_only() const { return _original_length; }
 
             uint8_t* get_frame_start() const { return _start; }
 
+            void export_dmabuf(int fd, uint32_t stride);
+            const dmabuf_descriptor* get_dmabuf() const { return _dmabuf.fd >= 0 ? &_dmabuf : nullptr; }
+
         private:
             uint8_t* _start;
             size_t _length;
@@ -106,6 +114,114 @@ namespace librealsense
             v4l2_buffer _buf;
             std::mutex _mutex;
             bool _must_enqueue = false;
+            dmabuf_descriptor _dmabuf = { -1, 0, 0 };
+        };
+
+        // Counts the frames the driver lost, from the gaps in the sequence numbers of the buffers it completes
+        // Frames are lost either because no buffer was queued to receive them, which more buffers prevent,
+        // or on the USB link, which they do not, so only a gap after the driver ran out of buffers calls for more
+        class v4l_sequence_tracker
+        {
+        public:
+            v4l_sequence_tracker() : _dropped_frames(0) {}
+
+            // Takes the sequence number of a completed buffer, returns whether frames were lost while no buffer was queued
+            bool on_frame(uint32_t sequence);
+
+            // Takes the number of buffers left queued in the driver once a completed one was handled
+            void on_buffers_queued(size_t queued) { _starved = queued == 0; }
+
+            void restart() { _has_sequence = false; _starved = false; }
+            unsigned long long get_dropped_frames() const { return _dropped_frames; }
+
+        private:
+            std::atomic<unsigned long long> _dropped_frames;
+            uint32_t _last_sequence = 0;
+            bool _has_sequence = false;
+            bool _starved = false;
+        };
+
+        // Waits on the file descriptors of all streaming V4L2 devices with epoll, from a fixed number of threads,
+        // so that adding cameras does not add capture threads
+        // Every wake-up drains all filled buffers of the ready device, and a device is handled by one thread at a time
+        // The thread count is taken from the LRS_V4L2_REACTOR_THREADS environment variable, 1 by default
+        class v4l_capture_reactor
+        {
+        public:
+            typedef std::function<bool()> ready_handler; // Returns false to stop watching the device
+            typedef std::function<void()> timeout_handler;
+
+            // The reactor is shared by all devices and lives while any of them is streaming
+            static std::shared_ptr<v4l_capture_reactor> get_shared();
+
+            explicit v4l_capture_reactor(size_t thread_count);
+            ~v4l_capture_reactor();
+
+            uint64_t add(int fd, ready_handler on_ready, timeout_handler on_timeout);
+            // Returns once the handlers of the device are no longer running, must not be called from them
+            void remove(uint64_t id);
+
+            v4l_capture_reactor(const v4l_capture_reactor&) = delete;
+            v4l_capture_reactor& operator=(const v4l_capture_reactor&) = delete;
+
+        private:
+            static const uint64_t STOP_ID = 0;
+
+            struct registration
+            {
+                int fd;
+                ready_handler on_ready;
+                timeout_handler on_timeout;
+                std::mutex mutex;
+                bool active;
+                std::chrono::steady_clock::time_point last_ready;
+            };
+
+            void run();
+            void dispatch(uint64_t id);
+            void check_timeouts();
+
+            int _epoll_fd;
+            int _stop_fd;
+            std::vector<std::thread> _threads;
+
+            std::mutex _mutex;
+            std::map<uint64_t, std::shared_ptr<registration>> _registrations;
+            uint64_t _next_id;
+            std::mutex _timeout_mutex;
+        };
+
+        // Watches for hot-plug through the kernel uevent netlink socket, rather than by enumerating devices periodically
+        // Devices are enumerated again only after a burst of relevant add or remove events has settled
+        // Construction throws when the socket is not available, so that the backend can fall back to polling
+        class v4l_uevent_device_watcher : public device_watcher
+        {
+        public:
+            explicit v4l_uevent_device_watcher(const backend* backend_ref);
+            ~v4l_uevent_device_watcher();
+
+            void start(device_changed_callback callback) override;
+            void stop() override;
+            backend_device_group get_devices() const override;
+            bool is_event_driven() const override { return true; }
+
+            // Only devices that may be a camera, or one of its interfaces, change the enumeration
+            static bool is_relevant_uevent(const char* data, size_t size);
+
+        private:
+            void watch_loop();
+            bool read_events();
+            void rescan();
+
+            const backend* _backend;
+            int _socket_fd;
+            int _stop_fd;
+            std::unique_ptr<std::thread> _thread;
+
+            callbacks_heap _callback_inflight;
+            mutable std::mutex _devices_mutex; // Only taken to update the devices, the watcher thread reads them freely
+            backend_device_group _devices_data;
+            device_changed_callback _callback;
         };
 
         class v4l_usb_device : public usb_device
@@ -177,10 +293,22 @@ namespace librealsense
             void unlock() const override;
 
             std::string get_device_location() const override { return _device_path; }
+
+            unsigned long long get_dropped_frames() const override { return _sequence.get_dropped_frames(); }
+            bool supports_frame_buffers() const override { return true; }
+            void enable_adaptive_buffers(bool enable) override { _adaptive_buffers = enable; }
+            void enable_dmabuf_export(bool enable) override { _export_dmabuf = enable; }
+            void enable_warm_restart(bool enable) override;
         private:
             static uint32_t get_cid(rs2_option option);
 
             void capture_loop();
+            bool dequeue_frame();
+            std::shared_ptr<buffer> allocate_buffer(int index);
+            void grow_buffers();
+            void release_buffers();
+            bool drain();
+            void notify_frames_timeout();
 
             bool has_metadata();
 
@@ -198,8 +326,20 @@ namespace librealsense
             std::atomic<bool> _is_alive;
             std::atomic<bool> _is_started;
             std::unique_ptr<std::thread> _thread;
+            std::shared_ptr<v4l_capture_reactor> _reactor;
+            uint64_t _reactor_id = 0;
             std::unique_ptr<named_mutex> _named_mtx;
             bool _use_memory_map;
+            bool _default_memory_map;
+            std::atomic<bool> _export_dmabuf;
+            uint32_t _bytes_per_line = 0;
+
+            std::atomic<bool> _adaptive_buffers;
+            v4l_sequence_tracker _sequence;
+
+            bool _warm_restart = false;
+            bool _has_warm_buffers = false; // The buffers of _profile were kept by the last close
+            int _requested_buffers = 0;
         };
 
         class v4l_backend : public backend
@@ -7,6 +7,9 @@ INITIALIZE_EASYLOGGINGPP
 
 namespace librealsense
 {
+    // Defined ahead of the logger, which may raise it from its constructor
+    std::atomic<int> log_severity_threshold(RS2_LOG_SEVERITY_NONE);
+
     class logger_type
     {
         rs2_log_severity minimum_log_severity = RS2_LOG_SEVERITY_NONE;
@@ -61,6 +64,7 @@ namespace librealsense
             }
 
             el::Loggers::reconfigureLogger(log_id, defaultConf);
+            log_severity_threshold = std::min(minimum_console_severity, minimum_file_severity);
         }
 
         void open_def() const
@@ -73,6 +77,7 @@ namespace librealsense
             defaultConf.setGlobally(el::ConfigurationType::ToStandardOutput, "false");
 
             el::Loggers::reconfigureLogger(log_id, defaultConf);
+            log_severity_threshold = RS2_LOG_SEVERITY_NONE;
         }
 
 
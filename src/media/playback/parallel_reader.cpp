@@ -0,0 +1,345 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include <algorithm>
+#include "parallel_reader.h"
+#include "archive.h"
+#include "thread-roles.h"
+
+namespace librealsense
+{
+    using namespace device_serializer;
+
+    parallel_reader::parallel_reader(std::shared_ptr<reader> reader, reader_factory factory) :
+        m_reader(reader),
+        m_factory(factory),
+        m_running(false),
+        m_stopping(false),
+        m_start(0),
+        m_segment(0),
+        m_position(0)
+    {
+        if (m_reader == nullptr)
+        {
+            throw invalid_value_exception("null reader");
+        }
+    }
+
+    parallel_reader::~parallel_reader()
+    {
+        stop_workers();
+    }
+
+    void parallel_reader::set_readers(size_t readers)
+    {
+        if (readers > MAX_PARALLEL_READERS)
+        {
+            throw invalid_value_exception(to_string() << "Can not read a file with more than " << MAX_PARALLEL_READERS << " readers (Requested = " << readers << ")");
+        }
+        if (readers > 1 && !m_factory)
+        {
+            throw not_implemented_exception("This file can not be read by several readers");
+        }
+
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        auto workers = readers > 1 ? readers : 0;
+        if (workers == m_workers.size()) return;
+
+        stop_workers();
+
+        // Readers of the file are kept across changes, opening the file again is not cheap
+        m_workers.resize(std::min(m_workers.size(), workers));
+        while (m_workers.size() < workers)
+        {
+            m_workers.push_back(std::unique_ptr<worker>(new worker()));
+        }
+
+        // Segments are handed out differently now, so reading continues from where it stopped
+        restart_from_position();
+    }
+
+    device_snapshot parallel_reader::query_device_description(const nanoseconds& time)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        return m_reader->query_device_description(time);
+    }
+
+    std::shared_ptr<serialized_data> parallel_reader::read_next_data()
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        while (true)
+        {
+            auto data = m_workers.empty() ? m_reader->read_next_data() : read_from_workers();
+            if (data->is<serialized_end_of_file>()) return data;
+            if (should_skip(*data)) continue;
+
+            if (data->get_timestamp() != m_position)
+            {
+                m_position = data->get_timestamp();
+                m_delivered.clear();
+            }
+            m_delivered.push_back(get_source(*data));
+            return data;
+        }
+    }
+
+    void parallel_reader::seek_to_time(const nanoseconds& time)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        stop_workers();
+        m_reader->seek_to_time(time);
+        m_start = m_position = time;
+        m_segment = 0;
+        m_delivered.clear();
+        m_skipped.clear();
+    }
+
+    nanoseconds parallel_reader::query_duration() const
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        return m_reader->query_duration();
+    }
+
+    void parallel_reader::reset()
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        stop_workers();
+        m_reader->reset();
+        m_streams.clear();
+        m_start = m_position = nanoseconds(0);
+        m_segment = 0;
+        m_delivered.clear();
+        m_skipped.clear();
+    }
+
+    void parallel_reader::enable_stream(const std::vector<stream_identifier>& stream_ids)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        stop_workers();
+        m_reader->enable_stream(stream_ids);
+        for (auto&& id : stream_ids)
+        {
+            if (std::find(m_streams.begin(), m_streams.end(), id) == m_streams.end())
+                m_streams.push_back(id);
+        }
+
+        // The workers read the new streams from where playback is
+        if (!m_workers.empty())
+            restart_from_position();
+    }
+
+    void parallel_reader::disable_stream(const std::vector<stream_identifier>& stream_ids)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        m_reader->disable_stream(stream_ids);
+
+        // Data of the streams the workers already read is dropped as it is consumed
+        m_streams.erase(std::remove_if(m_streams.begin(), m_streams.end(), [&stream_ids](const stream_identifier& id)
+        {
+            return std::find(stream_ids.begin(), stream_ids.end(), id) != stream_ids.end();
+        }), m_streams.end());
+    }
+
+    const std::string& parallel_reader::get_file_name() const
+    {
+        return m_reader->get_file_name();
+    }
+
+    size_t parallel_reader::query_frame_count(const stream_identifier& stream_id)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        return m_reader->query_frame_count(stream_id);
+    }
+
+    nanoseconds parallel_reader::query_frame_time(const stream_identifier& stream_id, size_t frame_number)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        return m_reader->query_frame_time(stream_id, frame_number);
+    }
+
+    size_t parallel_reader::query_frame_number(const stream_identifier& stream_id, const nanoseconds& time)
+    {
+        std::lock_guard<std::mutex> lock(m_control_mutex);
+        return m_reader->query_frame_number(stream_id, time);
+    }
+
+    void parallel_reader::start_workers()
+    {
+        // Called with the control locked, the workers only read the file after they are all created
+        for (auto&& w : m_workers)
+        {
+            if (!w->reader)
+                w->reader = m_factory();
+        }
+
+        for (size_t i = 0; i < m_workers.size(); i++)
+        {
+            auto w = m_workers[i].get();
+            auto start = m_start;
+            auto streams = m_streams;
+            w->thread = std::thread([this, w, i, start, streams]()
+            {
+                apply_thread_role(RS2_THREAD_ROLE_PLAYBACK);
+                read_segments(*w, i, start, streams);
+            });
+        }
+        m_running = true;
+    }
+
+    void parallel_reader::stop_workers()
+    {
+        if (!m_running) return;
+
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_stopping = true;
+        }
+        m_room_ready.notify_all();
+
+        for (auto&& w : m_workers)
+        {
+            if (w->thread.joinable())
+                w->thread.join();
+            w->queue.clear();
+        }
+
+        m_stopping = false;
+        m_running = false;
+    }
+
+    void parallel_reader::read_segments(worker& w, size_t first_segment, nanoseconds start, std::vector<stream_identifier> streams)
+    {
+        try
+        {
+            // Bring the streams of this reader in line with the ones of the playback
+            // Enabling or disabling streams keeps only the topics seen after the current position,
+            // so the reader is restarted instead, letting later seeks include every recorded stream and option change
+            if (streams != w.streams)
+            {
+                if (!w.streams.empty()) w.reader->reset();
+                if (!streams.empty()) w.reader->enable_stream(streams);
+                w.streams = streams;
+            }
+
+            auto duration = w.reader->query_duration();
+            for (auto segment = first_segment; ; segment += m_workers.size())
+            {
+                auto segment_start = start + PARALLEL_READER_SEGMENT * static_cast<nanoseconds::rep>(segment);
+                if (streams.empty() || segment_start > duration)
+                {
+                    push(w, { std::make_shared<serialized_end_of_file>(), nullptr });
+                    return;
+                }
+
+                w.reader->seek_to_time(segment_start);
+                while (true)
+                {
+                    auto data = w.reader->read_next_data();
+                    if (data->is<serialized_end_of_file>())
+                    {
+                        // Nothing is recorded past this point, so no later segment has data either
+                        push(w, { data, nullptr });
+                        return;
+                    }
+
+                    // What follows belongs to the segment of another worker
+                    if (data->get_timestamp() >= segment_start + PARALLEL_READER_SEGMENT) break;
+
+                    if (!push(w, { data, nullptr })) return;
+                }
+                if (!push(w, { nullptr, nullptr })) return;
+            }
+        }
+        catch (...)
+        {
+            push(w, { nullptr, std::current_exception() });
+        }
+    }
+
+    bool parallel_reader::push(worker& w, segment_item item)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_queue_mutex);
+            m_room_ready.wait(lock, [this, &w]() { return m_stopping || w.queue.size() < PARALLEL_READER_QUEUE_SIZE; });
+            if (m_stopping) return false;
+            w.queue.push_back(std::move(item));
+        }
+        m_data_ready.notify_all();
+        return true;
+    }
+
+    void parallel_reader::restart_from_position()
+    {
+        // Reading starts again at the time of the last data returned, which is not returned twice
+        m_skipped = m_delivered;
+        m_start = m_position;
+        m_segment = 0;
+
+        if (m_workers.empty() && !m_streams.empty())
+            m_reader->seek_to_time(m_position);
+    }
+
+    std::shared_ptr<serialized_data> parallel_reader::read_from_workers()
+    {
+        // Called with the control locked
+        if (!m_running)
+            start_workers();
+
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        while (true)
+        {
+            auto& w = *m_workers[m_segment % m_workers.size()];
+            m_data_ready.wait(lock, [&w]() { return !w.queue.empty(); });
+
+            // The end of the file and read errors stay queued, and are reported again until the position changes
+            auto item = w.queue.front();
+            if (item.error) std::rethrow_exception(item.error);
+            if (item.data && item.data->is<serialized_end_of_file>()) return item.data;
+
+            w.queue.pop_front();
+            m_room_ready.notify_all();
+
+            if (!item.data)
+            {
+                m_segment++;
+                continue;
+            }
+            return item.data;
+        }
+    }
+
+    bool parallel_reader::should_skip(const serialized_data& data)
+    {
+        auto frame = data.as<serialized_frame>();
+        if (frame && std::find(m_streams.begin(), m_streams.end(), frame->stream_id) == m_streams.end())
+            return true;
+
+        if (m_skipped.empty()) return false;
+        if (data.get_timestamp() != m_position)
+        {
+            m_skipped.clear();
+            return false;
+        }
+
+        auto source = get_source(data);
+        auto it = std::find_if(m_skipped.begin(), m_skipped.end(), [&source](const data_source& s)
+        {
+            return s.stream == source.stream && s.option == source.option;
+        });
+        if (it == m_skipped.end()) return false;
+
+        m_skipped.erase(it);
+        return true;
+    }
+
+    parallel_reader::data_source parallel_reader::get_source(const serialized_data& data)
+    {
+        if (auto frame = data.as<serialized_frame>())
+            return { frame->stream_id, RS2_OPTION_COUNT };
+
+        if (auto option = data.as<serialized_option>())
+            return { { option->sensor_id.device_index, option->sensor_id.sensor_index, RS2_STREAM_ANY, 0 }, option->option_id };
+
+        return { { 0, 0, RS2_STREAM_ANY, 0 }, RS2_OPTION_COUNT };
+    }
+}
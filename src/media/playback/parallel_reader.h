@@ -0,0 +1,96 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <core/serialization.h>
+
+namespace librealsense
+{
+    const size_t MAX_PARALLEL_READERS = 16;
+    const size_t PARALLEL_READER_QUEUE_SIZE = 32;
+    const device_serializer::nanoseconds PARALLEL_READER_SEGMENT = std::chrono::seconds(1);
+
+    // Reads a recording with several readers at once, each opening the file on its own and deserializing
+    // every n-th segment of recording time, so that decompression and deserialization of the chunks run in parallel
+    // Segments are consumed in order, so the data comes out in exactly the order of the file
+    // With a single reader every call goes straight to the underlying reader
+    class parallel_reader : public device_serializer::reader
+    {
+    public:
+        typedef std::function<std::shared_ptr<device_serializer::reader>()> reader_factory;
+
+        parallel_reader(std::shared_ptr<device_serializer::reader> reader, reader_factory factory);
+        ~parallel_reader();
+
+        void set_readers(size_t readers);
+
+        device_serializer::device_snapshot query_device_description(const device_serializer::nanoseconds& time) override;
+        std::shared_ptr<device_serializer::serialized_data> read_next_data() override;
+        void seek_to_time(const device_serializer::nanoseconds& time) override;
+        device_serializer::nanoseconds query_duration() const override;
+        void reset() override;
+        void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
+        void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
+        const std::string& get_file_name() const override;
+        size_t query_frame_count(const device_serializer::stream_identifier& stream_id) override;
+        device_serializer::nanoseconds query_frame_time(const device_serializer::stream_identifier& stream_id, size_t frame_number) override;
+        size_t query_frame_number(const device_serializer::stream_identifier& stream_id, const device_serializer::nanoseconds& time) override;
+
+    private:
+        struct segment_item
+        {
+            std::shared_ptr<device_serializer::serialized_data> data; // Null marks the end of a segment
+            std::exception_ptr error;
+        };
+
+        // What data was read from, the stream of a frame or the sensor and option of an option
+        struct data_source
+        {
+            device_serializer::stream_identifier stream; // The stream type of an option is RS2_STREAM_ANY
+            rs2_option option; // RS2_OPTION_COUNT for a frame
+        };
+
+        struct worker
+        {
+            std::shared_ptr<device_serializer::reader> reader;
+            std::vector<device_serializer::stream_identifier> streams; // Streams enabled in the reader
+            std::deque<segment_item> queue;
+            std::thread thread;
+        };
+
+        void start_workers();
+        void stop_workers();
+        void read_segments(worker& w, size_t first_segment, device_serializer::nanoseconds start,
+                           std::vector<device_serializer::stream_identifier> streams);
+        bool push(worker& w, segment_item item);
+        void restart_from_position();
+        std::shared_ptr<device_serializer::serialized_data> read_from_workers();
+        bool should_skip(const device_serializer::serialized_data& data);
+        static data_source get_source(const device_serializer::serialized_data& data);
+
+        std::shared_ptr<device_serializer::reader> m_reader;
+        reader_factory m_factory;
+        mutable std::mutex m_control_mutex; // Serializes the calls to the reader, held while reading
+        std::mutex m_queue_mutex;
+        std::condition_variable m_data_ready;
+        std::condition_variable m_room_ready;
+        std::vector<std::unique_ptr<worker>> m_workers; // Empty when reading with the underlying reader only
+        bool m_running;
+        bool m_stopping;
+        std::vector<device_serializer::stream_identifier> m_streams;
+        device_serializer::nanoseconds m_start; // Start of the first segment
+        size_t m_segment; // Segment being consumed, counted from m_start
+        device_serializer::nanoseconds m_position; // Timestamp of the last data returned
+        std::vector<data_source> m_delivered; // Sources of the data returned at m_position
+        std::vector<data_source> m_skipped; // Sources of data at m_position to skip once reading restarted there
+    };
+}
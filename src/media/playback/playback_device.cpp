@@ -17,15 +17,24 @@ playback_device::playback_device(std::shared_ptr<context> ctx, std::shared_ptr<d
     m_is_paused(false),
     m_sample_rate(1),
     m_real_time(false),
+    m_batch_mode(false),
     m_prev_timestamp(0),
-    m_read_thread([]() {return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max()); })
+    m_read_thread([]() {return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max(), RS2_THREAD_ROLE_PLAYBACK); })
 {
     if (serializer == nullptr)
     {
         throw invalid_value_exception("null serializer");
     }
 
-    m_reader = serializer;
+    //In batch mode the file is also opened by additional readers, which decode parts of it in parallel
+    auto file = serializer->get_file_name();
+    m_parallel_reader = std::make_shared<parallel_reader>(serializer, [file, ctx]() -> std::shared_ptr<device_serializer::reader>
+    {
+        return std::make_shared<ros_reader>(file, ctx);
+    });
+
+    //Disk I/O and deserialization happen ahead of time, off the thread that paces and delivers the data
+    m_reader = std::make_shared<read_ahead_reader>(m_parallel_reader);
     (*m_read_thread)->start();
 
     //Read header and build device from recorded device snapshot
@@ -226,6 +235,47 @@ void playback_device::seek_to_time(std::chrono::nanoseconds time)
     }
 }
 
+size_t playback_device::get_frame_count(const stream_interface& stream)
+{
+    return m_reader->query_frame_count(get_stream_identifier(stream));
+}
+
+void playback_device::seek_to_frame(const stream_interface& stream, size_t frame_number)
+{
+    auto time = m_reader->query_frame_time(get_stream_identifier(stream), frame_number);
+    seek_to_time(time);
+}
+
+void playback_device::step_frames(const stream_interface& stream, int frames)
+{
+    auto stream_id = get_stream_identifier(stream);
+    auto count = m_reader->query_frame_count(stream_id);
+    if (count == 0)
+    {
+        throw invalid_value_exception("Stream has no frames in the file");
+    }
+
+    //Stepping is relative to the frame at the current position, and stops at the first and last frames
+    auto current = static_cast<long long>(m_reader->query_frame_number(stream_id, nanoseconds(get_position())));
+    auto target = std::max(0LL, std::min(current + frames, static_cast<long long>(count) - 1));
+    seek_to_time(m_reader->query_frame_time(stream_id, static_cast<size_t>(target)));
+}
+
+device_serializer::stream_identifier playback_device::get_stream_identifier(const stream_interface& stream) const
+{
+    for (auto&& sensor : m_sensors)
+    {
+        for (auto&& profile : sensor.second->get_stream_profiles())
+        {
+            if (profile->get_unique_id() == stream.get_unique_id())
+            {
+                return { get_device_index(), sensor.first, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
+            }
+        }
+    }
+    throw invalid_value_exception("Stream is not part of the played file");
+}
+
 rs2_playback_status playback_device::get_current_status() const
 {
     return m_is_started ?
@@ -308,6 +358,42 @@ bool playback_device::is_real_time() const
     return m_real_time;
 }
 
+void playback_device::set_read_ahead(size_t max_frames, size_t max_bytes)
+{
+    LOG_INFO("Set read ahead to " << max_frames << " frames, up to " << max_bytes << " bytes");
+    m_reader->set_read_ahead(max_frames, max_bytes);
+}
+
+void playback_device::set_batch_mode(bool batch_mode, size_t decode_threads)
+{
+    LOG_INFO("Set batch mode to " << (batch_mode ? "True" : "False") << " with " << decode_threads << " decoding threads");
+    for (auto&& sensor : m_sensors)
+    {
+        if (sensor.second->is_streaming())
+        {
+            throw wrong_api_call_sequence_exception("Batch mode can only be changed while the playback sensors are not streaming");
+        }
+    }
+
+    if (decode_threads == 0)
+    {
+        decode_threads = std::min<size_t>(std::max(std::thread::hardware_concurrency(), 1u), MAX_PARALLEL_READERS);
+    }
+    m_parallel_reader->set_readers(batch_mode ? decode_threads : 1);
+
+    //Batch mode delivers every frame, holding reading back while a stream's callback is behind
+    for (auto&& sensor : m_sensors)
+    {
+        sensor.second->set_lossless(batch_mode);
+    }
+    m_batch_mode = batch_mode;
+}
+
+bool playback_device::is_batch_mode() const
+{
+    return m_batch_mode;
+}
+
 platform::backend_device_group playback_device::get_device_data() const
 {
     return platform::backend_device_group({ platform::playback_device_info{ m_reader->get_file_name() } });
@@ -493,8 +579,8 @@ void playback_device::try_looping()
             update_time_base(timestamp);
         }
 
-        //Calculate the duration for the reader to sleep (i.e wait for next frame)
-        auto sleep_time = calc_sleep_time(timestamp);
+        //Calculate the duration for the reader to sleep (i.e wait for next frame), batch mode plays as fast as the data is consumed
+        auto sleep_time = m_batch_mode ? nanoseconds(0) : calc_sleep_time(timestamp);
         if (sleep_time.count() > 0)
         {
             if (m_sample_rate > 0)
@@ -513,7 +599,7 @@ void playback_device::try_looping()
             }
             LOG_DEBUG("Dispatching frame " << frame->stream_id);
             //Dispatch frame to the relevant sensor
-            m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time);
+            m_sensors.at(frame->stream_id.sensor_index)->handle_frame(std::move(frame->frame), m_real_time && !m_batch_mode);
             return true;
         }
 
@@ -11,6 +11,8 @@
 #include "concurrency.h"
 #include "sensor.h"
 #include "playback_sensor.h"
+#include "read_ahead_reader.h"
+#include "parallel_reader.h"
 
 namespace librealsense
 {
@@ -33,6 +35,9 @@ namespace librealsense
 
         void set_frame_rate(double rate);
         void seek_to_time(std::chrono::nanoseconds time);
+        size_t get_frame_count(const stream_interface& stream);
+        void seek_to_frame(const stream_interface& stream, size_t frame_number);
+        void step_frames(const stream_interface& stream, int frames);
         rs2_playback_status get_current_status() const;
         uint64_t get_duration() const;
         void pause();
@@ -40,6 +45,9 @@ namespace librealsense
         void stop();
         void set_real_time(bool real_time);
         bool is_real_time() const;
+        void set_read_ahead(size_t max_frames, size_t max_bytes);
+        void set_batch_mode(bool batch_mode, size_t decode_threads);
+        bool is_batch_mode() const;
         const std::string& get_file_name() const;
         uint64_t get_position() const;
         signal<playback_device, rs2_playback_status> playback_status_changed;
@@ -62,10 +70,12 @@ namespace librealsense
         void register_device_info(const device_serializer::device_snapshot& device_description);
         void register_extrinsics(const device_serializer::device_snapshot& device_description);
         void update_extensions(const device_serializer::device_snapshot& device_description);
+        device_serializer::stream_identifier get_stream_identifier(const stream_interface& stream) const;
 
     private:
         lazy<std::shared_ptr<dispatcher>> m_read_thread;
-        std::shared_ptr<device_serializer::reader> m_reader;
+        std::shared_ptr<read_ahead_reader> m_reader;
+        std::shared_ptr<parallel_reader> m_parallel_reader;
         device_serializer::device_snapshot m_device_description;
         std::atomic_bool m_is_started;
         std::atomic_bool m_is_paused;
@@ -75,6 +85,7 @@ namespace librealsense
         std::map<uint32_t, std::shared_ptr<playback_sensor>> m_active_sensors;
         std::atomic<double> m_sample_rate;
         std::atomic_bool m_real_time;
+        std::atomic_bool m_batch_mode;
         device_serializer::nanoseconds m_prev_timestamp;
         std::shared_ptr<context> m_context;
         std::vector<std::shared_ptr<lazy<rs2_extrinsics>>> m_extrinsics_fetchers;
@@ -26,6 +26,7 @@ std::string profile_to_string(std::shared_ptr<stream_profile_interface> s)
 playback_sensor::playback_sensor(const device_interface& parent_device, const device_serializer::sensor_snapshot& sensor_description):
     m_user_notification_callback(nullptr, [](rs2_notifications_callback* n) {}),
     m_is_started(false),
+    m_lossless(false),
     m_sensor_description(sensor_description),
     m_sensor_id(sensor_description.get_sensor_index()),
     m_parent_device(parent_device)
@@ -63,8 +64,7 @@ void playback_sensor::open(const stream_profiles& requests)
     //For each stream, create a dedicated dispatching thread
     for (auto&& profile : requests)
     {
-        m_dispatchers.emplace(std::make_pair(profile->get_unique_id(), std::make_shared<dispatcher>(10))); //TODO: what size the queue should be?
-        m_dispatchers[profile->get_unique_id()]->start();
+        m_dispatchers.emplace(std::make_pair(profile->get_unique_id(), create_dispatcher()));
         device_serializer::stream_identifier f{ get_device_index(), m_sensor_id, profile->get_stream_type(), static_cast<uint32_t>(profile->get_stream_index()) };
         opened_streams.push_back(f);
     }
@@ -137,6 +137,12 @@ const device_interface& playback_sensor::get_device()
     return m_parent_device;
 }
 
+latency_stats playback_sensor::get_latency_stats(int /*stream_id*/) const
+{
+    // Recorded frames are not completed by a host driver, so there is nothing to measure
+    return latency_stats();
+}
+
 void playback_sensor::handle_frame(frame_holder frame, bool is_real_time)
 {
     if(frame == nullptr)
@@ -156,20 +162,40 @@ void playback_sensor::handle_frame(frame_holder frame, bool is_real_time)
         {
             return;
         }
-        //TODO: Ziv, remove usage of shared_ptr when frame_holder is cpoyable
-        auto pf = std::make_shared<frame_holder>(std::move(frame));
-        m_dispatchers.at(stream_id)->invoke([this, pf](dispatcher::cancellable_timer t)
+        //The frame is moved into the (move-only) dispatcher task through bind, since lambdas can not capture by move
+        m_dispatchers.at(stream_id)->invoke(std::bind([this](frame_holder& f, dispatcher::cancellable_timer t)
         {
             frame_interface* pframe = nullptr;
-            std::swap((*pf).frame, pframe);
+            std::swap(f.frame, pframe);
             m_user_callback->on_frame((rs2_frame*)pframe);
-        });
+        }, std::move(frame), std::placeholders::_1));
         if(is_real_time)
         {
             m_dispatchers.at(stream_id)->flush();
         }
     }
 }
+void playback_sensor::set_lossless(bool lossless)
+{
+    m_lossless = lossless;
+
+    //Streams that are already open get dispatchers of the new kind, nothing is queued while the sensor is not started
+    for (auto&& dispatcher : m_dispatchers)
+    {
+        dispatcher.second = create_dispatcher();
+    }
+}
+
+std::shared_ptr<dispatcher> playback_sensor::create_dispatcher() const
+{
+    //A lossless dispatcher holds the reading thread back while the user callback is behind, instead of dropping frames
+    auto d = m_lossless ?
+        std::make_shared<dispatcher>(10, RS2_THREAD_ROLE_PLAYBACK, queue_policy::block, std::numeric_limits<unsigned int>::max()) :
+        std::make_shared<dispatcher>(10, RS2_THREAD_ROLE_PLAYBACK); //TODO: what size the queue should be?
+    d->start();
+    return d;
+}
+
 void playback_sensor::update_option(rs2_option id, std::shared_ptr<option> option)
 {
     register_option(id, option);
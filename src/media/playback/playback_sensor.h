@@ -38,21 +38,25 @@ namespace librealsense
         bool is_streaming() const override;
         bool extend_to(rs2_extension extension_type, void** ext) override;
         const device_interface& get_device() override;
+        latency_stats get_latency_stats(int stream_id) const override;
         void handle_frame(frame_holder frame, bool is_real_time);
         void update_option(rs2_option id, std::shared_ptr<option> option);
         void stop(bool invoke_required);
         void flush_pending_frames();
+        void set_lossless(bool lossless);
         void update(const device_serializer::sensor_snapshot& sensor_snapshot);
     private:
         void register_sensor_streams(const stream_profiles& vector);
         void register_sensor_infos(const device_serializer::sensor_snapshot& sensor_snapshot);
         void register_sensor_options(const device_serializer::sensor_snapshot& sensor_snapshot);
+        std::shared_ptr<dispatcher> create_dispatcher() const;
 
         frame_callback_ptr m_user_callback;
         librealsense::notifications_callback_ptr m_user_notification_callback;
         using stream_unique_id = int;
         std::map<stream_unique_id, std::shared_ptr<dispatcher>> m_dispatchers;
         std::atomic<bool> m_is_started;
+        std::atomic<bool> m_lossless;
         device_serializer::sensor_snapshot m_sensor_description;
         uint32_t m_sensor_id;
         std::mutex m_mutex;
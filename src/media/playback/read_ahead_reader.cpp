@@ -0,0 +1,250 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include <algorithm>
+#include "read_ahead_reader.h"
+#include "archive.h"
+#include "thread-roles.h"
+
+namespace librealsense
+{
+    using namespace device_serializer;
+
+    read_ahead_reader::read_ahead_reader(std::shared_ptr<reader> reader, size_t max_frames, size_t max_bytes) :
+        m_reader(reader),
+        m_queued_bytes(0),
+        m_max_frames(0),
+        m_max_bytes(0),
+        m_at_end(false),
+        m_stopping(false)
+    {
+        if (m_reader == nullptr)
+        {
+            throw invalid_value_exception("null reader");
+        }
+        set_read_ahead(max_frames, max_bytes);
+    }
+
+    read_ahead_reader::~read_ahead_reader()
+    {
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_stopping = true;
+        }
+        m_room_ready.notify_all();
+        if (m_thread.joinable())
+            m_thread.join();
+    }
+
+    void read_ahead_reader::set_read_ahead(size_t max_frames, size_t max_bytes)
+    {
+        if (max_frames > MAX_READ_AHEAD_FRAMES)
+        {
+            throw invalid_value_exception(to_string() << "Can not read more than " << MAX_READ_AHEAD_FRAMES << " frames ahead (Requested = " << max_frames << ")");
+        }
+
+        std::lock_guard<std::mutex> reader_lock(m_reader_mutex);
+        if (max_frames == 0)
+        {
+            // Reading goes straight to the file again, from where playback actually is
+            rewind_read_ahead();
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_max_frames = max_frames;
+            m_max_bytes = max_bytes;
+        }
+        m_room_ready.notify_all();
+        m_data_ready.notify_all();
+    }
+
+    device_snapshot read_ahead_reader::query_device_description(const nanoseconds& time)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        return m_reader->query_device_description(time);
+    }
+
+    std::shared_ptr<serialized_data> read_ahead_reader::read_next_data()
+    {
+        std::unique_lock<std::mutex> lock(m_queue_mutex);
+        if (m_max_frames > 0 && !m_thread.joinable())
+        {
+            // The thread starts with the first read, nothing is read ahead of a playback that never starts
+            m_thread = std::thread([this]() { apply_thread_role(RS2_THREAD_ROLE_PLAYBACK); read_loop(); });
+        }
+
+        m_data_ready.wait(lock, [this]() { return !m_queue.empty() || m_max_frames == 0; });
+        if (m_queue.empty())
+        {
+            lock.unlock();
+            std::lock_guard<std::mutex> reader_lock(m_reader_mutex);
+            return m_reader->read_next_data();
+        }
+
+        // The end of the file and read errors stay queued, and are reported again until the position changes
+        auto item = m_queue.front();
+        if (item.error) std::rethrow_exception(item.error);
+        if (item.data->is<serialized_end_of_file>()) return item.data;
+
+        m_queue.pop_front();
+        m_queued_bytes -= item.bytes;
+        lock.unlock();
+
+        m_room_ready.notify_all();
+        return item.data;
+    }
+
+    void read_ahead_reader::seek_to_time(const nanoseconds& time)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        discard_read_ahead();
+        m_reader->seek_to_time(time);
+    }
+
+    nanoseconds read_ahead_reader::query_duration() const
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        return m_reader->query_duration();
+    }
+
+    void read_ahead_reader::reset()
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        discard_read_ahead();
+        m_reader->reset();
+    }
+
+    void read_ahead_reader::enable_stream(const std::vector<stream_identifier>& stream_ids)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+
+        // The new streams start where the reader is, so move it back to where playback is first
+        rewind_read_ahead();
+        m_reader->enable_stream(stream_ids);
+    }
+
+    void read_ahead_reader::disable_stream(const std::vector<stream_identifier>& stream_ids)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        m_reader->disable_stream(stream_ids);
+
+        // Later data of the streams is no longer read, drop what was already read of it
+        {
+            std::lock_guard<std::mutex> queue_lock(m_queue_mutex);
+            for (auto it = m_queue.begin(); it != m_queue.end();)
+            {
+                auto frame = it->data ? it->data->as<serialized_frame>() : nullptr;
+                auto disabled = frame && std::any_of(stream_ids.begin(), stream_ids.end(),
+                    [&frame](const stream_identifier& id) { return id == frame->stream_id; });
+                if (disabled)
+                {
+                    m_queued_bytes -= it->bytes;
+                    it = m_queue.erase(it);
+                }
+                else
+                    ++it;
+            }
+        }
+        m_room_ready.notify_all();
+    }
+
+    const std::string& read_ahead_reader::get_file_name() const
+    {
+        return m_reader->get_file_name();
+    }
+
+    size_t read_ahead_reader::query_frame_count(const stream_identifier& stream_id)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        return m_reader->query_frame_count(stream_id);
+    }
+
+    nanoseconds read_ahead_reader::query_frame_time(const stream_identifier& stream_id, size_t frame_number)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        return m_reader->query_frame_time(stream_id, frame_number);
+    }
+
+    size_t read_ahead_reader::query_frame_number(const stream_identifier& stream_id, const nanoseconds& time)
+    {
+        std::lock_guard<std::mutex> lock(m_reader_mutex);
+        return m_reader->query_frame_number(stream_id, time);
+    }
+
+    void read_ahead_reader::read_loop()
+    {
+        while (true)
+        {
+            {
+                std::unique_lock<std::mutex> lock(m_queue_mutex);
+                m_room_ready.wait(lock, [this]() { return m_stopping || (!m_at_end && has_room()); });
+                if (m_stopping) return;
+            }
+
+            {
+                // What was read is queued before the reader is released, so a seek or a rewind
+                // either happens before the read or finds the data in the queue
+                std::lock_guard<std::mutex> reader_lock(m_reader_mutex);
+                read_ahead_item item{ nullptr, nullptr, 0 };
+                try
+                {
+                    item.data = m_reader->read_next_data();
+                    item.bytes = get_size(*item.data);
+                }
+                catch (...)
+                {
+                    item.error = std::current_exception();
+                }
+
+                std::lock_guard<std::mutex> lock(m_queue_mutex);
+                m_at_end = item.error || item.data->is<serialized_end_of_file>();
+                m_queued_bytes += item.bytes;
+                m_queue.push_back(std::move(item));
+            }
+            m_data_ready.notify_all();
+        }
+    }
+
+    bool read_ahead_reader::has_room() const
+    {
+        // A single frame is always let through, however large
+        return m_queue.size() < m_max_frames && (m_queue.empty() || m_queued_bytes < m_max_bytes);
+    }
+
+    void read_ahead_reader::discard_read_ahead()
+    {
+        // Called with the reader locked, so no read is in progress once the queue is cleared
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            m_queue.clear();
+            m_queued_bytes = 0;
+            m_at_end = false;
+        }
+        m_room_ready.notify_all();
+    }
+
+    void read_ahead_reader::rewind_read_ahead()
+    {
+        std::shared_ptr<serialized_data> next;
+        {
+            std::lock_guard<std::mutex> lock(m_queue_mutex);
+            if (!m_queue.empty() && m_queue.front().data && !m_queue.front().data->is<serialized_end_of_file>())
+                next = m_queue.front().data;
+        }
+        discard_read_ahead();
+
+        // Data recorded at the very same time as the next one, and already played, is read again
+        if (next)
+            m_reader->seek_to_time(next->get_timestamp());
+    }
+
+    size_t read_ahead_reader::get_size(const serialized_data& data)
+    {
+        auto serialized = data.as<serialized_frame>();
+        if (!serialized) return 0;
+
+        auto f = dynamic_cast<librealsense::frame*>(serialized->frame.frame);
+        return f ? f->data.size() : 0;
+    }
+}
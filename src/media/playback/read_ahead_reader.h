@@ -0,0 +1,72 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <core/serialization.h>
+
+namespace librealsense
+{
+    const size_t DEFAULT_READ_AHEAD_FRAMES = 16;
+    const size_t MAX_READ_AHEAD_FRAMES = 64;
+    const size_t DEFAULT_READ_AHEAD_BYTES = 128 * 1024 * 1024;
+
+    // Reads and deserializes the data of a recording on a background thread, ahead of playback
+    // Up to a number of frames and a number of frame bytes are kept ready, so pacing and delivery
+    // of the playback only wait for the file when the reader falls behind
+    // Seeking and resetting discard what was read ahead, and with no read-ahead frames every call goes straight to the file
+    class read_ahead_reader : public device_serializer::reader
+    {
+    public:
+        explicit read_ahead_reader(std::shared_ptr<device_serializer::reader> reader,
+                                   size_t max_frames = DEFAULT_READ_AHEAD_FRAMES,
+                                   size_t max_bytes = DEFAULT_READ_AHEAD_BYTES);
+        ~read_ahead_reader();
+
+        void set_read_ahead(size_t max_frames, size_t max_bytes);
+
+        device_serializer::device_snapshot query_device_description(const device_serializer::nanoseconds& time) override;
+        std::shared_ptr<device_serializer::serialized_data> read_next_data() override;
+        void seek_to_time(const device_serializer::nanoseconds& time) override;
+        device_serializer::nanoseconds query_duration() const override;
+        void reset() override;
+        void enable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
+        void disable_stream(const std::vector<device_serializer::stream_identifier>& stream_ids) override;
+        const std::string& get_file_name() const override;
+        size_t query_frame_count(const device_serializer::stream_identifier& stream_id) override;
+        device_serializer::nanoseconds query_frame_time(const device_serializer::stream_identifier& stream_id, size_t frame_number) override;
+        size_t query_frame_number(const device_serializer::stream_identifier& stream_id, const device_serializer::nanoseconds& time) override;
+
+    private:
+        struct read_ahead_item
+        {
+            std::shared_ptr<device_serializer::serialized_data> data;
+            std::exception_ptr error;
+            size_t bytes;
+        };
+
+        void read_loop();
+        bool has_room() const;
+        void discard_read_ahead();
+        void rewind_read_ahead();
+        static size_t get_size(const device_serializer::serialized_data& data);
+
+        std::shared_ptr<device_serializer::reader> m_reader;
+        mutable std::mutex m_reader_mutex; // Serializes access to the underlying reader, held while reading and queueing what was read
+        std::mutex m_queue_mutex;
+        std::condition_variable m_data_ready;
+        std::condition_variable m_room_ready;
+        std::deque<read_ahead_item> m_queue;
+        size_t m_queued_bytes;
+        size_t m_max_frames;
+        size_t m_max_bytes;
+        bool m_at_end; // The end of the file or an error was queued, nothing more is read until the position changes
+        bool m_stopping;
+        std::thread m_thread;
+    };
+}
@@ -10,7 +10,7 @@ using namespace device_serializer;
 
 librealsense::record_device::record_device(std::shared_ptr<librealsense::device_interface> device,
                                       std::shared_ptr<librealsense::device_serializer::writer> serializer):
-    m_write_thread([](){return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max());}),
+    m_write_thread([](){return std::make_shared<dispatcher>(std::numeric_limits<unsigned int>::max(), RS2_THREAD_ROLE_RECORD);}),
     m_is_recording(true),
     m_record_pause_time(0)
 {
@@ -128,10 +128,7 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
 
     m_cached_data_size = cached_data_size;
     auto capture_time = get_capture_time();
-    //TODO: remove usage of shared pointer when frame_holder is copyable
-    auto frame_holder_ptr = std::make_shared<frame_holder>();
-    *frame_holder_ptr = std::move(frame);
-    (*m_write_thread)->invoke([this, frame_holder_ptr, sensor_index, capture_time/*, data_size*/, on_error](dispatcher::cancellable_timer t) {
+    (*m_write_thread)->invoke(std::bind([this, sensor_index, capture_time/*, data_size*/](frame_holder& frame, std::function<void(std::string const&)>& on_error, dispatcher::cancellable_timer t) {
         if (m_is_recording == false)
         {
             return; //Recording is paused
@@ -152,16 +149,16 @@ void librealsense::record_device::write_data(size_t sensor_index, librealsense::
         try
         {
             const uint32_t device_index = 0;
-            auto stream_type = frame_holder_ptr->frame->get_stream()->get_stream_type();
-            auto stream_index = static_cast<uint32_t>(frame_holder_ptr->frame->get_stream()->get_stream_index());
-            m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(sensor_index), stream_type, stream_index }, capture_time, std::move(*frame_holder_ptr));
+            auto stream_type = frame->get_stream()->get_stream_type();
+            auto stream_index = static_cast<uint32_t>(frame->get_stream()->get_stream_index());
+            m_ros_writer->write_frame({ device_index, static_cast<uint32_t>(sensor_index), stream_type, stream_index }, capture_time, std::move(frame));
             //TODO: restore: std::lock_guard<std::mutex> locker(m_mutex);  m_cached_data_size -= data_size;
         }
         catch(std::exception& e)
         {
             on_error(to_string() << "Failed to write frame. " << e.what());
         }
-    });
+    }, std::move(frame), std::move(on_error), std::placeholders::_1));
 }
 
 const std::string& librealsense::record_device::get_info(rs2_camera_info info) const
@@ -243,6 +240,8 @@ snapshot_collection librealsense::record_device::get_extensions_snapshots(T* ext
             case RS2_EXTENSION_POINTS          : break;
             case RS2_EXTENSION_RECORD          : break;
             case RS2_EXTENSION_PLAYBACK        : break;
+            case RS2_EXTENSION_DMABUF_FRAME    : break;
+            case RS2_EXTENSION_MOTION_BATCH_FRAME : break;
             case RS2_EXTENSION_COUNT           : break;
             case RS2_EXTENSION_UNKNOWN         : break;
             default:
@@ -194,6 +194,11 @@ const device_interface& record_sensor::get_device()
     return m_parent_device;
 }
 
+latency_stats record_sensor::get_latency_stats(int stream_id) const
+{
+    return m_sensor.get_latency_stats(stream_id);
+}
+
 void record_sensor::raise_user_notification(const std::string& str)
 {
     notification noti(RS2_NOTIFICATION_CATEGORY_UNKNOWN_ERROR, 0, RS2_LOG_SEVERITY_ERROR, str);
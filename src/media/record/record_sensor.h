@@ -41,6 +41,7 @@ namespace librealsense
         bool is_streaming() const override;
         bool extend_to(rs2_extension extension_type, void** ext) override;
         const device_interface& get_device() override;
+        latency_stats get_latency_stats(int stream_id) const override;
         
     private /*methods*/:
         void raise_user_notification(const std::string& str);
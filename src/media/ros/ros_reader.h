@@ -87,8 +87,9 @@ namespace librealsense
             {
                 throw invalid_value_exception(to_string() << "Requested time is out of playback length. (Requested = " << seek_time.count() << ", Duration = " << m_total_duration.count() << ")");
             }
-            auto seek_time_as_secs = std::chrono::duration_cast<std::chrono::duration<double>>(seek_time);
-            auto seek_time_as_rostime = ros::Time(seek_time_as_secs.count());
+            //Converting through double seconds may round past the message the time was taken from
+            ros::Time seek_time_as_rostime;
+            seek_time_as_rostime.fromNSec(seek_time.count());
 
             m_samples_view.reset(new rosbag::View(m_file, FalseQuery()));
             
@@ -107,6 +108,28 @@ namespace librealsense
             return m_total_duration;
         }
 
+        size_t query_frame_count(const stream_identifier& stream_id) override
+        {
+            return get_frame_index(stream_id).size();
+        }
+
+        nanoseconds query_frame_time(const stream_identifier& stream_id, size_t frame_number) override
+        {
+            auto&& index = get_frame_index(stream_id);
+            if (frame_number >= index.size())
+            {
+                throw invalid_value_exception(to_string() << "Requested frame is out of the stream. (Requested = " << frame_number << ", Frames = " << index.size() << ")");
+            }
+            return index[frame_number];
+        }
+
+        size_t query_frame_number(const stream_identifier& stream_id, const nanoseconds& time) override
+        {
+            auto&& index = get_frame_index(stream_id);
+            auto it = std::upper_bound(index.begin(), index.end(), time);
+            return it == index.begin() ? 0 : static_cast<size_t>(it - index.begin() - 1);
+        }
+
         void reset() override
         {
             m_file.close();
@@ -119,8 +142,11 @@ namespace librealsense
             }
 
             m_samples_view = nullptr;
+            m_frame_index.clear();
             m_frame_source = std::make_shared<frame_source>();
             m_frame_source->init(m_metadata_parser_map);
+            //Frames read ahead of playback are held on top of the frames the application holds
+            m_frame_source->set_max_published_frames(RS2_USER_QUEUE_SIZE);
             m_initial_device_description = read_device_description(get_static_file_info_timestamp(), true);
         }
 
@@ -609,6 +635,29 @@ namespace librealsense
             return options;
         }
 
+        //The bag index already maps every message to its chunk, this keeps the times of each stream in a vector
+        // so that frames can be found by number and by time with a binary search
+        //The index of a stream is built on first use, from the bag index alone and without reading any message
+        const std::vector<nanoseconds>& get_frame_index(const stream_identifier& stream_id)
+        {
+            auto it = m_frame_index.find(stream_id);
+            if (it != m_frame_index.end())
+            {
+                return it->second;
+            }
+
+            std::vector<nanoseconds> times;
+            rosbag::View view(m_file, StreamQuery(stream_id));
+            for (auto&& msg : view)
+            {
+                times.push_back(to_nanoseconds(msg.getTime()));
+            }
+            //Messages of a stream are already in time order, unless the stream was recorded over several connections
+            std::sort(times.begin(), times.end());
+            LOG_DEBUG("Indexed " << times.size() << " frames of stream " << stream_id);
+            return m_frame_index[stream_id] = std::move(times);
+        }
+
         static std::vector<std::string> get_topics(std::unique_ptr<rosbag::View>& view)
         {
             std::vector<std::string> topics;
@@ -628,6 +677,7 @@ namespace librealsense
         std::unique_ptr<rosbag::View>           m_samples_view;
         rosbag::View::iterator                  m_samples_itrator;
         std::vector<std::string>                m_enabled_streams_topics;
+        std::map<stream_identifier, std::vector<nanoseconds>> m_frame_index;
         std::shared_ptr<metadata_parser_map>    m_metadata_parser_map;
         std::shared_ptr<context>                m_context;
         uint32_t                                m_version;
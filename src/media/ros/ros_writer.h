@@ -5,6 +5,8 @@
 
 #include <string>
 #include <memory>
+#include <algorithm>
+#include <thread>
 #include "core/debug.h"
 #include "core/serialization.h"
 #include "archive.h"
@@ -20,17 +22,96 @@
 #include "sensor_msgs/CameraInfo.h"
 #include "ros_file_format.h"
 
+namespace librealsense
+{
+    // An image message whose data is the payload of a frame
+    // It is serialized exactly as a sensor_msgs::Image, straight from the frame, without copying the payload into the message first
+    struct frame_image_message
+    {
+        std_msgs::Header header;
+        uint32_t height;
+        uint32_t width;
+        std::string encoding;
+        uint8_t is_bigendian;
+        uint32_t step;
+        const uint8_t* data;
+        uint32_t data_size;
+    };
+}
+
+namespace ros
+{
+    namespace message_traits
+    {
+        template<> struct MD5Sum<librealsense::frame_image_message>
+        {
+            static const char* value() { return MD5Sum<sensor_msgs::Image>::value(); }
+            static const char* value(const librealsense::frame_image_message&) { return value(); }
+        };
+
+        template<> struct DataType<librealsense::frame_image_message>
+        {
+            static const char* value() { return DataType<sensor_msgs::Image>::value(); }
+            static const char* value(const librealsense::frame_image_message&) { return value(); }
+        };
+
+        template<> struct Definition<librealsense::frame_image_message>
+        {
+            static const char* value() { return Definition<sensor_msgs::Image>::value(); }
+            static const char* value(const librealsense::frame_image_message&) { return value(); }
+        };
+    }
+
+    namespace serialization
+    {
+        template<> struct Serializer<librealsense::frame_image_message>
+        {
+            template<typename Stream>
+            inline static void write(Stream& stream, const librealsense::frame_image_message& m)
+            {
+                stream.next(m.header);
+                stream.next(m.height);
+                stream.next(m.width);
+                stream.next(m.encoding);
+                stream.next(m.is_bigendian);
+                stream.next(m.step);
+                //The data is a length prefixed byte array, as the std::vector<uint8_t> of sensor_msgs::Image
+                stream.next(m.data_size);
+                if (m.data_size > 0)
+                {
+                    memcpy(stream.advance(m.data_size), m.data, m.data_size);
+                }
+            }
+
+            inline static uint32_t serializedLength(const librealsense::frame_image_message& m)
+            {
+                return serializationLength(m.header) + serializationLength(m.encoding) +
+                    sizeof(m.height) + sizeof(m.width) + sizeof(m.is_bigendian) + sizeof(m.step) + sizeof(m.data_size) + m.data_size;
+            }
+        };
+    }
+}
+
 namespace librealsense
 {
     using namespace device_serializer;
 
+    const uint32_t MAX_COMPRESSION_THREADS = 4;
+
     class ros_writer: public writer
     {
     public:
-        explicit ros_writer(const std::string& file) : m_file_path(file)
+        // A chunk threshold of 0 keeps the default size of the bag's chunks
+        explicit ros_writer(const std::string& file, bool compression = true, uint32_t chunk_threshold = 0) : m_file_path(file)
         {
             m_bag.open(file, rosbag::BagMode::Write);
-            m_bag.setCompression(rosbag::CompressionType::LZ4);
+            m_bag.setCompression(compression ? rosbag::CompressionType::LZ4 : rosbag::CompressionType::Uncompressed);
+            if (chunk_threshold > 0)
+                m_bag.setChunkThreshold(chunk_threshold);
+
+            // Chunks are compressed on their own threads, so writing frames never waits for LZ4
+            auto threads = std::min(std::max(std::thread::hardware_concurrency(), 1u), MAX_COMPRESSION_THREADS);
+            m_bag.setCompressionThreads(threads);
             write_file_version();
         }
 
@@ -96,7 +177,7 @@ namespace librealsense
 
         void write_video_frame(stream_identifier stream_id, const nanoseconds& timestamp, const frame_holder& frame)
         {
-            sensor_msgs::Image image;
+            frame_image_message image;
             auto vid_frame = dynamic_cast<librealsense::video_frame*>(frame.frame);
             assert(vid_frame != nullptr);
 
@@ -105,9 +186,9 @@ namespace librealsense
             image.step = static_cast<uint32_t>(vid_frame->get_stride());
             convert(vid_frame->get_stream()->get_format(), image.encoding);
             image.is_bigendian = is_big_endian();
-            auto size = vid_frame->get_stride() * vid_frame->get_height();
-            auto p_data = vid_frame->get_frame_data();
-            image.data.assign(p_data, p_data + size);
+            //The payload is serialized from the frame itself, which the caller keeps alive until it is written
+            image.data_size = static_cast<uint32_t>(vid_frame->get_stride() * vid_frame->get_height());
+            image.data = vid_frame->get_frame_data();
             image.header.seq = static_cast<uint32_t>(vid_frame->get_frame_number());
             std::chrono::duration<double, std::milli> timestamp_ms(vid_frame->get_frame_timestamp());
             image.header.stamp = ros::Time(std::chrono::duration<double>(timestamp_ms).count());
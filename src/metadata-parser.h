@@ -52,6 +52,21 @@ namespace librealsense
         }
     };
 
+    /**\brief Time the host driver completed the frame at, reported by backends that timestamp frames in the kernel*/
+    class md_backend_timestamp_parser : public md_attribute_parser_base
+    {
+    public:
+        rs2_metadata_type get(const frame& frm) const override
+        {
+            return (rs2_metadata_type)(frm.additional_data.backend_timestamp * 1000);
+        }
+
+        bool supports(const frame& frm) const override
+        {
+            return frm.additional_data.backend_timestamp != 0;
+        }
+    };
+
     /**\brief The metadata parser class directly access the metadata attribute in the blob received from HW.
     *   Given the metadata-nested construct, and the c++ lack of pointers
     *   to the inner struct, we pre-calculate and store the attribute offset internally
@@ -627,6 +627,12 @@ namespace librealsense
             }, _entity_id, call_type::device_watcher_stop);
         }
 
+        backend_device_group record_device_watcher::get_devices() const
+        {
+            // Recorded as queries of the backend, which playback answers in the same order
+            return { _owner->query_uvc_devices(), _owner->query_usb_devices(), _owner->query_hid_devices() };
+        }
+
 
         void record_uvc_device::probe_and_commit(stream_profile profile, frame_callback callback, int buffers)
         {
@@ -897,17 +903,21 @@ namespace librealsense
             {
                 _source->start_capture([this, callback](const sensor_data& sd)
                 {
-                    _owner->try_record([this, callback, &sd](recording* rec1, lookup_key key1)
+                    // Samples are recorded one by one, so that recordings do not depend on how the backend batches them
+                    for (uint32_t i = 0; i < sd.sample_count; i++)
                     {
-                        auto&& c = rec1->add_call(key1);
-                        c.param1 = rec1->save_blob(sd.fo.pixels, sd.fo.frame_size);
-                        c.param2 = rec1->save_blob(sd.fo.metadata, sd.fo.metadata_size);
-
+                        auto sample = sd.get_sample(i);
+                        _owner->try_record([&](recording* rec1, lookup_key key1)
+                        {
+                            auto&& c = rec1->add_call(key1);
+                            c.param1 = rec1->save_blob(sample.pixels, sample.frame_size);
+                            c.param2 = rec1->save_blob(sample.metadata, sample.metadata_size);
 
-                        c.inline_string = sd.sensor.name;
+                            c.inline_string = sd.sensor.name;
+                        }, _entity_id, call_type::hid_frame);
+                    }
 
-                        callback(sd);
-                    }, _entity_id, call_type::hid_frame);
+                    callback(sd);
                 });
 
             }, _entity_id, call_type::hid_start_capture);
@@ -954,6 +964,22 @@ namespace librealsense
             }, _entity_id, call_type::uvc_get_location);
         }
 
+        // Kernel buffer management is not part of the recording, playback has no kernel buffers to drop
+        unsigned long long record_uvc_device::get_dropped_frames() const
+        {
+            return _source->get_dropped_frames();
+        }
+
+        bool record_uvc_device::supports_frame_buffers() const
+        {
+            return _source->supports_frame_buffers();
+        }
+
+        void record_uvc_device::enable_adaptive_buffers(bool enable)
+        {
+            _source->enable_adaptive_buffers(enable);
+        }
+
         vector<uint8_t> record_usb_device::send_receive(const vector<uint8_t>& data, int timeout_ms, bool require_response)
         {
             return _owner->try_record([&](recording* rec, lookup_key k)
@@ -1124,7 +1150,7 @@ namespace librealsense
         }
 
         playback_backend::playback_backend(const char* filename, const char* section)
-            : _device_watcher(new playback_device_watcher(0)),
+            : _device_watcher(new playback_device_watcher(0, this)),
             _rec(platform::recording::load(filename, section, _device_watcher))
         {
 
@@ -1144,8 +1170,8 @@ namespace librealsense
             //LOG(INFO) << "Finished writing " << _rec->size() << " calls...";
         }
 
-        playback_device_watcher::playback_device_watcher(int id)
-            : _entity_id(id), _alive(false), _dispatcher(10)
+        playback_device_watcher::playback_device_watcher(int id, const backend* owner)
+            : _entity_id(id), _owner(owner), _alive(false), _dispatcher(10)
         {}
 
         playback_device_watcher::~playback_device_watcher()
@@ -1172,6 +1198,11 @@ namespace librealsense
             }
         }
 
+        backend_device_group playback_device_watcher::get_devices() const
+        {
+            return { _owner->query_uvc_devices(), _owner->query_usb_devices(), _owner->query_hid_devices() };
+        }
+
         void playback_device_watcher::raise_callback(backend_device_group old, backend_device_group curr)
         {
             _dispatcher.invoke([=](dispatcher::cancellable_timer t) {
@@ -1354,7 +1385,7 @@ namespace librealsense
         playback_uvc_device::playback_uvc_device(shared_ptr<recording> rec, int id)
             : _rec(rec), _entity_id(id), _alive(true)
         {
-            _callback_thread = std::thread([this]() { callback_thread(); });
+            _callback_thread = std::thread([this]() { apply_thread_role(RS2_THREAD_ROLE_CAPTURE); callback_thread(); });
         }
 
         void playback_hid_device::open(const std::vector<hid_profile>& hid_profiles)
@@ -1392,7 +1423,7 @@ namespace librealsense
             _callback = callback;
             _alive = true;
 
-            _callback_thread = std::thread([this]() { callback_thread(); });
+            _callback_thread = std::thread([this]() { apply_thread_role(RS2_THREAD_ROLE_MOTION_CAPTURE); callback_thread(); });
         }
 
         vector<hid_sensor> playback_hid_device::get_sensors()
@@ -1424,7 +1455,7 @@ namespace librealsense
                     auto sd_data = _rec->load_blob(c_ptr->param1);
                     auto sensor_name = c_ptr->inline_string;
 
-                    sensor_data sd;
+                    sensor_data sd{};
                     sd.fo.pixels = (void*)sd_data.data();
                     sd.fo.frame_size = sd_data.size();
 
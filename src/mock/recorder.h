@@ -342,6 +342,9 @@ namespace librealsense
             void lock() const override;
             void unlock() const override;
             std::string get_device_location() const override;
+            unsigned long long get_dropped_frames() const override;
+            bool supports_frame_buffers() const override;
+            void enable_adaptive_buffers(bool enable) override;
 
             explicit record_uvc_device(
                 std::shared_ptr<uvc_device> source,
@@ -410,6 +413,8 @@ namespace librealsense
 
             void stop() override;
 
+            backend_device_group get_devices() const override;
+
         private:
             const record_backend* _owner;
             std::shared_ptr<device_watcher> _source_watcher;
@@ -483,15 +488,17 @@ namespace librealsense
         {
 
         public:
-            playback_device_watcher(int id);
+            playback_device_watcher(int id, const backend* owner);
             ~playback_device_watcher();
             void start(device_changed_callback callback) override;
             void stop() override;
+            backend_device_group get_devices() const override;
 
             void raise_callback(backend_device_group old, backend_device_group curr);
 
         private:
             int _entity_id;
+            const backend* _owner;
             std::atomic<bool> _alive;
             std::thread _callback_thread;
             dispatcher _dispatcher;
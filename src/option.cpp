@@ -35,6 +35,12 @@ float librealsense::uvc_pu_option::query() const
         }));
 }
 
+float librealsense::kernel_frame_drops_option::query() const
+{
+    // The counter lives in the backend, reading it does not need the device powered
+    return static_cast<float>(_ep.get_kernel_frame_drops());
+}
+
 librealsense::option_range librealsense::uvc_pu_option::get_range() const
 {
     auto uvc_range = _ep.invoke_powered(
@@ -13,6 +13,8 @@
 #include <memory>
 #include <vector>
 #include <cmath>
+#include <limits>
+#include <atomic>
 
 namespace librealsense
 {
@@ -202,6 +204,63 @@ namespace librealsense
         std::function<void(const option &)> _record = [](const option &) {};
     };
 
+    class kernel_frame_drops_option : public readonly_option
+    {
+    public:
+        explicit kernel_frame_drops_option(uvc_sensor& ep)
+            : _ep(ep)
+        {
+        }
+
+        float query() const override;
+
+        option_range get_range() const override
+        {
+            return { 0, std::numeric_limits<float>::max(), 1, 0 };
+        }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override
+        {
+            return "Number of frames lost before reaching the library, for lack of free kernel buffers or on the USB link";
+        }
+
+    private:
+        uvc_sensor& _ep;
+    };
+
+    class latency_option : public readonly_option
+    {
+    public:
+        latency_option(const std::atomic<double>* value, std::string desc)
+            : _value(value), _desc(std::move(desc))
+        {
+        }
+
+        // Latencies are reported in milliseconds and saturate at a minute, so that the range stays usable by UIs
+        float query() const override
+        {
+            auto value = _value->load();
+            return static_cast<float>(value < max_latency_ms ? value : max_latency_ms);
+        }
+
+        option_range get_range() const override
+        {
+            return { 0, static_cast<float>(max_latency_ms), 1, 0 };
+        }
+
+        bool is_enabled() const override { return true; }
+
+        const char* get_description() const override { return _desc.c_str(); }
+
+    private:
+        static constexpr double max_latency_ms = 60000;
+
+        const std::atomic<double>* _value;
+        std::string _desc;
+    };
+
     template<typename T>
     class uvc_xu_option : public option
     {
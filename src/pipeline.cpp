@@ -8,11 +8,218 @@
 #include "stream.h"
 #include "media/record/record_device.h"
 #include "media/ros/ros_writer.h"
+#include "environment.h"
 
 namespace librealsense
 {
-    pipeline_processing_block::pipeline_processing_block(const std::vector<int>& streams_to_aggregate) :
+    latest_frameset::latest_frameset()
+        : _middle(1), _back(0), _front(2), _version(0), _waiters(0), _busy_poll_us(0)
+    {
+    }
+
+    void latest_frameset::publish(const std::map<stream_id, frame_holder>& set)
+    {
+        auto& back = _buffers[_back];
+        back.frames.clear();
+        for (auto&& s : set)
+            back.frames.push_back(s.second.clone());
+        swap_back();
+    }
+
+    void latest_frameset::publish(std::vector<frame_holder> frames)
+    {
+        _buffers[_back].frames = std::move(frames);
+        swap_back();
+    }
+
+    void latest_frameset::swap_back()
+    {
+        auto& back = _buffers[_back];
+        back.version = ++_version;
+        back.published_at = _counters.stamp();
+        _counters.on_enqueue(1);
+
+        auto prev = _middle.exchange(_back | FRESH);
+        _back = prev & ~FRESH;
+        if (prev & FRESH)
+        {
+            _counters.on_drop();
+            // The previous set was never read - release its frames now rather than on the next publish
+            LOG_DEBUG("Frameset " << _buffers[_back].version << " was overwritten before being read");
+            _buffers[_back].frames.clear();
+        }
+
+        if (_waiters.load())
+        {
+            std::lock_guard<std::mutex> lock(_wait_mutex);
+            _wait_cv.notify_all();
+        }
+    }
+
+    bool latest_frameset::try_consume(std::vector<frame_holder>* frames, bool woken)
+    {
+        if (!(_middle.load() & FRESH))
+            return false;
+
+        _front = _middle.exchange(_front) & ~FRESH;
+        _counters.on_dequeue(_buffers[_front].published_at);
+        if (woken) _counters.on_wake(_buffers[_front].published_at);
+
+        // Moving element-wise keeps the buffer's capacity for the producer
+        auto& front = _buffers[_front].frames;
+        frames->assign(std::make_move_iterator(front.begin()), std::make_move_iterator(front.end()));
+        front.clear();
+        return true;
+    }
+
+    bool latest_frameset::consume(std::vector<frame_holder>* frames, unsigned int timeout_ms)
+    {
+        if (try_consume(frames))
+            return true;
+
+        const auto fresh = [this]() { return (_middle.load() & FRESH) != 0; };
+        auto timeout = std::chrono::microseconds(timeout_ms * 1000ULL);
+        auto budget = std::min<unsigned long long>(_busy_poll_us, timeout.count());
+        if (budget)
+        {
+            auto start = std::chrono::steady_clock::now();
+            if (busy_poll(static_cast<unsigned int>(budget), fresh))
+                return try_consume(frames, true);
+            timeout -= std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        }
+
+        _waiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(_wait_mutex);
+            _wait_cv.wait_for(lock, timeout, fresh);
+        }
+        _waiters.fetch_sub(1);
+
+        return try_consume(frames, true);
+    }
+
+    const size_t POST_PROCESSING_QUEUE_SIZE = 2;
+
+    post_processing_stage::post_processing_stage(std::vector<std::shared_ptr<processing_block_interface>> blocks,
+                                                 synthetic_source_interface& source,
+                                                 std::function<void(std::vector<frame_holder>)> on_frameset)
+        : _source(source),
+          _on_frameset(on_frameset),
+          _serial(std::make_shared<serial_executor>(environment::get_instance().get_processing_executor()))
+    {
+        for (auto block : blocks)
+        {
+            // The stage already runs off the streaming thread, asynchronous blocks are run inline
+            auto async_block = std::dynamic_pointer_cast<async_processing_block>(block);
+            if (async_block) block = async_block->get_block();
+
+            auto on_output = [this](frame_holder f)
+            {
+                _outputs.push_back(std::move(f));
+            };
+            _previous_callbacks.push_back(block->get_output_callback());
+            block->set_output_callback({
+                new internal_frame_callback<decltype(on_output)>(on_output),
+                [](rs2_frame_callback* p) { p->release(); } });
+
+            _blocks.push_back(block);
+        }
+    }
+
+    post_processing_stage::~post_processing_stage()
+    {
+        _serial->stop();
+
+        // The blocks belong to the application, give them back the outputs they had before streaming
+        // Going backwards restores the original output of a block that was added more than once
+        for (auto i = _blocks.size(); i-- > 0;)
+            _blocks[i]->set_output_callback(_previous_callbacks[i]);
+    }
+
+    void post_processing_stage::invoke(std::vector<frame_holder> frames)
+    {
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _pending.push_back(std::move(frames));
+            if (_pending.size() > POST_PROCESSING_QUEUE_SIZE)
+            {
+                LOG_DEBUG("Post-processing is falling behind, dropping a frameset");
+                _pending.pop_front();
+            }
+        }
+
+        // Every invoke schedules one run, a run that finds nothing pending means its frameset was dropped
+        _serial->post([this]()
+        {
+            std::vector<frame_holder> frames;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                if (_pending.empty()) return;
+                frames = std::move(_pending.front());
+                _pending.pop_front();
+            }
+            process(std::move(frames));
+        });
+    }
+
+    void post_processing_stage::process(std::vector<frame_holder> frames)
+    {
+        for (auto&& block : _blocks)
+        {
+            std::vector<frame_holder> input;
+            for (auto&& f : frames)
+                input.push_back(f.clone());
+
+            frame_holder set = _source.allocate_composite_frame(std::move(input));
+            if (!set)
+            {
+                LOG_ERROR("Failed to allocate composite frame");
+                return;
+            }
+
+            _outputs.clear();
+            block->invoke(std::move(set));
+
+            std::vector<frame_holder> results;
+            for (auto&& out : _outputs)
+            {
+                auto composite = dynamic_cast<composite_frame*>(out.frame);
+                if (!composite)
+                {
+                    results.push_back(std::move(out));
+                    continue;
+                }
+                for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+                {
+                    auto f = composite->get_frame(static_cast<int>(i));
+                    f->acquire();
+                    results.push_back(frame_holder(f));
+                }
+            }
+            _outputs.clear();
+
+            for (auto&& result : results)
+            {
+                auto stream = result->get_stream();
+                auto same_stream = std::find_if(frames.begin(), frames.end(), [&](frame_holder& f)
+                {
+                    return f->get_stream()->get_stream_type() == stream->get_stream_type() &&
+                           f->get_stream()->get_stream_index() == stream->get_stream_index();
+                });
+                if (same_stream != frames.end())
+                    *same_stream = std::move(result);
+                else
+                    frames.push_back(std::move(result));
+            }
+        }
+
+        _on_frameset(std::move(frames));
+    }
+
+    pipeline_processing_block::pipeline_processing_block(const std::vector<int>& streams_to_aggregate, bool latest_only,
+                                                         std::vector<std::shared_ptr<processing_block_interface>> post_processing) :
         _queue(new single_consumer_queue<frame_holder>()),
+        _latest_only(latest_only),
         _streams_ids(streams_to_aggregate)
     {
         auto processing_callback = [&](frame_holder frame, synthetic_source_interface* source)
@@ -22,6 +229,12 @@ namespace librealsense
 
         set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
             new internal_frame_processor_callback<decltype(processing_callback)>(processing_callback)));
+
+        if (post_processing.size())
+        {
+            _post_processing.reset(new post_processing_stage(post_processing, get_source(),
+                [this](std::vector<frame_holder> frames) { deliver(std::move(frames)); }));
+        }
     }
 
     void pipeline_processing_block::handle_frame(frame_holder frame, synthetic_source_interface* source)
@@ -29,6 +242,7 @@ namespace librealsense
         auto comp = dynamic_cast<composite_frame*>(frame.frame);
         if (comp)
         {
+            std::lock_guard<std::mutex> lock(_last_set_mutex);
             for (auto i = 0; i< comp->get_embedded_frames_count(); i++)
             {
                 auto f = comp->get_frame(i);
@@ -42,18 +256,22 @@ namespace librealsense
                     return;
             }
 
+            if (_latest_only && !_post_processing)
+            {
+                _latest.publish(_last_set);
+                return;
+            }
+
             std::vector<frame_holder> set;
             for (auto&& s : _last_set)
             {
                 set.push_back(s.second.clone());
             }
-            auto fref = source->allocate_composite_frame(std::move(set));
-            if (!fref)
-            {
-                LOG_ERROR("Failed to allocate composite frame");
-                return;
-            }
-            _queue->enqueue(fref);
+
+            if (_post_processing)
+                _post_processing->invoke(std::move(set));
+            else
+                deliver(std::move(set));
         }
         else
         {
@@ -62,14 +280,60 @@ namespace librealsense
         }
     }
 
+    void pipeline_processing_block::deliver(std::vector<frame_holder> frames)
+    {
+        if (_latest_only)
+        {
+            _latest.publish(std::move(frames));
+            return;
+        }
+
+        auto fref = make_frameset(std::move(frames));
+        if (fref)
+            _queue->enqueue(std::move(fref));
+    }
+
+    frame_holder pipeline_processing_block::make_frameset(std::vector<frame_holder> frames)
+    {
+        auto fref = get_source().allocate_composite_frame(std::move(frames));
+        if (!fref)
+            LOG_ERROR("Failed to allocate composite frame");
+        return fref;
+    }
+
     bool pipeline_processing_block::dequeue(frame_holder* item, unsigned int timeout_ms)
     {
-        return _queue->dequeue(item, timeout_ms);
+        if (!_latest_only)
+            return _queue->dequeue(item, timeout_ms);
+
+        std::vector<frame_holder> frames;
+        if (!_latest.consume(&frames, timeout_ms))
+            return false;
+        *item = make_frameset(std::move(frames));
+        return *item;
     }
 
     bool pipeline_processing_block::try_dequeue(frame_holder* item)
     {
-        return _queue->try_dequeue(item);
+        if (!_latest_only)
+            return _queue->try_dequeue(item);
+
+        std::vector<frame_holder> frames;
+        if (!_latest.try_consume(&frames))
+            return false;
+        *item = make_frameset(std::move(frames));
+        return *item;
+    }
+
+    void pipeline_processing_block::set_busy_poll(unsigned int budget_us)
+    {
+        _queue->set_busy_poll(budget_us);
+        _latest.set_busy_poll(budget_us);
+    }
+
+    queue_stats pipeline_processing_block::get_stats() const
+    {
+        return _latest_only ? _latest.get_stats() : _queue->get_stats();
     }
 
     /*
@@ -93,6 +357,30 @@ namespace librealsense
         _stream_requests[{stream, index}] = { stream, index, width, height, format, fps };
     }
 
+    void pipeline_config::enable_latest_frameset_only(bool latest_only)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _latest_frameset_only = latest_only;
+    }
+
+    void pipeline_config::enable_busy_poll(unsigned int budget_us)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _busy_poll_us = budget_us;
+    }
+
+    void pipeline_config::add_post_processing_block(std::shared_ptr<processing_block_interface> block)
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _post_processing_blocks.push_back(block);
+    }
+
+    void pipeline_config::clear_post_processing_blocks()
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+        _post_processing_blocks.clear();
+    }
+
     void pipeline_config::enable_all_stream()
     {
         std::lock_guard<std::mutex> lock(_mtx);
@@ -387,21 +675,6 @@ namespace librealsense
         | _|      |__| | _|      |_______||_______||__| |__| \__| |_______|
     */
 
-    template<class T>
-    class internal_frame_callback : public rs2_frame_callback
-    {
-        T on_frame_function;
-    public:
-        explicit internal_frame_callback(T on_frame) : on_frame_function(on_frame) {}
-
-        void on_frame(rs2_frame* fref) override
-        {
-            on_frame_function((frame_interface*)(fref));
-        }
-
-        void release() override { delete this; }
-    };
-
     pipeline::pipeline(std::shared_ptr<librealsense::context> ctx)
         :_ctx(ctx), _hub(ctx)
     {}
@@ -489,7 +762,9 @@ namespace librealsense
         }
 
         _syncer = std::unique_ptr<syncer_proccess_unit>(new syncer_proccess_unit());
-        _pipeline_proccess = std::unique_ptr<pipeline_processing_block>(new pipeline_processing_block(unique_ids));
+        _pipeline_proccess = std::unique_ptr<pipeline_processing_block>(new pipeline_processing_block(unique_ids,
+            conf->get_latest_frameset_only(), conf->get_post_processing_blocks()));
+        _pipeline_proccess->set_busy_poll(conf->get_busy_poll());
 
         auto pipeline_proccess_callback = [&](frame_holder fref)
         {
@@ -600,6 +875,18 @@ namespace librealsense
         return false;
     }
 
+    queue_stats pipeline::get_queue_stats() const
+    {
+        std::lock_guard<std::mutex> lock(_mtx);
+
+        if (!_active_profile)
+        {
+            throw librealsense::wrong_api_call_sequence_exception("get_queue_stats cannot be called before start()");
+        }
+
+        return _pipeline_proccess->get_stats();
+    }
+
     std::shared_ptr<device_interface> pipeline::wait_for_device(const std::chrono::milliseconds& timeout, const std::string& serial)
     {
         // Pipeline's device selection shall be deterministic
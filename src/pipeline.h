@@ -4,25 +4,118 @@
 #pragma once
 
 #include <map>
+#include <deque>
 #include <utility>
+#include <atomic>
+#include <functional>
 
 #include "device_hub.h"
 #include "sync.h"
 #include "config.h"
+#include "executor.h"
 
 namespace librealsense
 {
+    // Single-slot hand-off of the newest complete frameset, implemented as a triple buffer:
+    // the producer fills its back buffer and swaps it with the middle one, the consumer swaps
+    // its front buffer with the middle one, and neither side ever blocks the other
+    // Sets that were not consumed before the next one is published are overwritten
+    class latest_frameset
+    {
+    public:
+        latest_frameset();
+
+        // Producer side, publishes copies of the frames held by the set
+        void publish(const std::map<stream_id, frame_holder>& set);
+        void publish(std::vector<frame_holder> frames);
+
+        // Consumer side, moves the newest unconsumed set into frames
+        bool try_consume(std::vector<frame_holder>* frames, bool woken = false);
+        bool consume(std::vector<frame_holder>* frames, unsigned int timeout_ms);
+
+        void set_busy_poll(unsigned int budget_us) { _busy_poll_us = budget_us; }
+        queue_stats get_stats() const { return _counters.get(); }
+
+    private:
+        static const int FRESH = 4; // Marks a middle buffer that was not consumed yet
+
+        void swap_back();
+
+        struct buffer
+        {
+            std::vector<frame_holder> frames;
+            unsigned long long version = 0;
+            queue_counters::clock::time_point published_at;
+        };
+
+        buffer _buffers[3];
+        std::atomic<int> _middle;
+        int _back;  // Owned by the producer
+        int _front; // Owned by the consumer
+        unsigned long long _version; // Owned by the producer
+
+        std::mutex _wait_mutex;
+        std::condition_variable _wait_cv;
+        std::atomic<int> _waiters;
+        std::atomic<unsigned int> _busy_poll_us;
+        queue_counters _counters;
+    };
+
+    // Applies an ordered list of processing blocks to complete framesets on the shared processing executor,
+    // so that filtering overlaps with the application consuming the previous frameset
+    // Every block receives the whole frameset, and the frames it outputs replace the frames of the same stream,
+    // letting blocks that handle a single stream pass the other streams through
+    // When processing falls behind, the oldest pending frameset is dropped
+    class post_processing_stage
+    {
+    public:
+        post_processing_stage(std::vector<std::shared_ptr<processing_block_interface>> blocks,
+                              synthetic_source_interface& source,
+                              std::function<void(std::vector<frame_holder>)> on_frameset);
+        ~post_processing_stage();
+
+        void invoke(std::vector<frame_holder> frames);
+
+        post_processing_stage(const post_processing_stage&) = delete;
+        post_processing_stage& operator=(const post_processing_stage&) = delete;
+
+    private:
+        void process(std::vector<frame_holder> frames);
+
+        std::vector<std::shared_ptr<processing_block_interface>> _blocks;
+        std::vector<frame_callback_ptr> _previous_callbacks; // Output of every block before the stage took it over
+        synthetic_source_interface& _source;
+        std::function<void(std::vector<frame_holder>)> _on_frameset;
+        std::shared_ptr<serial_executor> _serial;
+
+        std::mutex _mutex;
+        std::deque<std::vector<frame_holder>> _pending;
+        std::vector<frame_holder> _outputs; // Collects the output of the running block, used by the serial executor only
+    };
+
     class processing_block;
     class pipeline_processing_block : public processing_block
     {
+        std::mutex _last_set_mutex;
         std::map<stream_id, frame_holder> _last_set;
         std::unique_ptr<single_consumer_queue<frame_holder>> _queue;
+        latest_frameset _latest;
+        bool _latest_only;
         std::vector<int> _streams_ids;
+        std::unique_ptr<post_processing_stage> _post_processing; // Declared last, it delivers into the members above
         void handle_frame(frame_holder frame, synthetic_source_interface* source);
+        void deliver(std::vector<frame_holder> frames);
+        frame_holder make_frameset(std::vector<frame_holder> frames);
     public:
-        pipeline_processing_block(const std::vector<int>& streams_to_aggregate);
+        // latest_only replaces the frameset queue with a slot holding the newest complete set,
+        // and defers creating the composite frame until the set is actually read
+        // post_processing blocks are applied to every complete set before it is queued
+        pipeline_processing_block(const std::vector<int>& streams_to_aggregate, bool latest_only = false,
+                                  std::vector<std::shared_ptr<processing_block_interface>> post_processing = {});
         bool dequeue(frame_holder* item, unsigned int timeout_ms = 5000);
         bool try_dequeue(frame_holder* item);
+        void set_busy_poll(unsigned int budget_us);
+        queue_stats get_stats() const;
     };
 
     class pipeline;
@@ -51,6 +144,7 @@ namespace librealsense
         std::shared_ptr<pipeline_profile> get_active_profile() const;
         frame_holder wait_for_frames(unsigned int timeout_ms = 5000);
         bool poll_for_frames(frame_holder* frame);
+        queue_stats get_queue_stats() const;
 
         //Non top level API
         std::shared_ptr<device_interface> wait_for_device(const std::chrono::milliseconds& timeout = std::chrono::hours::max(),
@@ -84,6 +178,13 @@ namespace librealsense
         void enable_record_to_file(const std::string& file);
         void disable_stream(rs2_stream stream, int index = -1);
         void disable_all_streams();
+        void enable_latest_frameset_only(bool latest_only);
+        bool get_latest_frameset_only() const { return _latest_frameset_only; }
+        void enable_busy_poll(unsigned int budget_us);
+        unsigned int get_busy_poll() const { return _busy_poll_us; }
+        void add_post_processing_block(std::shared_ptr<processing_block_interface> block);
+        void clear_post_processing_blocks();
+        std::vector<std::shared_ptr<processing_block_interface>> get_post_processing_blocks() const { return _post_processing_blocks; }
         std::shared_ptr<pipeline_profile> resolve(std::shared_ptr<pipeline> pipe, const std::chrono::milliseconds& timeout = std::chrono::milliseconds(0));
         bool can_resolve(std::shared_ptr<pipeline> pipe);
 
@@ -99,6 +200,9 @@ namespace librealsense
             _stream_requests = other._stream_requests;
             _enable_all_streams = other._enable_all_streams;
             _stream_requests = other._stream_requests;
+            _latest_frameset_only = other._latest_frameset_only;
+            _busy_poll_us = other._busy_poll_us;
+            _post_processing_blocks = other._post_processing_blocks;
             _resolved_profile = nullptr;
         }
     private:
@@ -116,6 +220,9 @@ namespace librealsense
         std::map<std::pair<rs2_stream, int>, util::config::request_type> _stream_requests;
         std::mutex _mtx;
         bool _enable_all_streams = false;
+        bool _latest_frameset_only = false;
+        unsigned int _busy_poll_us = 0;
+        std::vector<std::shared_ptr<processing_block_interface>> _post_processing_blocks;
         std::shared_ptr<pipeline_profile> _resolved_profile;
     };
 
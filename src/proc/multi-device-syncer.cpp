@@ -0,0 +1,208 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include "proc/multi-device-syncer.h"
+#include "core/streaming.h"
+#include "sync.h"
+
+#include <cmath>
+
+namespace librealsense
+{
+    // Weight of past samples in the clock fit, giving an effective window of about a thousand frames
+    const double CLOCK_FIT_FORGETTING = 0.999;
+    // Deviation from the fit that is treated as a device clock reset rather than jitter
+    const double CLOCK_RESET_THRESHOLD_MS = 1000.;
+    // Streams that did not deliver frames for this long are no longer waited for
+    const double INACTIVE_STREAM_TIMEOUT_MS = 1000.;
+
+    device_clock_model::device_clock_model()
+        : _initialized(false), _hw_origin(0), _sys_origin(0),
+          _s(0), _sx(0), _sy(0), _sxx(0), _sxy(0),
+          _offset(0), _drift(1)
+    {
+    }
+
+    void device_clock_model::reset(double hardware_ms, double system_ms)
+    {
+        _initialized = true;
+        _hw_origin = hardware_ms;
+        _sys_origin = system_ms;
+        _s = _sx = _sy = _sxx = _sxy = 0;
+        _offset = 0;
+        _drift = 1;
+    }
+
+    void device_clock_model::update(double hardware_ms, double system_ms)
+    {
+        if (!_initialized || std::fabs(to_system_time(hardware_ms) - system_ms) > CLOCK_RESET_THRESHOLD_MS)
+            reset(hardware_ms, system_ms);
+
+        auto x = hardware_ms - _hw_origin;
+        auto y = system_ms - _sys_origin;
+
+        _s = _s * CLOCK_FIT_FORGETTING + 1;
+        _sx = _sx * CLOCK_FIT_FORGETTING + x;
+        _sy = _sy * CLOCK_FIT_FORGETTING + y;
+        _sxx = _sxx * CLOCK_FIT_FORGETTING + x * x;
+        _sxy = _sxy * CLOCK_FIT_FORGETTING + x * y;
+
+        // Until the samples span some time, only the offset can be estimated
+        auto denominator = _s * _sxx - _sx * _sx;
+        if (denominator > 1e-6 * _s * _s)
+            _drift = (_s * _sxy - _sx * _sy) / denominator;
+        _offset = (_sy - _drift * _sx) / _s;
+    }
+
+    double device_clock_model::to_system_time(double hardware_ms) const
+    {
+        return _sys_origin + _offset + _drift * (hardware_ms - _hw_origin);
+    }
+
+    void multi_device_syncer::stream_state::push(frame_holder f, double host_time)
+    {
+        // Drop the oldest frame when the ring is full
+        if (size == QUEUE_MAX_SIZE) pop();
+
+        auto& slot = frames[(head + size) % QUEUE_MAX_SIZE];
+        slot.frame = std::move(f);
+        slot.host_time = host_time;
+        size++;
+    }
+
+    void multi_device_syncer::stream_state::pop()
+    {
+        frames[head].frame = frame_holder();
+        head = (head + 1) % QUEUE_MAX_SIZE;
+        size--;
+    }
+
+    multi_device_syncer::multi_device_syncer(double tolerance_ms, size_t expected_streams)
+        : _tolerance_ms(tolerance_ms), _expected_streams(expected_streams),
+          _all_streams_seen(expected_streams == 0), _first_arrival(0)
+    {
+        auto on_frame = [this](frame_holder frame, synthetic_source_interface* source)
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+
+            auto composite = dynamic_cast<composite_frame*>(frame.frame);
+            if (composite)
+            {
+                for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+                {
+                    auto f = composite->get_frame(static_cast<int>(i));
+                    f->acquire();
+                    add_frame(frame_holder(f));
+                }
+            }
+            else
+            {
+                add_frame(std::move(frame));
+            }
+
+            // Matched sets are delivered outside the lock, the user callback may take a while
+            frame_holder match;
+            while (try_match(&match))
+            {
+                lock.unlock();
+                source->frame_ready(std::move(match));
+                lock.lock();
+            }
+        };
+
+        set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(
+            new internal_frame_processor_callback<decltype(on_frame)>(on_frame)));
+    }
+
+    void multi_device_syncer::add_frame(frame_holder f)
+    {
+        auto arrival = f->get_frame_system_time();
+        auto host_time = f->get_frame_timestamp();
+
+        if (f->get_frame_timestamp_domain() == RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK)
+        {
+            auto sensor = f->get_sensor();
+            auto device = sensor ? &sensor->get_device() : nullptr;
+            auto& clock = _clocks[device];
+            clock.update(host_time, arrival);
+            host_time = clock.to_system_time(host_time);
+        }
+
+        if (!_all_streams_seen && _streams.empty())
+            _first_arrival = arrival;
+
+        auto& stream = _streams[f->get_stream()->get_unique_id()];
+        stream.last_arrival = arrival;
+        stream.push(std::move(f), host_time);
+
+        // A stream that never delivers is waited for as long as one that stopped
+        if (!_all_streams_seen)
+            _all_streams_seen = _streams.size() >= _expected_streams || arrival - _first_arrival > INACTIVE_STREAM_TIMEOUT_MS;
+
+        remove_inactive_streams(arrival);
+    }
+
+    void multi_device_syncer::remove_inactive_streams(double now)
+    {
+        for (auto it = _streams.begin(); it != _streams.end();)
+        {
+            if (now - it->second.last_arrival > INACTIVE_STREAM_TIMEOUT_MS)
+            {
+                LOG_DEBUG("Multi-device syncer stopped waiting for inactive stream " << it->first);
+                it = _streams.erase(it);
+            }
+            else
+                ++it;
+        }
+    }
+
+    bool multi_device_syncer::try_match(frame_holder* result)
+    {
+        if (_streams.empty() || !_all_streams_seen) return false;
+
+        for (auto&& s : _streams)
+        {
+            if (!s.second.size) return false;
+        }
+
+        // The newest head is the best candidate for a set all other streams can still match
+        // Dropping stale heads may expose a newer one, so repeat until the heads settle
+        bool dropped = true;
+        while (dropped)
+        {
+            auto latest = _streams.begin()->second.front().host_time;
+            for (auto&& s : _streams)
+                latest = std::max(latest, s.second.front().host_time);
+
+            dropped = false;
+            for (auto&& s : _streams)
+            {
+                auto& stream = s.second;
+                while (stream.size && stream.front().host_time < latest - _tolerance_ms)
+                {
+                    stream.pop();
+                    dropped = true;
+                }
+                if (!stream.size) return false;
+            }
+        }
+
+        // All heads are now within the tolerance of the newest one
+        // The set only grows when streams are added, so emitting does not allocate beyond the composite frame
+        _set.resize(_streams.size());
+        size_t count = 0;
+        for (auto&& s : _streams)
+        {
+            _set[count++] = std::move(s.second.front().frame);
+            s.second.pop();
+        }
+
+        *result = get_source().allocate_composite_frame(_set.data(), count);
+        if (!*result)
+        {
+            LOG_ERROR("Failed to allocate composite frame");
+            return false;
+        }
+        return true;
+    }
+}
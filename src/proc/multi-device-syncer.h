@@ -0,0 +1,76 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "proc/synthetic-stream.h"
+
+#include <map>
+#include <mutex>
+#include <vector>
+
+namespace librealsense
+{
+    // Maps the hardware clock of one device onto the host clock
+    // The fit is a linear least squares of frame arrival (system) time against hardware timestamp,
+    // with exponential forgetting so that it tracks both the offset and the drift of the device clock
+    class device_clock_model
+    {
+    public:
+        device_clock_model();
+
+        void update(double hardware_ms, double system_ms);
+        double to_system_time(double hardware_ms) const;
+
+    private:
+        void reset(double hardware_ms, double system_ms);
+
+        bool _initialized;
+        double _hw_origin, _sys_origin; // Samples are centered around the first one to keep the sums precise
+        double _s, _sx, _sy, _sxx, _sxy;
+        double _offset, _drift;
+    };
+
+    // Synchronizes the frames of several devices into common framesets
+    // Device timestamps are converted to host time through a per-device clock model,
+    // and a frameset is emitted once every active stream holds a frame within the tolerance of the others
+    // Stream state is kept in fixed-size rings, so steady-state operation does not allocate per frame
+    // Until the expected number of streams delivered, framesets are held back rather than emitted with part of the streams
+    class multi_device_syncer : public processing_block
+    {
+    public:
+        multi_device_syncer(double tolerance_ms, size_t expected_streams);
+
+    private:
+        struct pending_frame
+        {
+            frame_holder frame;
+            double host_time = 0;
+        };
+
+        struct stream_state
+        {
+            pending_frame frames[QUEUE_MAX_SIZE];
+            size_t head = 0;
+            size_t size = 0;
+            double last_arrival = 0;
+
+            pending_frame& front() { return frames[head]; }
+            void push(frame_holder f, double host_time);
+            void pop();
+        };
+
+        void add_frame(frame_holder f);
+        void remove_inactive_streams(double now);
+        bool try_match(frame_holder* result);
+
+        std::mutex _mutex;
+        double _tolerance_ms;
+        size_t _expected_streams;
+        bool _all_streams_seen; // Or stopped waiting for the ones that never delivered
+        double _first_arrival;
+        std::map<const device_interface*, device_clock_model> _clocks;
+        std::map<int, stream_state> _streams;
+        std::vector<frame_holder> _set; // Frames of the set being emitted, reused across sets
+    };
+}
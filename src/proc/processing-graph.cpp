@@ -0,0 +1,218 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include "proc/processing-graph.h"
+#include "proc/synthetic-stream.h"
+#include "proc/syncer-processing-block.h"
+#include "environment.h"
+#include "sync.h"
+
+namespace librealsense
+{
+    processing_graph::processing_graph()
+        : _started(false)
+    {
+    }
+
+    processing_graph::~processing_graph()
+    {
+        for (auto&& n : _nodes)
+            n->serial->stop();
+
+        // Blocks may outlive the graph, they go back to the output they had before joining it
+        for (auto it = _nodes.rbegin(); it != _nodes.rend(); ++it)
+            (*it)->block->set_output_callback((*it)->previous_callback);
+    }
+
+    int processing_graph::add_node(std::shared_ptr<processing_block_interface> block)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        validate_not_started();
+
+        auto n = std::make_shared<node>();
+        n->block = block;
+        n->previous_callback = block->get_output_callback();
+        n->serial = std::make_shared<serial_executor>(environment::get_instance().get_processing_executor());
+
+        // The node is captured raw - it is owned by the graph, which detaches the callback before releasing it
+        auto raw = n.get();
+        auto on_output = [this, raw](frame_holder f)
+        {
+            route(raw->outputs, std::move(f));
+        };
+        block->set_output_callback({
+            new internal_frame_callback<decltype(on_output)>(on_output),
+            [](rs2_frame_callback* p) { p->release(); } });
+
+        _nodes.push_back(n);
+        return static_cast<int>(_nodes.size() - 1);
+    }
+
+    int processing_graph::add_join_node()
+    {
+        return add_node(std::make_shared<syncer_proccess_unit>());
+    }
+
+    void processing_graph::connect(int from, int to, rs2_stream stream, int queue_size)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        validate_not_started();
+        validate_node(from);
+        validate_node(to);
+
+        if (from == to || is_reachable(to, from))
+            throw invalid_value_exception(to_string() << "Connecting node " << from << " to node " << to << " would create a cycle!");
+
+        auto e = std::make_shared<edge>();
+        e->target = _nodes[to];
+        e->stream = stream;
+        e->capacity = queue_size;
+        _nodes[from]->outputs.push_back(e);
+    }
+
+    void processing_graph::connect_input(int to, rs2_stream stream, int queue_size)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        validate_not_started();
+        validate_node(to);
+
+        auto e = std::make_shared<edge>();
+        e->target = _nodes[to];
+        e->stream = stream;
+        e->capacity = queue_size;
+        _inputs.push_back(e);
+    }
+
+    void processing_graph::connect_output(int from, rs2_stream stream)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        validate_not_started();
+        validate_node(from);
+
+        auto e = std::make_shared<edge>();
+        e->stream = stream;
+        e->capacity = 0;
+        _nodes[from]->outputs.push_back(e);
+    }
+
+    void processing_graph::set_output_callback(frame_callback_ptr callback)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _callback = callback;
+    }
+
+    void processing_graph::invoke(frame_holder frame)
+    {
+        // The first frame freezes the topology, edits in progress complete first and later ones are rejected,
+        // so from then on it is read without locking
+        if (!_started)
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            _started = true;
+        }
+        route(_inputs, std::move(frame));
+    }
+
+    void processing_graph::route(const std::vector<std::shared_ptr<edge>>& edges, frame_holder frame)
+    {
+        if (!frame) return;
+
+        auto composite = dynamic_cast<composite_frame*>(frame.frame);
+        for (auto&& e : edges)
+        {
+            if (e->stream == RS2_STREAM_ANY)
+            {
+                push(e, frame.clone());
+            }
+            else if (composite)
+            {
+                for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+                {
+                    auto f = composite->get_frame(static_cast<int>(i));
+                    if (f->get_stream()->get_stream_type() == e->stream)
+                    {
+                        f->acquire();
+                        push(e, frame_holder(f));
+                    }
+                }
+            }
+            else if (frame->get_stream()->get_stream_type() == e->stream)
+            {
+                push(e, frame.clone());
+            }
+        }
+    }
+
+    void processing_graph::push(const std::shared_ptr<edge>& e, frame_holder frame)
+    {
+        if (!e->target)
+        {
+            frame_callback_ptr callback;
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                callback = _callback;
+            }
+            if (callback)
+            {
+                frame_interface* ref = nullptr;
+                std::swap(frame.frame, ref);
+                callback->on_frame((rs2_frame*)ref);
+            }
+            return;
+        }
+
+        {
+            std::lock_guard<std::mutex> lock(e->mutex);
+            e->frames.push_back(std::move(frame));
+            if (e->frames.size() > e->capacity)
+                e->frames.pop_front();
+        }
+
+        // Every push schedules one pop, a pop that finds the edge empty means its frame was dropped
+        auto target = e->target.get();
+        auto edge_ptr = e.get();
+        target->serial->post([target, edge_ptr]()
+        {
+            frame_holder f;
+            {
+                std::lock_guard<std::mutex> lock(edge_ptr->mutex);
+                if (edge_ptr->frames.empty()) return;
+                f = std::move(edge_ptr->frames.front());
+                edge_ptr->frames.pop_front();
+            }
+            target->block->invoke(std::move(f));
+        });
+    }
+
+    void processing_graph::validate_node(int id) const
+    {
+        if (id < 0 || id >= static_cast<int>(_nodes.size()))
+            throw invalid_value_exception(to_string() << "Processing graph has no node " << id << "!");
+    }
+
+    void processing_graph::validate_not_started() const
+    {
+        if (_started)
+            throw wrong_api_call_sequence_exception("Processing graph topology can not change after frames were passed to it!");
+    }
+
+    bool processing_graph::is_reachable(int from, int to) const
+    {
+        std::vector<node*> pending = { _nodes[from].get() };
+        std::vector<node*> visited;
+        while (pending.size())
+        {
+            auto n = pending.back();
+            pending.pop_back();
+            if (n == _nodes[to].get()) return true;
+            if (std::find(visited.begin(), visited.end(), n) != visited.end()) continue;
+            visited.push_back(n);
+
+            for (auto&& e : n->outputs)
+            {
+                if (e->target) pending.push_back(e->target.get());
+            }
+        }
+        return false;
+    }
+}
@@ -0,0 +1,74 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "core/processing.h"
+#include "executor.h"
+
+#include <deque>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <atomic>
+
+namespace librealsense
+{
+    // Directed acyclic graph of processing blocks
+    // Every node runs on the shared processing executor, one frame at a time,
+    // so independent branches of the graph are processed in parallel
+    // Edges carry the frames of a single stream type (or of all streams) through a bounded queue,
+    // and frames fanned-out to several edges are shared by reference rather than copied
+    class processing_graph
+    {
+    public:
+        processing_graph();
+        ~processing_graph();
+
+        int add_node(std::shared_ptr<processing_block_interface> block);
+        int add_join_node();
+
+        void connect(int from, int to, rs2_stream stream, int queue_size);
+        void connect_input(int to, rs2_stream stream, int queue_size);
+        void connect_output(int from, rs2_stream stream);
+
+        void set_output_callback(frame_callback_ptr callback);
+        void invoke(frame_holder frame);
+
+        processing_graph(const processing_graph&) = delete;
+        processing_graph& operator=(const processing_graph&) = delete;
+
+    private:
+        struct node;
+
+        struct edge
+        {
+            std::shared_ptr<node> target; // null for edges leaving the graph
+            rs2_stream stream;
+            size_t capacity;
+
+            std::mutex mutex;
+            std::deque<frame_holder> frames;
+        };
+
+        struct node
+        {
+            std::shared_ptr<processing_block_interface> block;
+            frame_callback_ptr previous_callback; // Output of the block before it joined the graph
+            std::shared_ptr<serial_executor> serial;
+            std::vector<std::shared_ptr<edge>> outputs;
+        };
+
+        void route(const std::vector<std::shared_ptr<edge>>& edges, frame_holder frame);
+        void push(const std::shared_ptr<edge>& e, frame_holder frame);
+        void validate_node(int id) const;
+        void validate_not_started() const;
+        bool is_reachable(int from, int to) const;
+
+        std::mutex _mutex;
+        std::vector<std::shared_ptr<node>> _nodes;
+        std::vector<std::shared_ptr<edge>> _inputs;
+        frame_callback_ptr _callback;
+        std::atomic<bool> _started;
+    };
+}
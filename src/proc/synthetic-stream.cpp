@@ -3,6 +3,7 @@
 
 #include "core/video.h"
 #include "proc/synthetic-stream.h"
+#include "environment.h"
 
 namespace librealsense
 {
@@ -17,6 +18,11 @@ namespace librealsense
         _source.set_callback(callback);
     }
 
+    frame_callback_ptr processing_block::get_output_callback()
+    {
+        return _source.get_callback();
+    }
+
     processing_block::processing_block()
         : _source_wrapper(_source)
     {
@@ -43,6 +49,46 @@ namespace librealsense
         }
     }
 
+    async_processing_block::async_processing_block(std::shared_ptr<processing_block_interface> block)
+        : _block(block),
+          _serial(std::make_shared<serial_executor>(environment::get_instance().get_processing_executor()))
+    {
+    }
+
+    void async_processing_block::set_processing_callback(frame_processor_callback_ptr callback)
+    {
+        _block->set_processing_callback(callback);
+    }
+
+    void async_processing_block::set_output_callback(frame_callback_ptr callback)
+    {
+        _block->set_output_callback(callback);
+    }
+
+    frame_callback_ptr async_processing_block::get_output_callback()
+    {
+        return _block->get_output_callback();
+    }
+
+    void async_processing_block::invoke(frame_holder f)
+    {
+        auto block = _block;
+        _serial->post(std::bind([block](frame_holder& frame)
+        {
+            block->invoke(std::move(frame));
+        }, std::move(f)));
+    }
+
+    void async_processing_block::flush()
+    {
+        _serial->flush();
+    }
+
+    async_processing_block::~async_processing_block()
+    {
+        _serial->stop();
+    }
+
     void synthetic_source::frame_ready(frame_holder result)
     {
         _actual_source.invoke_callback(std::move(result));
@@ -170,12 +216,17 @@ namespace librealsense
     }
 
     frame_interface* synthetic_source::allocate_composite_frame(std::vector<frame_holder> holders)
+    {
+        return allocate_composite_frame(holders.data(), holders.size());
+    }
+
+    frame_interface* synthetic_source::allocate_composite_frame(frame_holder* holders, size_t count)
     {
         frame_additional_data d {};
 
         auto req_size = 0;
-        for (auto&& f : holders)
-            req_size += get_embeded_frames_size(f.frame);
+        for (size_t i = 0; i < count; i++)
+            req_size += get_embeded_frames_size(holders[i].frame);
 
         auto res = _actual_source.alloc_frame(RS2_EXTENSION_COMPOSITE_FRAME, req_size * sizeof(rs2_frame*), d, true);
         if (!res) return nullptr;
@@ -183,8 +234,8 @@ namespace librealsense
         auto cf = static_cast<composite_frame*>(res);
 
         auto frames = cf->get_frames();
-        for (auto&& f : holders)
-            copy_frames(std::move(f), frames);
+        for (size_t i = 0; i < count; i++)
+            copy_frames(std::move(holders[i]), frames);
         frames -= req_size;
 
         auto releaser = [frames, req_size]()
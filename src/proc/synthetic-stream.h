@@ -6,6 +6,7 @@
 #include "core/processing.h"
 #include "image.h"
 #include "source.h"
+#include "executor.h"
 
 namespace librealsense
 {
@@ -26,6 +27,7 @@ namespace librealsense
                                               rs2_extension frame_type = RS2_EXTENSION_VIDEO_FRAME) override;
 
         frame_interface* allocate_composite_frame(std::vector<frame_holder> frames) override;
+        frame_interface* allocate_composite_frame(frame_holder* frames, size_t count) override;
 
         frame_interface* allocate_points(std::shared_ptr<stream_profile_interface> stream, frame_interface* original) override;
 
@@ -45,6 +47,7 @@ namespace librealsense
 
         void set_processing_callback(frame_processor_callback_ptr callback) override;
         void set_output_callback(frame_callback_ptr callback) override;
+        frame_callback_ptr get_output_callback() override;
         void invoke(frame_holder frames) override;
 
         synthetic_source_interface& get_source() override { return _source_wrapper; }
@@ -57,4 +60,31 @@ namespace librealsense
         synthetic_source _source_wrapper;
         rs2_extension _output_type;
     };
+
+    // Runs the wrapped block on the shared processing executor instead of the invoking thread
+    // Frames are processed one at a time and in arrival order, preserving per-stream ordering,
+    // while different blocks are free to run in parallel
+    class async_processing_block : public processing_block_interface
+    {
+    public:
+        explicit async_processing_block(std::shared_ptr<processing_block_interface> block);
+
+        void set_processing_callback(frame_processor_callback_ptr callback) override;
+        void set_output_callback(frame_callback_ptr callback) override;
+        frame_callback_ptr get_output_callback() override;
+        void invoke(frame_holder frame) override;
+
+        synthetic_source_interface& get_source() override { return _block->get_source(); }
+
+        std::shared_ptr<processing_block_interface> get_block() const { return _block; }
+
+        // Waits for the frames invoked so far to be processed
+        void flush();
+
+        // Frames that were not processed yet are released
+        ~async_processing_block();
+    private:
+        std::shared_ptr<processing_block_interface> _block;
+        std::shared_ptr<serial_executor> _serial;
+    };
 }
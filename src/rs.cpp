@@ -21,6 +21,7 @@
 #include "proc/colorizer.h"
 #include "proc/pointcloud.h"
 #include "proc/syncer-processing-block.h"
+#include "proc/multi-device-syncer.h"
 #include "proc/decimation-filter.h"
 #include "proc/spatial-filter.h"
 #include "media/playback/playback_device.h"
@@ -28,7 +29,9 @@
 #include "../include/librealsense2/h/rs_types.h"
 #include "pipeline.h"
 #include "environment.h"
+#include "thread-roles.h"
 #include "proc/temporal-filter.h"
+#include "proc/processing-graph.h"
 
 ////////////////////////
 // API implementation //
@@ -94,12 +97,35 @@ struct rs2_pipeline_profile
 
 struct rs2_frame_queue
 {
-    explicit rs2_frame_queue(int cap)
-        : queue(cap)
+    explicit rs2_frame_queue(int cap,
+                             rs2_frame_queue_type type = RS2_FRAME_QUEUE_TYPE_LOCKING,
+                             rs2_frame_queue_policy policy = RS2_FRAME_QUEUE_POLICY_DROP_OLDEST,
+                             unsigned int block_timeout_ms = 0)
     {
+        queue_policy p = queue_policy::drop_oldest;
+        switch (policy)
+        {
+        case RS2_FRAME_QUEUE_POLICY_DROP_NEWEST: p = queue_policy::drop_newest; break;
+        case RS2_FRAME_QUEUE_POLICY_BLOCK: p = queue_policy::block; break;
+        case RS2_FRAME_QUEUE_POLICY_KEEP_LATEST: p = queue_policy::keep_latest; break;
+        default: break;
+        }
+
+        switch (type)
+        {
+        case RS2_FRAME_QUEUE_TYPE_SINGLE_PRODUCER:
+            queue.reset(new ring_queue<librealsense::frame_holder>(cap, false, p, block_timeout_ms));
+            break;
+        case RS2_FRAME_QUEUE_TYPE_MULTI_PRODUCER:
+            queue.reset(new ring_queue<librealsense::frame_holder>(cap, true, p, block_timeout_ms));
+            break;
+        default:
+            queue.reset(new single_consumer_queue<librealsense::frame_holder>(cap, p, block_timeout_ms));
+            break;
+        }
     }
 
-    single_consumer_queue<librealsense::frame_holder> queue;
+    std::unique_ptr<bounded_queue<librealsense::frame_holder>> queue;
 };
 
 struct rs2_processing_block : public rs2_options
@@ -108,12 +134,22 @@ struct rs2_processing_block : public rs2_options
         : rs2_options((librealsense::options_interface*)block.get()),
           block(block) { }
 
+    // The block is replaced by rs2_set_async_processing while frames may be passing through it
+    std::shared_ptr<librealsense::processing_block_interface> get_block() const { return std::atomic_load(&block); }
+    void set_block(std::shared_ptr<librealsense::processing_block_interface> b) { std::atomic_store(&block, b); }
+
     std::shared_ptr<librealsense::processing_block_interface> block;
+    std::mutex async_mutex;
 
     rs2_processing_block& operator=(const rs2_processing_block&) = delete;
     rs2_processing_block(const rs2_processing_block&) = delete;
 };
 
+struct rs2_processing_graph
+{
+    std::shared_ptr<librealsense::processing_graph> graph;
+};
+
 struct rs2_sensor_list
 {
     rs2_device dev;
@@ -793,6 +829,51 @@ int rs2_get_frame_stride_in_bytes(const rs2_frame* frame_ref, rs2_error** error)
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
 
+static const librealsense::platform::dmabuf_descriptor& get_frame_dmabuf(const rs2_frame* frame_ref)
+{
+    auto dmabuf = ((frame_interface*)frame_ref)->get_dmabuf();
+    if (!dmabuf)
+        throw invalid_value_exception("Frame is not backed by a dma-buf!");
+    return *dmabuf;
+}
+
+int rs2_get_frame_dmabuf_fd(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame_ref);
+    return get_frame_dmabuf(frame_ref).fd;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, frame_ref)
+
+unsigned int rs2_get_frame_dmabuf_offset(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame_ref);
+    return get_frame_dmabuf(frame_ref).offset;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+
+unsigned int rs2_get_frame_dmabuf_stride(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame_ref);
+    return get_frame_dmabuf(frame_ref).stride;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, frame_ref)
+
+void rs2_get_motion_batch(const rs2_frame* frame_ref, rs2_motion_batch* batch, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(frame_ref);
+    VALIDATE_NOT_NULL(batch);
+    auto mf = VALIDATE_INTERFACE(((frame_interface*)frame_ref), librealsense::motion_batch_frame);
+    batch->count = static_cast<int>(mf->get_sample_count());
+    batch->timestamps = mf->get_timestamps();
+    batch->frame_numbers = mf->get_frame_numbers();
+    batch->x = mf->get_axis(0);
+    batch->y = mf->get_axis(1);
+    batch->z = mf->get_axis(2);
+    batch->metadata = mf->get_metadata_size() ? mf->get_metadata() : nullptr;
+    batch->metadata_size = static_cast<int>(mf->get_metadata_size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, frame_ref, batch)
+
 const rs2_stream_profile* rs2_get_frame_stream_profile(const rs2_frame* frame_ref, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame_ref);
@@ -851,6 +932,42 @@ rs2_frame_queue* rs2_create_frame_queue(int capacity, rs2_error** error) BEGIN_A
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity)
 
+rs2_frame_queue* rs2_create_custom_frame_queue(int capacity, rs2_frame_queue_type type,
+                                               rs2_frame_queue_policy policy, unsigned int block_timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(capacity, 1, RS2_USER_QUEUE_SIZE);
+    VALIDATE_ENUM(type);
+    VALIDATE_ENUM(policy);
+    return new rs2_frame_queue(capacity, type, policy, block_timeout_ms);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, capacity, type, policy, block_timeout_ms)
+
+static void to_frame_queue_stats(const queue_stats& s, rs2_frame_queue_stats* stats)
+{
+    stats->enqueued = s.enqueued;
+    stats->dropped = s.dropped;
+    stats->high_water_mark = static_cast<int>(s.high_water_mark);
+    stats->average_residency_ms = s.average_residency_ms;
+    stats->average_wake_latency_us = s.average_wake_latency_us;
+    stats->max_wake_latency_us = s.max_wake_latency_us;
+}
+
+void rs2_get_frame_queue_stats(const rs2_frame_queue* queue, rs2_frame_queue_stats* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_NOT_NULL(stats);
+    to_frame_queue_stats(queue->queue->get_stats(), stats);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, queue, stats)
+
+void rs2_set_frame_queue_busy_poll(rs2_frame_queue* queue, unsigned int budget_us, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_LE(budget_us, 1000000u);
+    queue->queue->set_busy_poll(budget_us);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, queue, budget_us)
+
 void rs2_delete_frame_queue(rs2_frame_queue* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
@@ -862,7 +979,7 @@ rs2_frame* rs2_wait_for_frame(rs2_frame_queue* queue, unsigned int timeout_ms, r
 {
     VALIDATE_NOT_NULL(queue);
     librealsense::frame_holder fh;
-    if (!queue->queue.dequeue(&fh, timeout_ms))
+    if (!queue->queue->dequeue(&fh, timeout_ms))
     {
         throw std::runtime_error("Frame did not arrive in time!");
     }
@@ -878,7 +995,7 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
     VALIDATE_NOT_NULL(queue);
     VALIDATE_NOT_NULL(output_frame);
     librealsense::frame_holder fh;
-    if (queue->queue.try_dequeue(&fh))
+    if (queue->queue->try_dequeue(&fh))
     {
         frame_interface* result = nullptr;
         std::swap(result, fh.frame);
@@ -890,6 +1007,26 @@ int rs2_poll_for_frame(rs2_frame_queue* queue, rs2_frame** output_frame, rs2_err
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, queue, output_frame)
 
+int rs2_dequeue_frames(rs2_frame_queue* queue, rs2_frame** output_frames, int max_frames, unsigned int timeout_ms, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(queue);
+    VALIDATE_NOT_NULL(output_frames);
+    VALIDATE_RANGE(max_frames, 1, RS2_USER_QUEUE_SIZE);
+
+    std::vector<librealsense::frame_holder> frames;
+    frames.reserve(max_frames);
+    queue->queue->dequeue_batch(&frames, max_frames, timeout_ms);
+
+    for (size_t i = 0; i < frames.size(); i++)
+    {
+        frame_interface* result = nullptr;
+        std::swap(result, frames[i].frame);
+        output_frames[i] = (rs2_frame*)result;
+    }
+    return static_cast<int>(frames.size());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, queue, output_frames, max_frames, timeout_ms)
+
 void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(frame);
@@ -897,14 +1034,14 @@ void rs2_enqueue_frame(rs2_frame* frame, void* queue) BEGIN_API_CALL
     auto q = reinterpret_cast<rs2_frame_queue*>(queue);
     librealsense::frame_holder fh;
     fh.frame = (frame_interface*)frame;
-    q->queue.enqueue(std::move(fh));
+    q->queue->enqueue(std::move(fh));
 }
 NOEXCEPT_RETURN(, frame, queue)
 
 void rs2_flush_queue(rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(queue);
-    queue->queue.clear();
+    queue->queue->clear();
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, queue)
 
@@ -1018,11 +1155,15 @@ const char* rs2_camera_info_to_string(rs2_camera_info info) { return librealsens
 
 const char* rs2_frame_metadata_to_string(rs2_frame_metadata_value metadata) { return librealsense::get_string(metadata); }
 const char* rs2_timestamp_domain_to_string(rs2_timestamp_domain info){ return librealsense::get_string(info); }
+const char* rs2_frame_queue_type_to_string(rs2_frame_queue_type type) { return librealsense::get_string(type); }
+const char* rs2_frame_queue_policy_to_string(rs2_frame_queue_policy policy) { return librealsense::get_string(policy); }
 
 const char* rs2_notification_category_to_string(rs2_notification_category category) { return librealsense::get_string(category); }
 
 const char* rs2_sr300_visual_preset_to_string(rs2_sr300_visual_preset preset) { return librealsense::get_string(preset); }
 const char* rs2_log_severity_to_string(rs2_log_severity severity) { return librealsense::get_string(severity); }
+const char* rs2_thread_role_to_string(rs2_thread_role role) { return librealsense::get_string(role); }
+const char* rs2_scheduling_policy_to_string(rs2_scheduling_policy policy) { return librealsense::get_string(policy); }
 const char* rs2_exception_type_to_string(rs2_exception_type type) { return librealsense::get_string(type); }
 const char* rs2_extension_type_to_string(rs2_extension type) { return librealsense::get_string(type); }
 const char* rs2_playback_status_to_string(rs2_playback_status status) { return librealsense::get_string(status); }
@@ -1039,6 +1180,48 @@ void rs2_log_to_file(rs2_log_severity min_severity, const char* file_path, rs2_e
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, min_severity, file_path)
 
+void rs2_set_thread_role_affinity(rs2_thread_role role, unsigned long long cpu_affinity_mask, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(role);
+
+    thread_roles::get_instance().set_affinity(role, cpu_affinity_mask);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, role, cpu_affinity_mask)
+
+void rs2_set_thread_role_scheduling(rs2_thread_role role, rs2_scheduling_policy policy, int priority, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(role);
+    VALIDATE_ENUM(policy);
+    if (policy != RS2_SCHEDULING_POLICY_DEFAULT)
+        VALIDATE_RANGE(priority, 1, 99);
+
+    thread_roles::get_instance().set_scheduling(role, policy, priority);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, role, policy, priority)
+
+void rs2_set_thread_role_name(rs2_thread_role role, const char* name, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_ENUM(role);
+    VALIDATE_NOT_NULL(name);
+
+    thread_roles::get_instance().set_name(role, name);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, role, name)
+
+void rs2_get_stream_latency_stats(const rs2_sensor* sensor, const rs2_stream_profile* profile, rs2_latency_stats* stats, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(sensor);
+    VALIDATE_NOT_NULL(profile);
+    VALIDATE_NOT_NULL(stats);
+    auto s = sensor->sensor->get_latency_stats(profile->profile->get_unique_id());
+    stats->frames = s.frames;
+    stats->average_ms = s.average_ms;
+    stats->min_ms = s.min_ms;
+    stats->max_ms = s.max_ms;
+    stats->last_ms = s.last_ms;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, sensor, profile, stats)
+
 int rs2_is_sensor_extendable_to(const rs2_sensor* sensor, rs2_extension extension_type, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(sensor);
@@ -1091,6 +1274,8 @@ int rs2_is_frame_extendable_to(const rs2_frame* f, rs2_extension extension_type,
         case RS2_EXTENSION_COMPOSITE_FRAME : return VALIDATE_INTERFACE_NO_THROW((frame_interface*)f, librealsense::composite_frame) != nullptr;
         case RS2_EXTENSION_POINTS :          return VALIDATE_INTERFACE_NO_THROW((frame_interface*)f, librealsense::points) != nullptr;
         case RS2_EXTENSION_DEPTH_FRAME:      return VALIDATE_INTERFACE_NO_THROW((frame_interface*)f, librealsense::depth_frame) != nullptr;
+        case RS2_EXTENSION_DMABUF_FRAME:     return ((frame_interface*)f)->get_dmabuf() != nullptr;
+        case RS2_EXTENSION_MOTION_BATCH_FRAME: return VALIDATE_INTERFACE_NO_THROW((frame_interface*)f, librealsense::motion_batch_frame) != nullptr;
         //case RS2_EXTENSION_MOTION_FRAME :  return VALIDATE_INTERFACE_NO_THROW((frame_interface*)f, librealsense::motion_frame) != nullptr;
 
     default:
@@ -1162,6 +1347,33 @@ unsigned long long int rs2_playback_get_position(const rs2_device* device, rs2_e
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, device)
 
+unsigned long long int rs2_playback_get_frame_count(const rs2_device* device, const rs2_stream_profile* stream, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stream);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    return playback->get_frame_count(*stream->profile);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device, stream)
+
+void rs2_playback_seek_to_frame(const rs2_device* device, const rs2_stream_profile* stream, unsigned long long int frame_number, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stream);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->seek_to_frame(*stream->profile, static_cast<size_t>(frame_number));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, frame_number)
+
+void rs2_playback_step_frames(const rs2_device* device, const rs2_stream_profile* stream, int frames, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(stream);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->step_frames(*stream->profile, frames);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, stream, frames)
+
 void rs2_playback_device_resume(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1186,6 +1398,32 @@ void rs2_playback_device_set_real_time(const rs2_device* device, int real_time,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, device)
 
+void rs2_playback_device_set_read_ahead(const rs2_device* device, int max_frames, unsigned long long max_bytes, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(max_frames, 0, static_cast<int>(librealsense::MAX_READ_AHEAD_FRAMES));
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_read_ahead(static_cast<size_t>(max_frames), static_cast<size_t>(max_bytes));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, max_frames, max_bytes)
+
+void rs2_playback_device_set_batch_mode(const rs2_device* device, int batch_mode, int decode_threads, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_RANGE(decode_threads, 0, static_cast<int>(librealsense::MAX_PARALLEL_READERS));
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    playback->set_batch_mode(batch_mode == 0 ? false : true, static_cast<size_t>(decode_threads));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, device, batch_mode, decode_threads)
+
+int rs2_playback_device_is_batch_mode(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    auto playback = VALIDATE_INTERFACE(device->device, librealsense::playback_device);
+    return playback->is_batch_mode() ? 1 : 0;
+}
+HANDLE_EXCEPTIONS_AND_RETURN(0, device)
+
 int rs2_playback_device_is_real_time(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1242,6 +1480,19 @@ rs2_device* rs2_create_record_device(const rs2_device* device, const char* file,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file)
 
+rs2_device* rs2_create_record_device_ex(const rs2_device* device, const char* file, int compression_enabled, unsigned int chunk_threshold, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(device);
+    VALIDATE_NOT_NULL(file);
+
+    return new rs2_device({
+        device->ctx,
+        device->info,
+        std::make_shared<record_device>(device->device, std::make_shared<ros_writer>(file, compression_enabled != 0, chunk_threshold))
+    });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, device, file, compression_enabled, chunk_threshold)
+
 void rs2_record_device_pause(const rs2_device* device, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(device);
@@ -1328,6 +1579,14 @@ int rs2_pipeline_poll_for_frames(rs2_pipeline * pipe, rs2_frame** output_frame,
 }
 HANDLE_EXCEPTIONS_AND_RETURN(0, pipe, output_frame)
 
+void rs2_pipeline_get_queue_stats(rs2_pipeline* pipe, rs2_frame_queue_stats* stats, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(pipe);
+    VALIDATE_NOT_NULL(stats);
+    to_frame_queue_stats(pipe->pipe->get_queue_stats(), stats);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, pipe, stats)
+
 void rs2_delete_pipeline(rs2_pipeline* pipe) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(pipe);
@@ -1469,6 +1728,36 @@ void rs2_config_disable_all_streams(rs2_config* config, rs2_error ** error) BEGI
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, config)
 
+void rs2_config_enable_latest_frameset_only(rs2_config* config, int latest_only, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(config);
+    config->config->enable_latest_frameset_only(latest_only != 0);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, config, latest_only)
+
+void rs2_config_enable_busy_poll(rs2_config* config, unsigned int budget_us, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(config);
+    VALIDATE_LE(budget_us, 1000000u);
+    config->config->enable_busy_poll(budget_us);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, config, budget_us)
+
+void rs2_config_add_post_processing_block(rs2_config* config, rs2_processing_block* block, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(config);
+    VALIDATE_NOT_NULL(block);
+    config->config->add_post_processing_block(block->get_block());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, config, block)
+
+void rs2_config_clear_post_processing_blocks(rs2_config* config, rs2_error ** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(config);
+    config->config->clear_post_processing_blocks();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, config)
+
 rs2_pipeline_profile* rs2_config_resolve(rs2_config* config, rs2_pipeline* pipe, rs2_error ** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(config);
@@ -1502,11 +1791,22 @@ rs2_processing_block* rs2_create_sync_processing_block(rs2_error** error) BEGIN_
 }
 NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
 
+rs2_processing_block* rs2_create_multi_device_sync_processing_block(float tolerance_ms, int streams, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(tolerance_ms, 0.f, 1000.f);
+    VALIDATE_RANGE(streams, 0, 1024);
+
+    auto block = std::make_shared<librealsense::multi_device_syncer>(tolerance_ms, streams);
+
+    return new rs2_processing_block{ block };
+}
+HANDLE_EXCEPTIONS_AND_RETURN(nullptr, tolerance_ms, streams)
+
 void rs2_start_processing(rs2_processing_block* block, rs2_frame_callback* on_frame, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
 
-    block->block->set_output_callback({ on_frame, [](rs2_frame_callback* p) { p->release(); } });
+    block->get_block()->set_output_callback({ on_frame, [](rs2_frame_callback* p) { p->release(); } });
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, block, on_frame)
 
@@ -1516,7 +1816,7 @@ void rs2_start_processing_queue(rs2_processing_block* block, rs2_frame_queue* qu
     VALIDATE_NOT_NULL(queue);
     librealsense::frame_callback_ptr callback(
         new librealsense::frame_callback(rs2_enqueue_frame, queue));
-    block->block->set_output_callback(move(callback));
+    block->get_block()->set_output_callback(move(callback));
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, block, queue)
 
@@ -1525,10 +1825,43 @@ void rs2_process_frame(rs2_processing_block* block, rs2_frame* frame, rs2_error*
     VALIDATE_NOT_NULL(block);
     VALIDATE_NOT_NULL(frame);
 
-    block->block->invoke(frame_holder((frame_interface*)frame));
+    block->get_block()->invoke(frame_holder((frame_interface*)frame));
 }
 HANDLE_EXCEPTIONS_AND_RETURN(, block, frame)
 
+void rs2_set_async_processing(rs2_processing_block* block, int async, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(block);
+
+    std::lock_guard<std::mutex> lock(block->async_mutex);
+    auto current = block->get_block();
+    auto async_block = std::dynamic_pointer_cast<librealsense::async_processing_block>(current);
+    if (async && !async_block)
+        block->set_block(std::make_shared<librealsense::async_processing_block>(current));
+    else if (!async && async_block)
+    {
+        block->set_block(async_block->get_block());
+
+        // Frames already handed to the executor are processed, not dropped, before the call returns
+        async_block->flush();
+    }
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, block, async)
+
+void rs2_configure_processing_executor(int worker_count, unsigned long long cpu_affinity_mask, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_RANGE(worker_count, 0, 256);
+
+    environment::get_instance().get_processing_executor().configure(worker_count, cpu_affinity_mask);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, worker_count, cpu_affinity_mask)
+
+int rs2_get_processing_executor_worker_count(rs2_error** error) BEGIN_API_CALL
+{
+    return static_cast<int>(environment::get_instance().get_processing_executor().get_worker_count());
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(0)
+
 void rs2_delete_processing_block(rs2_processing_block* block) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(block);
@@ -1537,6 +1870,93 @@ void rs2_delete_processing_block(rs2_processing_block* block) BEGIN_API_CALL
 }
 NOEXCEPT_RETURN(, block)
 
+rs2_processing_graph* rs2_create_processing_graph(rs2_error** error) BEGIN_API_CALL
+{
+    return new rs2_processing_graph{ std::make_shared<librealsense::processing_graph>() };
+}
+NOARGS_HANDLE_EXCEPTIONS_AND_RETURN(nullptr)
+
+int rs2_processing_graph_add_node(rs2_processing_graph* graph, rs2_processing_block* block, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_NOT_NULL(block);
+
+    return graph->graph->add_node(block->get_block());
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, graph, block)
+
+int rs2_processing_graph_add_join(rs2_processing_graph* graph, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+
+    return graph->graph->add_join_node();
+}
+HANDLE_EXCEPTIONS_AND_RETURN(-1, graph)
+
+void rs2_processing_graph_connect(rs2_processing_graph* graph, int from, int to, rs2_stream stream, int queue_size, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_ENUM(stream);
+    VALIDATE_RANGE(queue_size, 1, RS2_USER_QUEUE_SIZE);
+
+    graph->graph->connect(from, to, stream, queue_size);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, from, to, stream, queue_size)
+
+void rs2_processing_graph_connect_input(rs2_processing_graph* graph, int to, rs2_stream stream, int queue_size, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_ENUM(stream);
+    VALIDATE_RANGE(queue_size, 1, RS2_USER_QUEUE_SIZE);
+
+    graph->graph->connect_input(to, stream, queue_size);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, to, stream, queue_size)
+
+void rs2_processing_graph_connect_output(rs2_processing_graph* graph, int from, rs2_stream stream, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_ENUM(stream);
+
+    graph->graph->connect_output(from, stream);
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, from, stream)
+
+void rs2_start_processing_graph(rs2_processing_graph* graph, rs2_frame_callback* on_frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+
+    graph->graph->set_output_callback({ on_frame, [](rs2_frame_callback* p) { p->release(); } });
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, on_frame)
+
+void rs2_start_processing_graph_queue(rs2_processing_graph* graph, rs2_frame_queue* queue, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_NOT_NULL(queue);
+    librealsense::frame_callback_ptr callback(
+        new librealsense::frame_callback(rs2_enqueue_frame, queue));
+    graph->graph->set_output_callback(move(callback));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, queue)
+
+void rs2_processing_graph_process_frame(rs2_processing_graph* graph, rs2_frame* frame, rs2_error** error) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+    VALIDATE_NOT_NULL(frame);
+
+    graph->graph->invoke(frame_holder((frame_interface*)frame));
+}
+HANDLE_EXCEPTIONS_AND_RETURN(, graph, frame)
+
+void rs2_delete_processing_graph(rs2_processing_graph* graph) BEGIN_API_CALL
+{
+    VALIDATE_NOT_NULL(graph);
+
+    delete graph;
+}
+NOEXCEPT_RETURN(, graph)
+
 rs2_frame* rs2_extract_frame(rs2_frame* composite, int index, rs2_error** error) BEGIN_API_CALL
 {
     VALIDATE_NOT_NULL(composite);
@@ -14,6 +14,9 @@
 
 namespace librealsense
 {
+    // Upper bound of the motion batch option, keeps a batch frame within a few kilobytes
+    const int MAX_MOTION_BATCH_SIZE = 128;
+
     sensor_base::sensor_base(std::string name, device* dev)
         : _is_streaming(false),
           _is_opened(false),
@@ -27,6 +30,7 @@ namespace librealsense
         register_option(RS2_OPTION_FRAMES_QUEUE_SIZE, _source.get_published_size_option());
 
         register_metadata(RS2_FRAME_METADATA_TIME_OF_ARRIVAL, std::make_shared<librealsense::md_time_of_arrival_parser>());
+        register_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP, std::make_shared<librealsense::md_backend_timestamp_parser>());
 
         register_info(RS2_CAMERA_INFO_NAME, name);
     }
@@ -78,7 +82,53 @@ namespace librealsense
         target->set_unique_id(stream->get_unique_id());
     }
 
+    // Distinct requests remembered per sensor, beyond that the cache starts over
+    const size_t MAX_RESOLVE_CACHE_SIZE = 16;
+
     std::vector<request_mapping> sensor_base::resolve_requests(stream_profiles requests)
+    {
+        // Matching is repeated for every pixel format and unpacker, so a request seen before reuses its result
+        resolve_cache_key key;
+        for (auto&& r : requests)
+        {
+            auto p = to_profile(r.get());
+            key.push_back(std::make_tuple(p.stream, p.index, p.width, p.height, p.fps, p.format));
+        }
+
+        std::lock_guard<std::mutex> lock(_resolve_cache_mutex);
+        auto cached = _resolve_cache.find(key);
+        if (cached != _resolve_cache.end())
+        {
+            auto mapping = cached->second.mapping;
+            for (size_t i = 0; i < mapping.size(); i++)
+            {
+                for (auto index : cached->second.request_indices[i])
+                    mapping[i].original_requests.push_back(requests[index]);
+            }
+            return mapping;
+        }
+
+        auto mapping = match_requests(requests);
+
+        resolved_requests entry;
+        entry.mapping = mapping;
+        for (auto&& m : entry.mapping)
+        {
+            std::vector<size_t> indices;
+            for (auto&& r : m.original_requests)
+                indices.push_back(std::find(requests.begin(), requests.end(), r) - requests.begin());
+            entry.request_indices.push_back(std::move(indices));
+            m.original_requests.clear();
+        }
+
+        if (_resolve_cache.size() >= MAX_RESOLVE_CACHE_SIZE)
+            _resolve_cache.clear();
+        _resolve_cache[key] = std::move(entry);
+
+        return mapping;
+    }
+
+    std::vector<request_mapping> sensor_base::match_requests(stream_profiles requests)
     {
         // per requested profile, find all 4ccs that support that request.
         std::map<int, std::set<uint32_t>> legal_fourccs;
@@ -301,7 +351,13 @@ namespace librealsense
     {
         if (_pixel_formats.end() == std::find_if(_pixel_formats.begin(), _pixel_formats.end(),
             [&pf](const native_pixel_format& cur) { return cur.fourcc == pf.fourcc; }))
+        {
             _pixel_formats.push_back(pf);
+
+            // Cached mappings point into the pixel formats, which may have moved
+            std::lock_guard<std::mutex> lock(_resolve_cache_mutex);
+            _resolve_cache.clear();
+        }
         else
             throw invalid_value_exception(to_string()
                 << "Pixel format " << std::hex << std::setw(8) << std::setfill('0') << pf.fourcc
@@ -312,7 +368,12 @@ namespace librealsense
     {
         auto it = std::find_if(_pixel_formats.begin(), _pixel_formats.end(), [&pf](const native_pixel_format& cur) { return cur.fourcc == pf.fourcc; });
         if (it != _pixel_formats.end())
+        {
             _pixel_formats.erase(it);
+
+            std::lock_guard<std::mutex> lock(_resolve_cache_mutex);
+            _resolve_cache.clear();
+        }
     }
 
     void uvc_sensor::open(const stream_profiles& requests)
@@ -323,11 +384,25 @@ namespace librealsense
         else if (_is_opened)
             throw wrong_api_call_sequence_exception("open(...) failed. UVC device is already opened!");
 
-        auto on = std::unique_ptr<power>(new power(std::dynamic_pointer_cast<uvc_sensor>(shared_from_this())));
+        auto time_service = environment::get_instance().get_time_service();
+        auto open_time = time_service->get_time();
+
+        // A warm restart finds the device still powered from the last session
+        auto on = _power ? std::move(_power)
+                         : std::unique_ptr<power>(new power(std::dynamic_pointer_cast<uvc_sensor>(shared_from_this())));
         _source.init(_metadata_parsers);
         _source.set_sensor(this->shared_from_this());
         auto mapping = resolve_requests(requests);
 
+        std::vector<platform::stream_profile> config;
+        for (auto&& mode : mapping) config.push_back(mode.profile);
+
+        // Only the exact same configuration is restarted warm, anything kept for another one is released
+        if (!_warm_config.empty() && _warm_config != config)
+            _device->enable_warm_restart(false);
+        _warm_config.clear();
+        _device->enable_warm_restart(_warm_restart != 0);
+
         auto timestamp_reader = _timestamp_reader.get();
 
         std::vector<platform::stream_profile> commited;
@@ -336,10 +411,13 @@ namespace librealsense
         {
             try
             {
+                _device->enable_adaptive_buffers(_adaptive_kernel_buffers != 0);
+                _device->enable_dmabuf_export(_export_dmabuf != 0);
                 _device->probe_and_commit(mode.profile,
                 [this, mode, timestamp_reader, requests](platform::stream_profile p, platform::frame_object f, std::function<void()> continuation) mutable
                 {
-                    auto system_time = environment::get_instance().get_time_service()->get_time();
+                    // The driver completion time is not affected by the wake-up and dequeue jitter of the capture thread
+                    auto system_time = f.backend_time ? f.backend_time : environment::get_instance().get_time_service()->get_time();
 
                     if (!this->is_streaming())
                     {
@@ -350,7 +428,14 @@ namespace librealsense
                         return;
                     }
 
+                    if (_awaiting_first_frame.exchange(false))
+                    {
+                        _start_latency_ms = environment::get_instance().get_time_service()->get_time() - _start_time;
+                        LOG_DEBUG(get_info(RS2_CAMERA_INFO_NAME) << " delivered its first frame " << _start_latency_ms << " ms after start");
+                    }
+
                     frame_continuation release_and_enqueue(continuation, f.pixels);
+                    if (f.dmabuf) release_and_enqueue.set_dmabuf(*f.dmabuf);
 
                     // Ignore any frames which appear corrupted or invalid
                     // Determine the timestamp for this frame
@@ -392,6 +477,7 @@ namespace librealsense
                             system_time,
                             static_cast<uint8_t>(f.metadata_size),
                             (const uint8_t*)f.metadata);
+                        additional_data.backend_timestamp = f.backend_time;
 
                         frame_holder frame = _source.alloc_frame(stream_to_frame_types(output.first.type), width * height * bpp / 8, additional_data, requires_processing);
                         if (frame.frame)
@@ -437,7 +523,7 @@ namespace librealsense
                         if (pref->get_stream().get())
                             _source.invoke_callback(std::move(pref));
                     }
-                });
+                }, _kernel_buffers);
             }
             catch(...)
             {
@@ -477,6 +563,9 @@ namespace librealsense
             _is_opened = false;
             throw;
         }
+
+        _open_latency_ms = time_service->get_time() - open_time;
+        LOG_DEBUG(get_info(RS2_CAMERA_INFO_NAME) << " opened in " << _open_latency_ms << " ms");
     }
 
     void uvc_sensor::close()
@@ -492,7 +581,12 @@ namespace librealsense
             _device->close(profile);
         }
         reset_streaming();
-        _power.reset();
+
+        // The backend kept the buffers of a warm restart, which also needs the device to stay powered
+        if (_warm_restart)
+            _warm_config = _internal_config;
+        else
+            _power.reset();
         _is_opened = false;
     }
 
@@ -510,7 +604,10 @@ namespace librealsense
             throw wrong_api_call_sequence_exception("start_streaming(...) failed. UVC device was not opened!");
 
         _source.set_callback(callback);
+        _source.reset_latency_stats();
 
+        _start_time = environment::get_instance().get_time_service()->get_time();
+        _awaiting_first_frame = true;
         _is_streaming = true;
         _device->start_callbacks();
     }
@@ -646,8 +743,14 @@ namespace librealsense
       _hid_device(hid_device),
       _is_configured_stream(RS2_STREAM_COUNT),
       _hid_iio_timestamp_reader(move(hid_iio_timestamp_reader)),
-      _custom_hid_timestamp_reader(move(custom_hid_timestamp_reader))
+      _custom_hid_timestamp_reader(move(custom_hid_timestamp_reader)),
+      _motion_batch_size(1),
+      _motion_batches(RS2_STREAM_COUNT)
     {
+        register_option(RS2_OPTION_MOTION_BATCH_SIZE,
+            std::make_shared<ptr_option<int>>(1, MAX_MOTION_BATCH_SIZE, 1, 1, &_motion_batch_size,
+                                              "Number of motion samples delivered together in one frame, applied on the next stream start"));
+
         std::map<std::string, uint32_t> frequency_per_sensor;
         for (auto& elem : sensor_name_and_hid_profiles)
             frequency_per_sensor.insert(make_pair(elem.first, elem.second.fps));
@@ -783,85 +886,157 @@ namespace librealsense
         _source.set_callback(callback);
         _source.init(_metadata_parsers);
         _source.set_sensor(this->shared_from_this());
+        _source.reset_latency_stats();
 
-        _hid_device->start_capture([this](const platform::sensor_data& sensor_data)
+        auto batch_size = static_cast<size_t>(_motion_batch_size);
+        _hid_device->start_capture([this, batch_size](const platform::sensor_data& sensor_data)
         {
             auto system_time = environment::get_instance().get_time_service()->get_time();
             auto timestamp_reader = _hid_iio_timestamp_reader.get();
 
-            // TODO:
+            // The sensor is resolved once for all the samples that were read together
             static const std::string custom_sensor_name = "custom";
-            auto sensor_name = sensor_data.sensor.name;
-            bool is_custom_sensor = false;
-            static const uint32_t custom_source_id_offset = 16;
-            uint8_t custom_gpio = 0;
-            auto custom_stream_type = RS2_STREAM_ANY;
-            if (sensor_name == custom_sensor_name)
-            {
-                custom_gpio = *(reinterpret_cast<uint8_t*>((uint8_t*)(sensor_data.fo.pixels) + custom_source_id_offset));
-                custom_stream_type = custom_gpio_to_stream_type(custom_gpio);
-
-                if (!_is_configured_stream[custom_stream_type])
-                {
-                    LOG_DEBUG("Unrequested " << rs2_stream_to_string(custom_stream_type) << " frame was dropped.");
-                    return;
-                }
-
-                is_custom_sensor = true;
+            auto&& sensor_name = sensor_data.sensor.name;
+            auto is_custom_sensor = (sensor_name == custom_sensor_name);
+            if (is_custom_sensor)
                 timestamp_reader = _custom_hid_timestamp_reader.get();
-            }
 
             if (!this->is_streaming())
             {
                 LOG_INFO("HID Frame received when Streaming is not active,"
-                            << get_string(_configured_profiles[sensor_name].stream)
+                            << sensor_name
                             << ",Arrived," << std::fixed << system_time);
                 return;
             }
 
-            auto mode = _hid_mapping[sensor_name];
+            auto it = _hid_mapping.find(sensor_name);
+            if (it == _hid_mapping.end())
+            {
+                LOG_WARNING("HID frame of unconfigured sensor " << sensor_name << " was dropped.");
+                return;
+            }
+
+            auto mode = it->second;
             auto request = *(mode.original_requests.begin());
-            auto data_size = sensor_data.fo.frame_size;
-            mode.profile.width = (uint32_t)data_size;
+            mode.profile.width = (uint32_t)sensor_data.fo.frame_size;
             mode.profile.height = 1;
 
-            // Determine the timestamp for this HID frame
-            auto timestamp = timestamp_reader->get_frame_timestamp(mode, sensor_data.fo);
-            auto frame_counter = timestamp_reader->get_frame_counter(mode, sensor_data.fo);
+            auto batched = batch_size > 1 && !is_custom_sensor &&
+                           mode.unpacker->outputs.front().second == RS2_FORMAT_MOTION_XYZ32F;
 
-            frame_additional_data additional_data{};
+            for (uint32_t i = 0; i < sensor_data.sample_count; i++)
+            {
+                auto fo = sensor_data.get_sample(i);
+
+                if (is_custom_sensor)
+                {
+                    static const uint32_t custom_source_id_offset = 16;
+                    auto custom_gpio = *(reinterpret_cast<const uint8_t*>(fo.pixels) + custom_source_id_offset);
+                    auto custom_stream_type = custom_gpio_to_stream_type(custom_gpio);
+
+                    if (!_is_configured_stream[custom_stream_type])
+                    {
+                        LOG_DEBUG("Unrequested " << rs2_stream_to_string(custom_stream_type) << " frame was dropped.");
+                        continue;
+                    }
+                }
+
+                if (batched)
+                    add_to_batch(mode, request, fo, timestamp_reader, system_time, batch_size);
+                else
+                    publish_sample(mode, request, fo, timestamp_reader, system_time);
+            }
+        });
+
+        _is_streaming = true;
+    }
+
+    void hid_sensor::publish_sample(request_mapping& mode, const std::shared_ptr<stream_profile_interface>& request,
+                                    const platform::frame_object& fo, frame_timestamp_reader* timestamp_reader, rs2_time_t system_time)
+    {
+        // Determine the timestamp for this HID frame
+        auto timestamp = timestamp_reader->get_frame_timestamp(mode, fo);
+        auto frame_counter = timestamp_reader->get_frame_counter(mode, fo);
+
+        frame_additional_data additional_data{};
+
+        additional_data.timestamp = timestamp;
+        additional_data.frame_number = frame_counter;
+        additional_data.timestamp_domain = timestamp_reader->get_frame_timestamp_domain(mode, fo);
+        additional_data.system_time = system_time;
+        LOG_DEBUG("FrameAccepted," << get_string(request->get_stream_type()) << "," << std::dec << frame_counter
+                  << ",Arrived," << std::fixed << system_time
+                  << ",TS," << std::fixed << timestamp
+                  << ",TS_Domain," << rs2_timestamp_domain_to_string(additional_data.timestamp_domain));
+
+        auto data_size = fo.frame_size;
+        frame_holder frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, additional_data, true);
+        if (!frame)
+        {
+            LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
+            return;
+        }
+        frame->set_stream(request);
+
+        std::vector<byte*> dest{const_cast<byte*>(frame->get_frame_data())};
+        mode.unpacker->unpack(dest.data(),(const byte*)fo.pixels, (int)data_size);
 
-            additional_data.timestamp = timestamp;
-            additional_data.frame_number = frame_counter;
-            additional_data.timestamp_domain = timestamp_reader->get_frame_timestamp_domain(mode, sensor_data.fo);
+        dispatch_frame(std::move(frame));
+    }
+
+    void hid_sensor::add_to_batch(request_mapping& mode, const std::shared_ptr<stream_profile_interface>& request,
+                                  const platform::frame_object& fo, frame_timestamp_reader* timestamp_reader, rs2_time_t system_time,
+                                  size_t batch_size)
+    {
+        // Every stream is captured by a single thread, which owns its batch
+        auto&& batch = _motion_batches[request->get_stream_type()];
+        if (!batch)
+        {
+            frame_additional_data additional_data{};
+            additional_data.timestamp_domain = timestamp_reader->get_frame_timestamp_domain(mode, fo);
             additional_data.system_time = system_time;
-            LOG_DEBUG("FrameAccepted," << get_string(request->get_stream_type()) << "," << std::dec << frame_counter
-                      << ",Arrived," << std::fixed << system_time
-                      << ",TS," << std::fixed << timestamp
-                      << ",TS_Domain," << rs2_timestamp_domain_to_string(additional_data.timestamp_domain));
-
-            auto frame = _source.alloc_frame(RS2_EXTENSION_MOTION_FRAME, data_size, additional_data, true);
-            frame->set_stream(request);
-            if (!frame)
+
+            // All the samples of a sensor carry metadata of the same size, if any
+            size_t metadata_size = fo.metadata ? fo.metadata_size : 0;
+            batch = _source.alloc_frame(RS2_EXTENSION_MOTION_BATCH_FRAME, motion_batch_frame::get_data_size(batch_size, metadata_size),
+                                        additional_data, true);
+            if (!batch)
             {
                 LOG_INFO("Dropped frame. alloc_frame(...) returned nullptr");
                 return;
             }
+            batch->set_stream(request);
+            static_cast<motion_batch_frame*>(batch.frame)->assign(batch_size, metadata_size);
+        }
 
-            std::vector<byte*> dest{const_cast<byte*>(frame->get_frame_data())};
-            mode.unpacker->unpack(dest.data(),(const byte*)sensor_data.fo.pixels, (int)data_size);
+        float xyz[3];
+        byte* dest[] = { reinterpret_cast<byte*>(xyz) };
+        mode.unpacker->unpack(dest, (const byte*)fo.pixels, (int)fo.frame_size);
 
-            if (_on_before_frame_callback)
-            {
-                auto callback = _source.begin_callback();
-                auto stream_type = frame->get_stream()->get_stream_type();
-                _on_before_frame_callback(stream_type, frame, std::move(callback));
-            }
+        auto motion = static_cast<motion_batch_frame*>(batch.frame);
+        motion->add_sample(xyz, timestamp_reader->get_frame_timestamp(mode, fo), timestamp_reader->get_frame_counter(mode, fo),
+                           fo.metadata_size == motion->get_metadata_size() ? fo.metadata : nullptr);
+        if (!motion->is_full()) return;
 
-            _source.invoke_callback(std::move(frame));
-        });
+        LOG_DEBUG("FrameAccepted," << get_string(request->get_stream_type()) << "," << std::dec << motion->get_frame_number()
+                  << ",Samples," << motion->get_sample_count()
+                  << ",Arrived," << std::fixed << system_time
+                  << ",TS," << std::fixed << motion->get_frame_timestamp());
 
-        _is_streaming = true;
+        dispatch_frame(std::move(batch));
+        batch = frame_holder();
+    }
+
+    void hid_sensor::dispatch_frame(frame_holder frame)
+    {
+        if (_on_before_frame_callback)
+        {
+            auto callback = _source.begin_callback();
+            auto stream_type = frame->get_stream()->get_stream_type();
+            _on_before_frame_callback(stream_type, frame, std::move(callback));
+        }
+
+        _source.invoke_callback(std::move(frame));
     }
 
     void hid_sensor::stop()
@@ -873,6 +1048,11 @@ namespace librealsense
 
         _hid_device->stop_capture();
         _is_streaming = false;
+
+        // Batches that were not filled up by now are dropped
+        for (auto&& batch : _motion_batches)
+            batch = frame_holder();
+
         _source.flush();
         _source.reset();
         _hid_iio_timestamp_reader->reset();
@@ -940,7 +1120,52 @@ namespace librealsense
         : sensor_base(name, dev),
           _device(move(uvc_device)),
           _user_count(0),
-          _timestamp_reader(std::move(timestamp_reader))
+          _timestamp_reader(std::move(timestamp_reader)),
+          _kernel_buffers(DEFAULT_V4L2_FRAME_BUFFERS),
+          _adaptive_kernel_buffers(0),
+          _export_dmabuf(0),
+          _warm_restart(0),
+          _open_latency_ms(0),
+          _start_latency_ms(0),
+          _start_time(0),
+          _awaiting_first_frame(false)
     {
+        if (_device->supports_frame_buffers())
+        {
+            register_option(RS2_OPTION_KERNEL_BUFFER_COUNT,
+                std::make_shared<ptr_option<int>>(2, MAX_V4L2_FRAME_BUFFERS, 1, DEFAULT_V4L2_FRAME_BUFFERS, &_kernel_buffers,
+                                                  "Number of frame buffers the kernel driver captures into, applied on the next stream start"));
+
+            auto adaptive = std::make_shared<ptr_option<int>>(0, 1, 1, 0, &_adaptive_kernel_buffers,
+                                                              "Add kernel frame buffers while streaming whenever the driver drops frames for lack of one");
+            adaptive->on_set([this](float value) { _device->enable_adaptive_buffers(value > 0); });
+            register_option(RS2_OPTION_ADAPTIVE_KERNEL_BUFFERS, adaptive);
+        }
+
+        register_option(RS2_OPTION_KERNEL_FRAME_DROPS, std::make_shared<kernel_frame_drops_option>(*this));
+
+        register_option(RS2_OPTION_EXPORT_DMABUF,
+            std::make_shared<ptr_option<int>>(0, 1, 1, 0, &_export_dmabuf,
+                                              "Capture into frame buffers that can be shared as dma-bufs, applied on the next stream start"));
+
+        auto warm = std::make_shared<ptr_option<int>>(0, 1, 1, 0, &_warm_restart,
+                                                      "Keep the negotiated formats, frame buffers and device power across close and open of the same profiles");
+        warm->on_set([this](float value)
+        {
+            // Nothing is kept any longer, release what the last close left behind
+            std::lock_guard<std::mutex> lock(_configure_lock);
+            if (value == 0 && !_is_opened)
+            {
+                _device->enable_warm_restart(false);
+                _warm_config.clear();
+                _power.reset();
+            }
+        });
+        register_option(RS2_OPTION_WARM_RESTART, warm);
+
+        register_option(RS2_OPTION_OPEN_LATENCY,
+            std::make_shared<latency_option>(&_open_latency_ms, "Time the last open of the sensor took, in milliseconds"));
+        register_option(RS2_OPTION_START_LATENCY,
+            std::make_shared<latency_option>(&_start_latency_ms, "Time from the last start of the sensor to its first frame, in milliseconds"));
     }
 }
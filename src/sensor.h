@@ -66,6 +66,8 @@ namespace librealsense
 
         const device_interface& get_device() override;
 
+        latency_stats get_latency_stats(int stream_id) const override { return _source.get_latency_stats(stream_id); }
+
         void register_pixel_format(native_pixel_format pf);
         void remove_pixel_format(native_pixel_format pf);
 
@@ -94,8 +96,19 @@ namespace librealsense
         device* _owner;
 
     private:
+        std::vector<request_mapping> match_requests(stream_profiles requests);
+
+        typedef std::vector<std::tuple<rs2_stream, int, uint32_t, uint32_t, uint32_t, rs2_format>> resolve_cache_key;
+        struct resolved_requests
+        {
+            std::vector<request_mapping> mapping; // Without the original requests
+            std::vector<std::vector<size_t>> request_indices; // The requests each mapping serves
+        };
+
         lazy<stream_profiles> _profiles;
         std::vector<native_pixel_format> _pixel_formats;
+        std::mutex _resolve_cache_mutex;
+        std::map<resolve_cache_key, resolved_requests> _resolve_cache;
     };
 
     struct frame_timestamp_reader
@@ -150,6 +163,8 @@ namespace librealsense
         std::map<std::string, request_mapping> _hid_mapping;
         std::unique_ptr<frame_timestamp_reader> _hid_iio_timestamp_reader;
         std::unique_ptr<frame_timestamp_reader> _custom_hid_timestamp_reader;
+        int _motion_batch_size;
+        std::vector<frame_holder> _motion_batches; // Batches being filled, per stream type
 
         stream_profiles get_sensor_profiles(std::string sensor_name) const;
 
@@ -158,6 +173,13 @@ namespace librealsense
         uint32_t stream_to_fourcc(rs2_stream stream) const;
 
         uint32_t fps_to_sampling_frequency(rs2_stream stream, uint32_t fps) const;
+
+        void publish_sample(request_mapping& mode, const std::shared_ptr<stream_profile_interface>& request,
+                            const platform::frame_object& fo, frame_timestamp_reader* timestamp_reader, rs2_time_t system_time);
+        void add_to_batch(request_mapping& mode, const std::shared_ptr<stream_profile_interface>& request,
+                          const platform::frame_object& fo, frame_timestamp_reader* timestamp_reader, rs2_time_t system_time,
+                          size_t batch_size);
+        void dispatch_frame(frame_holder frame);
     };
 
     class uvc_sensor : public sensor_base,
@@ -191,6 +213,8 @@ namespace librealsense
         void register_pu(rs2_option id);
         void try_register_pu(rs2_option id);
 
+        unsigned long long get_kernel_frame_drops() const { return _device->get_dropped_frames(); }
+
         void start(frame_callback_ptr callback) override;
 
         void stop() override;
@@ -236,5 +260,14 @@ namespace librealsense
         std::unique_ptr<power> _power;
         std::unique_ptr<frame_timestamp_reader> _timestamp_reader;
         std::shared_ptr<region_of_interest_method> _roi_method = nullptr;
+        int _kernel_buffers;
+        int _adaptive_kernel_buffers;
+        int _export_dmabuf;
+        int _warm_restart;
+        std::vector<platform::stream_profile> _warm_config; // Kept by the backend since the last close
+        std::atomic<double> _open_latency_ms;
+        std::atomic<double> _start_latency_ms;
+        double _start_time;
+        std::atomic<bool> _awaiting_first_frame;
     };
 }
@@ -1,6 +1,7 @@
 // License: Apache 2.0. See LICENSE file in root directory.
 // Copyright(c) 2015 Intel Corporation. All Rights Reserved.
 
+#include <limits>
 #include "source.h"
 #include "option.h"
 #include "environment.h"
@@ -45,7 +46,9 @@ namespace librealsense
             : _callback(nullptr, [](rs2_frame_callback*) {}),
               _max_publish_list_size(16),
               _ts(environment::get_instance().get_time_service())
-    {}
+    {
+        reset_latency_stats();
+    }
 
     void frame_source::init(std::shared_ptr<metadata_parser_map> metadata_parsers)
     {
@@ -54,7 +57,9 @@ namespace librealsense
         std::vector<rs2_extension> supported { RS2_EXTENSION_VIDEO_FRAME,
                                                RS2_EXTENSION_COMPOSITE_FRAME,
                                                RS2_EXTENSION_POINTS,
-                                               RS2_EXTENSION_DEPTH_FRAME };
+                                               RS2_EXTENSION_DEPTH_FRAME,
+                                               RS2_EXTENSION_MOTION_FRAME,
+                                               RS2_EXTENSION_MOTION_BATCH_FRAME };
 
         for (auto type : supported)
         {
@@ -99,6 +104,12 @@ namespace librealsense
         _callback = callback;
     }
 
+    frame_callback_ptr frame_source::get_callback()
+    {
+        std::lock_guard<std::mutex> lock(_callback_mutex);
+        return _callback;
+    }
+
     void frame_source::invoke_callback(frame_holder frame) const
     {
         if (frame)
@@ -106,7 +117,14 @@ namespace librealsense
             auto callback = frame.frame->get_owner()->begin_callback();
             try
             {
-                frame->log_callback_start(_ts ? _ts->get_time() : 0);
+                auto now = _ts ? _ts->get_time() : 0;
+                frame->log_callback_start(now);
+
+                // Without a time service there is no host time to measure the latency against
+                auto backend_time = frame->get_frame_backend_time();
+                if (_ts && backend_time && frame->get_stream())
+                    record_latency(frame->get_stream()->get_unique_id(), now - backend_time);
+
                 if (_callback)
                 {
                     frame_interface* ref = nullptr;
@@ -121,6 +139,65 @@ namespace librealsense
         }
     }
 
+    void frame_source::record_latency(int stream_id, double latency_ms) const
+    {
+        // The slot of the stream, or the first free one claimed for it
+        latency_accumulator* acc = nullptr;
+        for (auto&& slot : _latency)
+        {
+            auto id = slot.stream_id.load();
+            if (id == -1 && slot.stream_id.compare_exchange_strong(id, stream_id)) id = stream_id;
+            if (id == stream_id)
+            {
+                acc = &slot;
+                break;
+            }
+        }
+        if (!acc) return;
+
+        // Streams may be delivered from several threads, so every field is updated atomically on its own
+        auto sum = acc->sum_ms.load();
+        while (!acc->sum_ms.compare_exchange_weak(sum, sum + latency_ms));
+        auto min = acc->min_ms.load();
+        while (latency_ms < min && !acc->min_ms.compare_exchange_weak(min, latency_ms));
+        auto max = acc->max_ms.load();
+        while (latency_ms > max && !acc->max_ms.compare_exchange_weak(max, latency_ms));
+        acc->last_ms = latency_ms;
+        acc->frames++;
+    }
+
+    void frame_source::reset_latency_stats()
+    {
+        // Called before streaming starts, while no frame is delivered
+        for (auto&& slot : _latency)
+        {
+            slot.stream_id = -1;
+            slot.frames = 0;
+            slot.sum_ms = 0;
+            slot.min_ms = std::numeric_limits<double>::max();
+            slot.max_ms = std::numeric_limits<double>::lowest();
+            slot.last_ms = 0;
+        }
+    }
+
+    latency_stats frame_source::get_latency_stats(int stream_id) const
+    {
+        latency_stats stats;
+        for (auto&& slot : _latency)
+        {
+            if (slot.stream_id != stream_id) continue;
+
+            stats.frames = slot.frames;
+            if (!stats.frames) break;
+            stats.average_ms = slot.sum_ms / stats.frames;
+            stats.min_ms = slot.min_ms;
+            stats.max_ms = slot.max_ms;
+            stats.last_ms = slot.last_ms;
+            break;
+        }
+        return stats;
+    }
+
     void frame_source::flush() const
     {
         for (auto&& kvp : _archive)
@@ -12,6 +12,9 @@ namespace librealsense
 {
     class option;
 
+    // Streams of one source whose latency is measured, frames of further streams are not measured
+    const int MAX_LATENCY_STREAMS = 16;
+
     class frame_source
     {
     public:
@@ -24,10 +27,12 @@ namespace librealsense
         void reset();
 
         std::shared_ptr<option> get_published_size_option();
+        void set_max_published_frames(uint32_t count) { _max_publish_list_size = count; }
 
         frame_interface* alloc_frame(rs2_extension type, size_t size, frame_additional_data additional_data, bool requires_memory) const;
 
         void set_callback(frame_callback_ptr callback);
+        frame_callback_ptr get_callback();
 
         void invoke_callback(frame_holder frame) const;
 
@@ -39,9 +44,26 @@ namespace librealsense
 
         void set_sensor(std::shared_ptr<sensor_interface> s);
 
+        // Statistics of the frames of a stream delivered since the last reset, only frames timestamped by the backend are measured
+        latency_stats get_latency_stats(int stream_id) const;
+        void reset_latency_stats();
+
     private:
         friend class syncer_proccess_unit;
 
+        // Updated without a lock on every delivery, so the fields of a slot are read one at a time
+        struct latency_accumulator
+        {
+            std::atomic<int> stream_id; // -1 while the slot is free
+            std::atomic<unsigned long long> frames;
+            std::atomic<double> sum_ms;
+            std::atomic<double> min_ms;
+            std::atomic<double> max_ms;
+            std::atomic<double> last_ms;
+        };
+
+        void record_latency(int stream_id, double latency_ms) const;
+
         std::mutex _callback_mutex;
 
         std::map<rs2_extension, std::shared_ptr<archive_interface>> _archive;
@@ -49,5 +71,7 @@ namespace librealsense
         std::atomic<uint32_t> _max_publish_list_size;
         frame_callback_ptr _callback;
         std::shared_ptr<platform::time_service> _ts;
+
+        mutable latency_accumulator _latency[MAX_LATENCY_STREAMS];
     };
 }
@@ -72,9 +72,7 @@ namespace librealsense
 
     void identity_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<_name<<"--> "<< f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", "<<std::fixed<< f->get_frame_timestamp()<<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG(_name << "--> " << f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", " << std::fixed << f->get_frame_timestamp());
 
         sync(std::move(f), env);
     }
@@ -116,9 +114,7 @@ namespace librealsense
 
     void composite_matcher::dispatch(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<"DISPATCH "<<_name<<"--> "<< f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", "<<std::fixed<< f->get_frame_timestamp()<<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG("DISPATCH " << _name << "--> " << f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", " << std::fixed << f->get_frame_timestamp());
 
         clean_inactive_streams(f);
         auto matcher = find_matcher(f);
@@ -218,19 +214,19 @@ namespace librealsense
 
     void composite_matcher::sync(frame_holder f, syncronization_environment env)
     {
-        std::stringstream s;
-        s <<"SYNC "<<_name<<"--> "<< f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", "<<std::fixed<< f->get_frame_timestamp()<<"\n";
-        LOG_DEBUG(s.str());
+        LOG_DEBUG("SYNC " << _name << "--> " << f->get_stream()->get_stream_type() << " " << f->get_frame_number() << ", " << std::fixed << f->get_frame_timestamp());
 
         update_next_expected(f);
         auto matcher = find_matcher(f);
         _frames_queue[matcher.get()].enqueue(std::move(f));
 
-        std::vector<frame_holder*> frames_arrived;
-        std::vector<librealsense::matcher*> frames_arrived_matchers;
-        std::vector<librealsense::matcher*> synced_frames;
-        std::vector<librealsense::matcher*> missing_streams;
+        auto& frames_arrived = _frames_arrived;
+        auto& frames_arrived_matchers = _frames_arrived_matchers;
+        auto& synced_frames = _synced_frames;
+        auto& missing_streams = _missing_streams;
 
+        // Every pass peeks at the front of the ring of every stream, so an arrival costs a scan of all the streams
+        // for each set it completes, candidates are not indexed by stream
         do
         {
             auto old_frames = false;
@@ -298,8 +294,8 @@ namespace librealsense
 
             if (synced_frames.size())
             {
-                std::vector<frame_holder> match;
-                match.reserve(synced_frames.size());
+                auto& match = _match;
+                match.clear();
 
                 for (auto index : synced_frames)
                 {
@@ -315,32 +311,32 @@ namespace librealsense
                 });
 
 
-                std::stringstream s;
-                s<<"MATCHED: ";
-                for(auto&& f: match)
+                if (log_enabled(RS2_LOG_SEVERITY_DEBUG))
                 {
-                    auto composite = dynamic_cast<composite_frame*>(f.frame);
-                    if(composite)
+                    std::stringstream s;
+                    s<<"MATCHED: ";
+                    for(auto&& f: match)
                     {
-                        for (int i = 0; i < composite->get_embedded_frames_count(); i++)
+                        auto composite = dynamic_cast<composite_frame*>(f.frame);
+                        if(composite)
                         {
-                            auto matched = composite->get_frame(i);
-                            s << matched->get_stream()->get_stream_type()<<" "<<f->get_frame_number()<<" "<<matched->get_frame_timestamp()<<" ";
+                            for (int i = 0; i < composite->get_embedded_frames_count(); i++)
+                            {
+                                auto matched = composite->get_frame(i);
+                                s << matched->get_stream()->get_stream_type()<<" "<<f->get_frame_number()<<" "<<matched->get_frame_timestamp()<<" ";
+                            }
+                        }
+                        else {
+                             s<<f->get_stream()->get_stream_type()<<" "<<f->get_frame_number()<<" "<<(double)f->get_frame_timestamp()<<" ";
                         }
                     }
-                    else {
-                         s<<f->get_stream()->get_stream_type()<<" "<<f->get_frame_number()<<" "<<(double)f->get_frame_timestamp()<<" ";
-                    }
-
-
+                    LOG_DEBUG(s.str());
                 }
-                s<<"\n";
-                LOG_DEBUG(s.str());
-                frame_holder composite = env.source->allocate_composite_frame(std::move(match));
+
+                frame_holder composite = env.source->allocate_composite_frame(match.data(), match.size());
+                match.clear();
                 if (composite.frame)
                 {
-                    s <<"SYNCED "<<_name<<"--> "<< composite->get_stream()->get_stream_type() << " " << composite->get_frame_number() << ", "<<std::fixed<< composite->get_frame_timestamp()<<"\n";
-
                     auto cb = begin_callback();
                     _callback(std::move(composite), env);
                 }
@@ -369,7 +365,7 @@ namespace librealsense
     void frame_number_composite_matcher::clean_inactive_streams(frame_holder& f)
     {
         std::vector<stream_id> inactive_matchers;
-        for(auto m: _matchers)
+        for(auto&& m: _matchers)
         {
             if(_last_arrived[m.second.get()] && (f->get_frame_number() - _last_arrived[m.second.get()]) > 5)
             {
@@ -384,7 +380,7 @@ namespace librealsense
         }
     }
 
-    bool frame_number_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool frame_number_composite_matcher::skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing)
     {
         frame_holder* synced_frame;
 
@@ -467,7 +463,7 @@ namespace librealsense
     {
         std::vector<stream_id> dead_matchers;
         auto now = std::chrono::duration<double, std::milli>(std::chrono::system_clock::now().time_since_epoch()).count();
-        for(auto m: _matchers)
+        for(auto&& m: _matchers)
         {
             if(_last_arrived[m.second.get()] && (now - _last_arrived[m.second.get()]) > 500)
             {
@@ -483,7 +479,7 @@ namespace librealsense
         }
     }
 
-    bool timestamp_composite_matcher::skip_missing_stream(std::vector<matcher*> synced, matcher* missing)
+    bool timestamp_composite_matcher::skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing)
     {
         if(!missing->get_active())
             return true;
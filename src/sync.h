@@ -32,6 +32,21 @@ namespace librealsense
         void release() override { delete this; }
     };
 
+    template<class T>
+    class internal_frame_callback : public rs2_frame_callback
+    {
+        T on_frame_function;
+    public:
+        explicit internal_frame_callback(T on_frame) : on_frame_function(on_frame) {}
+
+        void on_frame(rs2_frame* fref) override
+        {
+            on_frame_function((frame_interface*)(fref));
+        }
+
+        void release() override { delete this; }
+    };
+
     class sync_lock
     {
     public:
@@ -70,6 +85,67 @@ namespace librealsense
 
     class synthetic_source_interface;
 
+    // Fixed-capacity FIFO of the frames of one stream waiting for a match
+    // Frames of a stream arrive in timestamp order, so the front of the ring is always the oldest candidate
+    // Storage is allocated once. The ring has no synchronization of its own, it relies on matchers being driven under the syncer lock
+    class frame_ring
+    {
+    public:
+        frame_ring() : _head(0), _size(0), _accepting(true) {}
+
+        void enqueue(frame_holder&& item)
+        {
+            if (!_accepting) return;
+
+            if (_size == QUEUE_MAX_SIZE)
+            {
+                // Drop the oldest frame, same as single_consumer_queue does
+                _frames[_head] = frame_holder();
+                _head = (_head + 1) % QUEUE_MAX_SIZE;
+                _size--;
+            }
+            _frames[(_head + _size) % QUEUE_MAX_SIZE] = std::move(item);
+            _size++;
+        }
+
+        bool peek(frame_holder** item)
+        {
+            if (!_size) return false;
+            *item = &_frames[_head];
+            return true;
+        }
+
+        bool dequeue(frame_holder* item)
+        {
+            if (!_size) return false;
+            *item = std::move(_frames[_head]);
+            _head = (_head + 1) % QUEUE_MAX_SIZE;
+            _size--;
+            return true;
+        }
+
+        // Releases all frames and rejects new ones until start is called
+        void clear()
+        {
+            _accepting = false;
+            while (_size)
+            {
+                frame_holder f;
+                dequeue(&f);
+            }
+        }
+
+        void start() { _accepting = true; }
+
+        size_t size() const { return _size; }
+
+    private:
+        frame_holder _frames[QUEUE_MAX_SIZE];
+        size_t _head;
+        size_t _size;
+        bool _accepting;
+    };
+
     struct syncronization_environment
     {
         synthetic_source_interface* source;
@@ -136,7 +212,7 @@ namespace librealsense
 
         virtual bool are_equivalent(frame_holder& a, frame_holder& b) = 0;
         virtual bool is_smaller_than(frame_holder& a, frame_holder& b) = 0;
-        virtual bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing)  = 0;
+        virtual bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing)  = 0;
         virtual void clean_inactive_streams(frame_holder& f) = 0;
         virtual void update_last_arrived(frame_holder& f, matcher* m) = 0;
 
@@ -147,10 +223,18 @@ namespace librealsense
     protected:
         virtual void update_next_expected(const frame_holder& f) = 0;
 
-        std::map<matcher*, single_consumer_queue<frame_holder>> _frames_queue;
+        std::map<matcher*, frame_ring> _frames_queue;
         std::map<stream_id, std::shared_ptr<matcher>> _matchers;
         std::map<matcher*, double> _next_expected;
         std::map<matcher*, rs2_timestamp_domain> _next_expected_domain;
+
+    private:
+        // Scratch buffers of sync, kept across arrivals so that they are not allocated again for every frame
+        std::vector<frame_holder*> _frames_arrived;
+        std::vector<matcher*> _frames_arrived_matchers;
+        std::vector<matcher*> _synced_frames;
+        std::vector<matcher*> _missing_streams;
+        std::vector<frame_holder> _match;
     };
 
     class frame_number_composite_matcher : public composite_matcher
@@ -160,7 +244,7 @@ namespace librealsense
         virtual void update_last_arrived(frame_holder& f, matcher* m) override;
         bool are_equivalent(frame_holder& a, frame_holder& b) override;
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
+        bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) override;
         void clean_inactive_streams(frame_holder& f) override;
         void update_next_expected(const frame_holder& f) override;
 
@@ -176,7 +260,7 @@ namespace librealsense
         bool is_smaller_than(frame_holder& a, frame_holder& b) override;
         virtual void update_last_arrived(frame_holder& f, matcher* m) override;
         void clean_inactive_streams(frame_holder& f) override;
-        bool skip_missing_stream(std::vector<matcher*> synced, matcher* missing) override;
+        bool skip_missing_stream(const std::vector<matcher*>& synced, matcher* missing) override;
         void update_next_expected(const frame_holder & f) override;
 
     private:
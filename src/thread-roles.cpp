@@ -0,0 +1,106 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#include "thread-roles.h"
+#include "executor.h"
+#include "types.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace librealsense
+{
+    // Linux limits thread names to 15 characters
+    const size_t MAX_THREAD_NAME_LENGTH = 15;
+
+    thread_roles& thread_roles::get_instance()
+    {
+        static thread_roles instance;
+        return instance;
+    }
+
+    thread_roles::thread_roles()
+    {
+        // Default names make the library threads recognizable in top, perf and debuggers
+        _configs[RS2_THREAD_ROLE_CAPTURE].name = "rs-capture";
+        _configs[RS2_THREAD_ROLE_MOTION_CAPTURE].name = "rs-motion";
+        _configs[RS2_THREAD_ROLE_DISPATCH].name = "rs-dispatch";
+        _configs[RS2_THREAD_ROLE_PLAYBACK].name = "rs-playback";
+        _configs[RS2_THREAD_ROLE_RECORD].name = "rs-record";
+        _configs[RS2_THREAD_ROLE_AUTO_EXPOSURE].name = "rs-auto-exp";
+        _configs[RS2_THREAD_ROLE_DEVICE_WATCHER].name = "rs-dev-watch";
+        _configs[RS2_THREAD_ROLE_PROCESSING].name = "rs-processing";
+    }
+
+    void thread_roles::set_affinity(rs2_thread_role role, unsigned long long cpu_affinity_mask)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _configs[role].cpu_affinity_mask = cpu_affinity_mask;
+    }
+
+    void thread_roles::set_scheduling(rs2_thread_role role, rs2_scheduling_policy policy, int priority)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _configs[role].policy = policy;
+        _configs[role].priority = priority;
+    }
+
+    void thread_roles::set_name(rs2_thread_role role, const std::string& name)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _configs[role].name = name.substr(0, MAX_THREAD_NAME_LENGTH);
+    }
+
+    thread_role_config thread_roles::get_config(rs2_thread_role role) const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _configs[role];
+    }
+
+    static void set_current_thread_name(const std::string& name)
+    {
+        if (name.empty()) return;
+#if defined(__linux__)
+        if (pthread_setname_np(pthread_self(), name.c_str()))
+            LOG_WARNING("Could not set thread name " << name);
+#endif
+    }
+
+    // The default policy is applied explicitly as well, since threads inherit the policy of the thread creating them,
+    // and library threads are often spawned from a real-time capture thread
+    static void set_current_thread_scheduling(rs2_scheduling_policy policy, int priority)
+    {
+#ifdef _WIN32
+        // Windows has no real-time policies for single threads, the closest is a raised priority
+        auto level = (policy == RS2_SCHEDULING_POLICY_DEFAULT) ? THREAD_PRIORITY_NORMAL :
+                     (priority >= 50) ? THREAD_PRIORITY_TIME_CRITICAL : THREAD_PRIORITY_HIGHEST;
+        if (!SetThreadPriority(GetCurrentThread(), level))
+            LOG_WARNING("Could not set thread priority");
+#elif defined(__linux__)
+        auto native_policy = (policy == RS2_SCHEDULING_POLICY_DEFAULT) ? SCHED_OTHER :
+                             (policy == RS2_SCHEDULING_POLICY_FIFO) ? SCHED_FIFO : SCHED_RR;
+        sched_param param = {};
+        param.sched_priority = std::max(sched_get_priority_min(native_policy),
+                                        std::min(priority, sched_get_priority_max(native_policy)));
+        // Real-time policies usually require CAP_SYS_NICE or an RLIMIT_RTPRIO allowance, leaving them never does
+        if (auto res = pthread_setschedparam(pthread_self(), native_policy, &param))
+            LOG_WARNING("Could not set " << get_string(policy) << " scheduling with priority " << param.sched_priority
+                        << ", error " << res);
+#else
+        if (policy != RS2_SCHEDULING_POLICY_DEFAULT)
+            LOG_WARNING("Thread scheduling policies are not supported on this platform");
+#endif
+    }
+
+    void apply_thread_role(rs2_thread_role role)
+    {
+        auto config = thread_roles::get_instance().get_config(role);
+        set_current_thread_name(config.name);
+        set_current_thread_affinity(config.cpu_affinity_mask);
+        set_current_thread_scheduling(config.policy, config.priority);
+    }
+}
@@ -0,0 +1,48 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+#pragma once
+
+#include "../include/librealsense2/h/rs_types.h"
+
+#include <mutex>
+#include <string>
+
+namespace librealsense
+{
+    struct thread_role_config
+    {
+        unsigned long long cpu_affinity_mask = 0;
+        rs2_scheduling_policy policy = RS2_SCHEDULING_POLICY_DEFAULT;
+        int priority = 0;
+        std::string name;
+    };
+
+    // Library-wide placement of the threads spawned by librealsense
+    // Every thread belongs to one role and picks up the configuration of that role when it starts,
+    // so changes affect the threads spawned afterwards (typically on the next open or start)
+    class thread_roles
+    {
+    public:
+        static thread_roles& get_instance();
+
+        void set_affinity(rs2_thread_role role, unsigned long long cpu_affinity_mask);
+        void set_scheduling(rs2_thread_role role, rs2_scheduling_policy policy, int priority);
+        void set_name(rs2_thread_role role, const std::string& name);
+
+        thread_role_config get_config(rs2_thread_role role) const;
+
+        thread_roles(const thread_roles&) = delete;
+        thread_roles& operator=(const thread_roles&) = delete;
+
+    private:
+        thread_roles();
+
+        mutable std::mutex _mutex;
+        thread_role_config _configs[RS2_THREAD_ROLE_COUNT];
+    };
+
+    // Applies the configuration of the role to the calling thread
+    // Meant to be the first thing a library thread does, failures are logged and otherwise ignored
+    void apply_thread_role(rs2_thread_role role);
+}
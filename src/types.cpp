@@ -167,6 +167,8 @@ namespace librealsense
             CASE(RECORD)
             CASE(VIDEO_PROFILE)
             CASE(PLAYBACK)
+            CASE(DMABUF_FRAME)
+            CASE(MOTION_BATCH_FRAME)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
         #undef CASE
@@ -186,6 +188,33 @@ namespace librealsense
 #undef CASE
     }
 
+    const char* get_string(rs2_frame_queue_type value)
+    {
+#define CASE(X) STRCASE(FRAME_QUEUE_TYPE, X)
+        switch (value)
+        {
+            CASE(LOCKING)
+            CASE(SINGLE_PRODUCER)
+            CASE(MULTI_PRODUCER)
+            default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_frame_queue_policy value)
+    {
+#define CASE(X) STRCASE(FRAME_QUEUE_POLICY, X)
+        switch (value)
+        {
+            CASE(DROP_OLDEST)
+            CASE(DROP_NEWEST)
+            CASE(BLOCK)
+            CASE(KEEP_LATEST)
+            default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_log_severity value)
     {
 #define CASE(X) STRCASE(LOG_SEVERITY, X)
@@ -203,6 +232,37 @@ namespace librealsense
         #undef CASE
     }
 
+    const char* get_string(rs2_thread_role value)
+    {
+#define CASE(X) STRCASE(THREAD_ROLE, X)
+        switch (value)
+        {
+            CASE(CAPTURE)
+            CASE(MOTION_CAPTURE)
+            CASE(DISPATCH)
+            CASE(PLAYBACK)
+            CASE(RECORD)
+            CASE(AUTO_EXPOSURE)
+            CASE(DEVICE_WATCHER)
+            CASE(PROCESSING)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
+    const char* get_string(rs2_scheduling_policy value)
+    {
+#define CASE(X) STRCASE(SCHEDULING_POLICY, X)
+        switch (value)
+        {
+            CASE(DEFAULT)
+            CASE(FIFO)
+            CASE(ROUND_ROBIN)
+        default: assert(!is_valid(value)); return UNKNOWN_VALUE;
+        }
+#undef CASE
+    }
+
     const char* get_string(rs2_option value)
     {
 #define CASE(X) STRCASE(OPTION, X)
@@ -247,6 +307,14 @@ namespace librealsense
         CASE(FILTER_MAGNITUDE)
         CASE(FILTER_SMOOTH_ALPHA)
         CASE(FILTER_SMOOTH_DELTA)
+        CASE(KERNEL_BUFFER_COUNT)
+        CASE(ADAPTIVE_KERNEL_BUFFERS)
+        CASE(KERNEL_FRAME_DROPS)
+        CASE(EXPORT_DMABUF)
+        CASE(MOTION_BATCH_SIZE)
+        CASE(WARM_RESTART)
+        CASE(OPEN_LATENCY)
+        CASE(START_LATENCY)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
         #undef CASE
@@ -326,6 +394,7 @@ namespace librealsense
         CASE(AUTO_EXPOSURE)
         CASE(WHITE_BALANCE)
         CASE(TIME_OF_ARRIVAL)
+        CASE(BACKEND_TIMESTAMP)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
         #undef CASE
@@ -338,6 +407,7 @@ namespace librealsense
         {
         CASE(HARDWARE_CLOCK)
         CASE(SYSTEM_TIME)
+        CASE(BACKEND_TIME)
         default: assert(!is_valid(value)); return UNKNOWN_VALUE;
         }
         #undef CASE
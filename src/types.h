@@ -23,6 +23,7 @@
 #include <algorithm>
 #include <condition_variable>
 #include <functional>
+#include <atomic>
 #include "backend.h"
 
 #include "concurrency.h"
@@ -64,10 +65,23 @@ namespace librealsense
     void log_to_console(rs2_log_severity min_severity);
     void log_to_file(rs2_log_severity min_severity, const char * file_path);
 
-#define LOG_DEBUG(...)   do { CLOG(DEBUG   ,"librealsense") << __VA_ARGS__; } while(false)
-#define LOG_INFO(...)    do { CLOG(INFO    ,"librealsense") << __VA_ARGS__; } while(false)
-#define LOG_WARNING(...) do { CLOG(WARNING ,"librealsense") << __VA_ARGS__; } while(false)
-#define LOG_ERROR(...)   do { CLOG(ERROR   ,"librealsense") << __VA_ARGS__; } while(false)
+    // Lowest severity any of the log outputs accepts, RS2_LOG_SEVERITY_NONE while logging is off
+    extern std::atomic<int> log_severity_threshold;
+
+    // Checked by the LOG_* macros before the message is formatted,
+    // so that disabled log statements cost a single relaxed load
+    inline bool log_enabled(rs2_log_severity severity)
+    {
+#ifdef STRIP_DEBUG_LOGS
+        if (severity <= RS2_LOG_SEVERITY_DEBUG) return false;
+#endif
+        return severity >= log_severity_threshold.load(std::memory_order_relaxed);
+    }
+
+#define LOG_DEBUG(...)   do { if (librealsense::log_enabled(RS2_LOG_SEVERITY_DEBUG)) CLOG(DEBUG   ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_INFO(...)    do { if (librealsense::log_enabled(RS2_LOG_SEVERITY_INFO))  CLOG(INFO    ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_WARNING(...) do { if (librealsense::log_enabled(RS2_LOG_SEVERITY_WARN))  CLOG(WARNING ,"librealsense") << __VA_ARGS__; } while(false)
+#define LOG_ERROR(...)   do { if (librealsense::log_enabled(RS2_LOG_SEVERITY_ERROR)) CLOG(ERROR   ,"librealsense") << __VA_ARGS__; } while(false)
 #define LOG_FATAL(...)   do { CLOG(FATAL   ,"librealsense") << __VA_ARGS__; } while(false)
 
 
@@ -347,8 +361,12 @@ namespace librealsense
     RS2_ENUM_HELPERS(rs2_extension, EXTENSION)
     RS2_ENUM_HELPERS(rs2_exception_type, EXCEPTION_TYPE)
     RS2_ENUM_HELPERS(rs2_log_severity, LOG_SEVERITY)
+    RS2_ENUM_HELPERS(rs2_thread_role, THREAD_ROLE)
+    RS2_ENUM_HELPERS(rs2_scheduling_policy, SCHEDULING_POLICY)
     RS2_ENUM_HELPERS(rs2_notification_category, NOTIFICATION_CATEGORY)
     RS2_ENUM_HELPERS(rs2_playback_status, PLAYBACK_STATUS)
+    RS2_ENUM_HELPERS(rs2_frame_queue_type, FRAME_QUEUE_TYPE)
+    RS2_ENUM_HELPERS(rs2_frame_queue_policy, FRAME_QUEUE_POLICY)
 
     ////////////////////////////////////////////
     // World's tiniest linear algebra library //
@@ -1119,6 +1137,7 @@ namespace librealsense
     {
         std::function<void()> continuation;
         const void* protected_data = nullptr;
+        platform::dmabuf_descriptor dmabuf = { -1, 0, 0 };
 
         frame_continuation(const frame_continuation &) = delete;
         frame_continuation & operator=(const frame_continuation &) = delete;
@@ -1128,10 +1147,11 @@ namespace librealsense
         explicit frame_continuation(std::function<void()> continuation, const void* protected_data) : continuation(continuation), protected_data(protected_data) {}
 
 
-        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data)
+        frame_continuation(frame_continuation && other) : continuation(std::move(other.continuation)), protected_data(other.protected_data), dmabuf(other.dmabuf)
         {
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.dmabuf.fd = -1;
         }
 
         void operator()()
@@ -1139,23 +1159,31 @@ namespace librealsense
             continuation();
             continuation = []() {};
             protected_data = nullptr;
+            dmabuf.fd = -1;
         }
 
         void reset()
         {
             protected_data = nullptr;
+            dmabuf.fd = -1;
             continuation = [](){};
         }
 
         const void* get_data() const { return protected_data; }
 
+        // The protected data may also be reachable as a dma-buf, for as long as it is protected
+        void set_dmabuf(const platform::dmabuf_descriptor& descriptor) { dmabuf = descriptor; }
+        const platform::dmabuf_descriptor* get_dmabuf() const { return dmabuf.fd >= 0 ? &dmabuf : nullptr; }
+
         frame_continuation & operator=(frame_continuation && other)
         {
             continuation();
             protected_data = other.protected_data;
+            dmabuf = other.dmabuf;
             continuation = other.continuation;
             other.continuation = []() {};
             other.protected_data = nullptr;
+            other.dmabuf.fd = -1;
             return *this;
         }
 
@@ -1206,7 +1234,7 @@ namespace librealsense
             _backend(backend_ref),_active_object([this](dispatcher::cancellable_timer cancellable_timer)
         {
             polling(cancellable_timer);
-        }), _devices_data()
+        }, RS2_THREAD_ROLE_DEVICE_WATCHER), _devices_data()
         {
         }
 
@@ -1229,6 +1257,7 @@ namespace librealsense
                     if(callback)
                     {
                         _callback(_devices_data, curr);
+                        std::lock_guard<std::mutex> lock(_devices_mutex);
                         _devices_data = curr;
                     }
                 }
@@ -1239,13 +1268,22 @@ namespace librealsense
         {
             stop();
             _callback = std::move(callback);
-            _devices_data = {   _backend->query_uvc_devices(),
-                                _backend->query_usb_devices(),
-                                _backend->query_hid_devices() };
+            {
+                std::lock_guard<std::mutex> lock(_devices_mutex);
+                _devices_data = {   _backend->query_uvc_devices(),
+                                    _backend->query_usb_devices(),
+                                    _backend->query_hid_devices() };
+            }
 
             _active_object.start();
         }
 
+        platform::backend_device_group get_devices() const override
+        {
+            std::lock_guard<std::mutex> lock(_devices_mutex);
+            return _devices_data;
+        }
+
         void stop() override
         {
             _active_object.stop();
@@ -1259,6 +1297,7 @@ namespace librealsense
         callbacks_heap _callback_inflight;
         const platform::backend* _backend;
 
+        mutable std::mutex _devices_mutex; // Only taken to update the devices, the polling thread reads them freely
         platform::backend_device_group _devices_data;
         platform::device_changed_callback _callback;
 
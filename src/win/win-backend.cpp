@@ -141,8 +141,7 @@ namespace librealsense
             win_event_device_watcher(const backend * backend)
             {
                 _data._backend = backend;
-                _data._stopped = false;
-                _data._last = backend_device_group(backend->query_uvc_devices(), backend->query_usb_devices(), backend->query_hid_devices());
+                _data._stopped = true;
             }
             ~win_event_device_watcher() { stop(); }
 
@@ -152,7 +151,11 @@ namespace librealsense
                 if (!_data._stopped) throw wrong_api_call_sequence_exception("Cannot start a running device_watcher");
                 _data._stopped = false;
                 _data._callback = std::move(callback);
-                _thread = std::thread([this]() { run(); });
+                {
+                    std::lock_guard<std::mutex> last_lock(_data._last_mutex);
+                    _data._last = backend_device_group(_data._backend->query_uvc_devices(), _data._backend->query_usb_devices(), _data._backend->query_hid_devices());
+                }
+                _thread = std::thread([this]() { apply_thread_role(RS2_THREAD_ROLE_DEVICE_WATCHER); run(); });
             }
 
             void stop() override
@@ -164,12 +167,21 @@ namespace librealsense
                     if (_thread.joinable()) _thread.join();
                 }
             }
+
+            backend_device_group get_devices() const override
+            {
+                std::lock_guard<std::mutex> lock(_data._last_mutex);
+                return _data._last;
+            }
+
+            bool is_event_driven() const override { return true; }
         private:
             std::thread _thread;
             std::mutex _m;
 
             struct extra_data {
                 const backend * _backend;
+                mutable std::mutex _last_mutex; // Only taken to update the devices, the window thread reads them freely
                 backend_device_group _last;
                 device_changed_callback _callback;
 
@@ -237,6 +249,7 @@ namespace librealsense
                         auto data = reinterpret_cast<extra_data*>(GetWindowLongPtr(hWnd, GWLP_USERDATA));
                         backend_device_group next(data->_backend->query_uvc_devices(), data->_backend->query_usb_devices(), data->_backend->query_hid_devices());
                         /*if (data->_last != next)*/ data->_callback(data->_last, next);
+                        std::lock_guard<std::mutex> lock(data->_last_mutex);
                         data->_last = next;
                     }
                         break;
@@ -262,6 +275,7 @@ namespace librealsense
                         { return info.device_path.substr(0, info.device_path.find_first_of("{")) == path; }), next.hid_devices.end());
 
                         /*if (data->_last != next)*/ data->_callback(data->_last, next);
+                        std::lock_guard<std::mutex> lock(data->_last_mutex);
                         data->_last = next;
                     }
                         break;
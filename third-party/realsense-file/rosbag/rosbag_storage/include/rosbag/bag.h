@@ -52,11 +52,17 @@
 
 //#include "ros/subscription_callback_helper.h"
 
+#include <condition_variable>
+#include <deque>
+#include <exception>
 #include <ios>
 #include <map>
+#include <mutex>
 #include <queue>
 #include <set>
 #include <stdexcept>
+#include <thread>
+#include <type_traits>
 
 #include <boost/format.hpp>
 //#include <boost/iterator/iterator_facade.hpp>
@@ -122,6 +128,8 @@ public:
     CompressionType getCompression() const;                       //!< Get the compression method to use for writing chunks
     void            setChunkThreshold(uint32_t chunk_threshold);  //!< Set the threshold for creating new chunks
     uint32_t        getChunkThreshold() const;                    //!< Get the threshold for creating new chunks
+    void            setCompressionThreads(uint32_t threads);      //!< Set the number of threads compressing LZ4 chunks in the background, in write mode (0 compresses while writing)
+    uint32_t        getCompressionThreads() const;                //!< Get the number of threads compressing chunks in the background
 
     //! Write a message into the bag file
     /*!
@@ -200,13 +208,33 @@ private:
     void appendConnectionRecordToBuffer(Buffer& buf, ConnectionInfo const* connection_info);
     template<class T>
     void writeMessageDataRecord(uint32_t conn_id, ros::Time const& time, T const& msg);
-    void writeIndexRecords();
+    void writeIndexRecords(std::map<uint32_t, std::multiset<IndexEntry> > const& connection_indexes);
     void writeConnectionRecords();
     void writeChunkInfoRecords();
     void startWritingChunk(ros::Time time);
     void writeChunkHeader(CompressionType compression, uint32_t compressed_size, uint32_t uncompressed_size);
     void stopWritingChunk();
 
+    // Background compression
+
+    struct PendingChunk
+    {
+        enum State { Queued, Compressing, Compressed };
+
+        ChunkInfo                                       info;
+        std::map<uint32_t, std::multiset<IndexEntry> > connection_indexes;
+        Buffer                                          data;        //!< the records of the chunk, uncompressed
+        Buffer                                          compressed;
+        State                                           state;
+    };
+
+    bool isCompressingInBackground() const;
+    void queueChunkCompression();
+    void compressChunks();
+    void compressChunk(PendingChunk& chunk) const;
+    void writeCompressedChunk(PendingChunk& chunk);
+    void stopCompressionThreads();
+
     // Reading
 
     void readVersion();
@@ -309,6 +337,17 @@ private:
     mutable Buffer*  current_buffer_;
 
     mutable uint64_t decompressed_chunk_;      //!< position of decompressed chunk
+
+    // While chunks are compressed in the background, the file is only written by the compression threads
+    uint32_t                                   compression_threads_;
+    std::vector<std::thread>                   compression_workers_;
+    std::mutex                                 compression_mutex_;
+    std::condition_variable                    compression_cv_;
+    std::deque<std::shared_ptr<PendingChunk> > pending_chunks_;     //!< chunks being compressed or written, in file order
+    std::vector<std::shared_ptr<PendingChunk> > free_chunks_;       //!< written chunks, whose buffers are reused
+    bool                                       writing_chunks_;     //!< a compression thread is writing compressed chunks to the file
+    bool                                       stopping_compression_;
+    std::exception_ptr                         compression_error_;
 };
 
 } // namespace rosbag
@@ -516,8 +555,10 @@ void Bag::doWrite(std::string const& topic, ros::Time const& time, T const& msg,
 
     {
         // Seek to the end of the file (needed in case previous operation was a read)
-        seek(0, std::ios::end);
-        file_size_ = file_.getOffset();
+        if (!isCompressingInBackground()) {
+            seek(0, std::ios::end);
+            file_size_ = file_.getOffset();
+        }
 
         // Write the chunk header if we're starting a new chunk
         if (!chunk_open_)
@@ -542,7 +583,8 @@ void Bag::doWrite(std::string const& topic, ros::Time const& time, T const& msg,
             }
             connections_[conn_id] = connection_info;
 
-            writeConnectionRecord(connection_info);
+            if (!isCompressingInBackground())
+                writeConnectionRecord(connection_info);
             appendConnectionRecordToBuffer(outgoing_chunk_buffer_, connection_info);
         }
 
@@ -584,28 +626,29 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, ros::Time const& time, T cons
     header[CONNECTION_FIELD_NAME] = toHeaderString(&conn_id);
     header[TIME_FIELD_NAME]       = toHeaderString(&time);
 
-    // Assemble message in memory first, because we need to write its length
     uint32_t msg_ser_len = ros::serialization::serializationLength(msg);
 
-    record_buffer_.setSize(msg_ser_len);
-
-    ros::serialization::OStream s(record_buffer_.getData(), msg_ser_len);
-
-    // todo: serialize into the outgoing_chunk_buffer & remove record_buffer_
-    ros::serialization::serialize(s, msg);
-
-    // We do an extra seek here since writing our data record may
-    // have indirectly moved our file-pointer if it was a
-    // MessageInstance for our own bag
-    seek(0, std::ios::end);
-    file_size_ = file_.getOffset();
+    // A MessageInstance may be read from our own bag, even from the chunk being written,
+    // so it is assembled in memory first. Other messages are serialized straight into the chunk buffer
+    bool from_bag = std::is_same<T, MessageInstance>::value;
+    if (from_bag) {
+        record_buffer_.setSize(msg_ser_len);
+        ros::serialization::OStream s(record_buffer_.getData(), msg_ser_len);
+        ros::serialization::serialize(s, msg);
+    }
 
-    CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
-              (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
+    // The chunk buffer holds the whole chunk, which is written to the file once it is compressed
+    bool to_file = !isCompressingInBackground();
+    if (to_file) {
+        // We do an extra seek here since writing our data record may
+        // have indirectly moved our file-pointer if it was a
+        // MessageInstance for our own bag
+        seek(0, std::ios::end);
+        file_size_ = file_.getOffset();
 
-    writeHeader(header);
-    writeDataLength(msg_ser_len);
-    write((char*) record_buffer_.getData(), msg_ser_len);
+        CONSOLE_BRIDGE_logDebug("Writing MSG_DATA [%llu:%d]: conn=%d sec=%d nsec=%d data_len=%d",
+                  (unsigned long long) file_.getOffset(), getChunkOffset(), conn_id, time.sec, time.nsec, msg_ser_len);
+    }
 
     // todo: use better abstraction than appendHeaderToBuffer
     appendHeaderToBuffer(outgoing_chunk_buffer_, header);
@@ -613,7 +656,20 @@ void Bag::writeMessageDataRecord(uint32_t conn_id, ros::Time const& time, T cons
 
     uint32_t offset = outgoing_chunk_buffer_.getSize();
     outgoing_chunk_buffer_.setSize(outgoing_chunk_buffer_.getSize() + msg_ser_len);
-    memcpy(outgoing_chunk_buffer_.getData() + offset, record_buffer_.getData(), msg_ser_len);
+    uint8_t* msg_data = outgoing_chunk_buffer_.getData() + offset;
+    if (from_bag) {
+        memcpy(msg_data, record_buffer_.getData(), msg_ser_len);
+    }
+    else {
+        ros::serialization::OStream s(msg_data, msg_ser_len);
+        ros::serialization::serialize(s, msg);
+    }
+
+    if (to_file) {
+        writeHeader(header);
+        writeDataLength(msg_ser_len);
+        write((char*) msg_data, msg_ser_len);
+    }
 
     // Update the current chunk time range
     if (time > curr_chunk_info_.end_time)
@@ -72,7 +72,10 @@ Bag::Bag() :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    compression_threads_(0),
+    writing_chunks_(false),
+    stopping_compression_(false)
 {
 }
 
@@ -88,7 +91,10 @@ Bag::Bag(string const& filename, uint32_t mode) :
     chunk_open_(false),
     curr_chunk_data_pos_(0),
     current_buffer_(0),
-    decompressed_chunk_(0)
+    decompressed_chunk_(0),
+    compression_threads_(0),
+    writing_chunks_(false),
+    stopping_compression_(false)
 {
     open(filename, mode);
 }
@@ -166,6 +172,9 @@ void Bag::close() {
 
     file_.close();
 
+    free_chunks_.clear();
+    compression_error_ = nullptr;
+
     topic_connection_ids_.clear();
     header_connection_ids_.clear();
     for (map<uint32_t, ConnectionInfo*>::iterator i = connections_.begin(); i != connections_.end(); i++)
@@ -193,12 +202,26 @@ void Bag::setChunkThreshold(uint32_t chunk_threshold) {
     chunk_threshold_ = chunk_threshold;
 }
 
+uint32_t Bag::getCompressionThreads() const { return compression_threads_; }
+
+void Bag::setCompressionThreads(uint32_t threads) {
+    if (file_.isOpen() && chunk_open_)
+        stopWritingChunk();
+
+    // Chunks already handed to the threads are written before anything else is
+    stopCompressionThreads();
+
+    compression_threads_ = threads;
+}
+
 CompressionType Bag::getCompression() const { return compression_; }
 
 void Bag::setCompression(CompressionType compression) {
     if (file_.isOpen() && chunk_open_)
         stopWritingChunk();
 
+    stopCompressionThreads();
+
     if (!(compression == compression::Uncompressed ||
           compression == compression::BZ2 ||
           compression == compression::LZ4)) {
@@ -252,8 +275,34 @@ void Bag::startWriting() {
 }
 
 void Bag::stopWriting() {
-    if (chunk_open_)
-        stopWritingChunk();
+    if (chunk_open_) {
+        if (isCompressingInBackground()) {
+            try {
+                stopWritingChunk();
+            }
+            catch (...) {
+                // A chunk failed before, so the open one could not be written anyway, it is dropped and the error logged below
+                outgoing_chunk_buffer_.setSize(0);
+                curr_chunk_connection_indexes_.clear();
+                curr_chunk_info_.connection_counts.clear();
+                chunk_open_ = false;
+            }
+        }
+        else
+            stopWritingChunk();
+    }
+
+    // Waits for the chunks handed to the threads and joins them, also after a failure
+    stopCompressionThreads();
+    if (compression_error_) {
+        // Closing can not throw, the chunks from the failed one on are missing from the file
+        try {
+            std::rethrow_exception(compression_error_);
+        }
+        catch (std::exception const& e) {
+            CONSOLE_BRIDGE_logError("Failed to compress or write a chunk: %s", e.what());
+        }
+    }
 
     seek(0, std::ios::end);
 
@@ -399,7 +448,9 @@ void Bag::readFileHeaderRecord() {
 }
 
 uint32_t Bag::getChunkOffset() const {
-    if (compression_ == compression::Uncompressed)
+    if (isCompressingInBackground())
+        return outgoing_chunk_buffer_.getSize();
+    else if (compression_ == compression::Uncompressed)
         return static_cast<uint32_t>(file_.getOffset() - curr_chunk_data_pos_);
     else
         return file_.getCompressedBytesIn();
@@ -407,10 +458,18 @@ uint32_t Bag::getChunkOffset() const {
 
 void Bag::startWritingChunk(Time time) {
     // Initialize chunk info
-    curr_chunk_info_.pos        = file_.getOffset();
     curr_chunk_info_.start_time = time;
     curr_chunk_info_.end_time   = time;
 
+    if (isCompressingInBackground()) {
+        // The chunk is assembled in outgoing_chunk_buffer_, its position is known once it is written
+        curr_chunk_info_.pos = 0;
+        chunk_open_ = true;
+        return;
+    }
+
+    curr_chunk_info_.pos = file_.getOffset();
+
     // Write the chunk header, with a place-holder for the data sizes (we'll fill in when the chunk is finished)
     writeChunkHeader(compression_, 0, 0);
 
@@ -424,6 +483,14 @@ void Bag::startWritingChunk(Time time) {
 }
 
 void Bag::stopWritingChunk() {
+    if (isCompressingInBackground()) {
+        queueChunkCompression();
+
+        curr_chunk_info_.connection_counts.clear();
+        chunk_open_ = false;
+        return;
+    }
+
     // Add this chunk to the index
     chunks_.push_back(curr_chunk_info_);
 
@@ -440,7 +507,7 @@ void Bag::stopWritingChunk() {
 
     // Write out the indexes and clear them
     seek(end_of_chunk_pos);
-    writeIndexRecords();
+    writeIndexRecords(curr_chunk_connection_indexes_);
     curr_chunk_connection_indexes_.clear();
 
     // Clear the connection counts
@@ -489,10 +556,166 @@ void Bag::readChunkHeader(ChunkHeader& chunk_header) const {
     CONSOLE_BRIDGE_logDebug("Read CHUNK: compression=%s size=%d uncompressed=%d (%f)", chunk_header.compression.c_str(), chunk_header.compressed_size, chunk_header.uncompressed_size, 100 * ((double) chunk_header.compressed_size) / chunk_header.uncompressed_size);
 }
 
+bool Bag::isCompressingInBackground() const {
+    // Reading the current chunk while writing needs its position, so only bags that are written alone compress in the background
+    return compression_threads_ > 0 && compression_ == compression::LZ4 && mode_ == bagmode::Write;
+}
+
+void Bag::queueChunkCompression() {
+    std::unique_lock<std::mutex> lock(compression_mutex_);
+
+    // Writing only waits when compression or the disk fall behind by more chunks than there are threads
+    compression_cv_.wait(lock, [this]() { return pending_chunks_.size() <= compression_threads_ || compression_error_; });
+    if (compression_error_)
+        std::rethrow_exception(compression_error_);
+
+    std::shared_ptr<PendingChunk> chunk;
+    if (free_chunks_.empty()) {
+        chunk = std::make_shared<PendingChunk>();
+    }
+    else {
+        chunk = free_chunks_.back();
+        free_chunks_.pop_back();
+    }
+
+    // The chunk takes the records, and leaves its old buffer to assemble the next chunk in
+    chunk->info = curr_chunk_info_;
+    chunk->connection_indexes.swap(curr_chunk_connection_indexes_);
+    curr_chunk_connection_indexes_.clear();
+    chunk->data.swap(outgoing_chunk_buffer_);
+    outgoing_chunk_buffer_.setSize(0);
+    chunk->state = PendingChunk::Queued;
+    pending_chunks_.push_back(chunk);
+
+    while (compression_workers_.size() < compression_threads_)
+        compression_workers_.push_back(std::thread([this]() { compressChunks(); }));
+
+    lock.unlock();
+    compression_cv_.notify_all();
+}
+
+void Bag::compressChunks() {
+    std::unique_lock<std::mutex> lock(compression_mutex_);
+    while (true) {
+        // Take the oldest chunk no thread is compressing yet
+        std::shared_ptr<PendingChunk> chunk;
+        for (std::deque<std::shared_ptr<PendingChunk> >::iterator i = pending_chunks_.begin(); i != pending_chunks_.end(); i++) {
+            if ((*i)->state == PendingChunk::Queued) {
+                chunk = *i;
+                break;
+            }
+        }
+
+        if (!chunk) {
+            if (stopping_compression_)
+                return;
+            compression_cv_.wait(lock);
+            continue;
+        }
+
+        chunk->state = PendingChunk::Compressing;
+        lock.unlock();
+        std::exception_ptr error;
+        try {
+            compressChunk(*chunk);
+        }
+        catch (...) {
+            error = std::current_exception();
+        }
+        lock.lock();
+        chunk->state = PendingChunk::Compressed;
+        if (error && !compression_error_)
+            compression_error_ = error;
+
+        // Compressed chunks are written in order, by one thread at a time
+        while (!writing_chunks_ && !pending_chunks_.empty() && pending_chunks_.front()->state == PendingChunk::Compressed) {
+            std::shared_ptr<PendingChunk> next = pending_chunks_.front();
+            pending_chunks_.pop_front();
+
+            // After a failure nothing more is written, the file would point at chunks that are not there
+            if (!compression_error_) {
+                writing_chunks_ = true;
+                lock.unlock();
+                try {
+                    writeCompressedChunk(*next);
+                }
+                catch (...) {
+                    error = std::current_exception();
+                }
+                lock.lock();
+                writing_chunks_ = false;
+                if (error && !compression_error_)
+                    compression_error_ = error;
+            }
+
+            free_chunks_.push_back(next);
+            compression_cv_.notify_all();
+        }
+    }
+}
+
+void Bag::compressChunk(PendingChunk& chunk) const {
+    // Room for incompressible data, which LZ4 stores with a small overhead per block
+    uint32_t uncompressed_size = chunk.data.getSize();
+    uint32_t capacity = uncompressed_size + uncompressed_size / 255 + 1024;
+    while (true) {
+        chunk.compressed.setSize(capacity);
+        unsigned int compressed_size = capacity;
+
+        // Same block size as LZ4Stream, so the chunk reads back as if it was compressed while writing
+        int ret = roslz4_buffToBuffCompress((char*) chunk.data.getData(), uncompressed_size,
+                                            (char*) chunk.compressed.getData(), &compressed_size, 6);
+        switch (ret) {
+        case ROSLZ4_OK:
+            chunk.compressed.setSize(compressed_size);
+            return;
+        case ROSLZ4_OUTPUT_SMALL:
+            capacity *= 2;
+            break;
+        case ROSLZ4_MEMORY_ERROR: throw BagIOException("ROSLZ4_MEMORY_ERROR: insufficient memory available");
+        default: throw BagIOException((format("Failed to compress chunk (error %1%)") % ret).str());
+        }
+    }
+}
+
+void Bag::writeCompressedChunk(PendingChunk& chunk) {
+    // Only this thread writes to the file, which is positioned at its end
+    chunk.info.pos = file_.getOffset();
+
+    writeChunkHeader(compression::LZ4, chunk.compressed.getSize(), chunk.data.getSize());
+    write((char*) chunk.compressed.getData(), chunk.compressed.getSize());
+    writeIndexRecords(chunk.connection_indexes);
+
+    chunks_.push_back(chunk.info);
+    chunk.connection_indexes.clear();
+}
+
+void Bag::stopCompressionThreads() {
+    std::unique_lock<std::mutex> lock(compression_mutex_);
+    if (compression_workers_.empty())
+        return;
+
+    // Every chunk handed to the threads is compressed and written first
+    compression_cv_.wait(lock, [this]() { return pending_chunks_.empty() && !writing_chunks_; });
+    stopping_compression_ = true;
+    lock.unlock();
+    compression_cv_.notify_all();
+
+    for (std::vector<std::thread>::iterator i = compression_workers_.begin(); i != compression_workers_.end(); i++)
+        i->join();
+
+    lock.lock();
+    compression_workers_.clear();
+    stopping_compression_ = false;
+
+    // The file was only written by the threads, bring the bag up to date
+    file_size_ = file_.getOffset();
+}
+
 // Index records
 
-void Bag::writeIndexRecords() {
-    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = curr_chunk_connection_indexes_.begin(); i != curr_chunk_connection_indexes_.end(); i++) {
+void Bag::writeIndexRecords(map<uint32_t, multiset<IndexEntry> > const& connection_indexes) {
+    for (map<uint32_t, multiset<IndexEntry> >::const_iterator i = connection_indexes.begin(); i != connection_indexes.end(); i++) {
         uint32_t                    connection_id = i->first;
         multiset<IndexEntry> const& index         = i->second;
 
@@ -281,9 +281,14 @@ void View::updateQueries(BagQuery* q) {
         multiset<IndexEntry> const& index = j->second;
 
         // lower_bound/upper_bound do a binary search to find the appropriate range of Index Entries given our time range
-
-        std::multiset<IndexEntry>::const_iterator begin = std::lower_bound(index.begin(), index.end(), q->query.getStartTime(), IndexEntryCompare());
-        std::multiset<IndexEntry>::const_iterator end   = std::upper_bound(index.begin(), index.end(), q->query.getEndTime(),   IndexEntryCompare());		
+        // The members of the multiset are used, std::lower_bound/upper_bound walk its iterators linearly
+
+        IndexEntry start_entry;
+        start_entry.time = q->query.getStartTime();
+        IndexEntry end_entry;
+        end_entry.time = q->query.getEndTime();
+        std::multiset<IndexEntry>::const_iterator begin = index.lower_bound(start_entry);
+        std::multiset<IndexEntry>::const_iterator end   = index.upper_bound(end_entry);
 
         // Make sure we are at the right beginning
         while (begin != index.begin())
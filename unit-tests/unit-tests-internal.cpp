@@ -0,0 +1,1452 @@
+// License: Apache 2.0. See LICENSE file in root directory.
+// Copyright(c) 2017 Intel Corporation. All Rights Reserved.
+
+//////////////////////////////////////////////////////////////////////////////////////////////
+// This set of tests exercises internal building blocks of the library and needs no device //
+//////////////////////////////////////////////////////////////////////////////////////////////
+
+#define CATCH_CONFIG_MAIN
+#include "catch/catch.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../include/librealsense2/rs.hpp"
+#include "executor.h"
+#include "archive.h"
+#include "source.h"
+#include "stream.h"
+#include "sync.h"
+#include "environment.h"
+#include "proc/synthetic-stream.h"
+#include "proc/processing-graph.h"
+#include "proc/syncer-processing-block.h"
+#include "proc/multi-device-syncer.h"
+#include "concurrency.h"
+#include "pipeline.h"
+#include "thread-roles.h"
+#include "device.h"
+#include "context.h"
+#include "ivcam/sr300.h"
+#include "media/playback/parallel_reader.h"
+#include "media/playback/read_ahead_reader.h"
+#include "media/ros/ros_writer.h"
+#include "media/ros/ros_reader.h"
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+#ifdef RS2_USE_V4L2_BACKEND
+#include <sys/eventfd.h>
+#include "linux/backend-v4l2.h"
+#endif
+
+using namespace librealsense;
+
+// Allocates the frames of one stream the way a sensor does
+class frame_generator
+{
+public:
+    explicit frame_generator(rs2_stream stream, int index = 0)
+        : _profile(std::make_shared<video_stream_profile>(platform::stream_profile{ 4, 4, 30, 0 }))
+    {
+        _source.init(std::make_shared<metadata_parser_map>());
+        _profile->set_stream_type(stream);
+        _profile->set_stream_index(index);
+        _profile->set_unique_id(environment::get_instance().generate_stream_id());
+        _profile->set_format(RS2_FORMAT_Z16);
+        _profile->set_framerate(30);
+        _profile->set_dims(4, 4);
+    }
+
+    frame_holder make(unsigned long long number, double timestamp)
+    {
+        frame_additional_data data{};
+        data.frame_number = number;
+        data.timestamp = timestamp;
+        data.timestamp_domain = RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK;
+        data.system_time = timestamp;
+
+        frame_holder frame = _source.alloc_frame(RS2_EXTENSION_VIDEO_FRAME, 4 * 4 * 2, data, true);
+        REQUIRE(frame);
+        ((video_frame*)frame.frame)->assign(4, 4, 4 * 2, 16);
+        frame->set_stream(_profile);
+        return frame;
+    }
+
+    std::shared_ptr<stream_profile_interface> get_profile() const { return _profile; }
+
+    void set_sensor(std::shared_ptr<sensor_interface> sensor) { _source.set_sensor(sensor); }
+
+private:
+    frame_source _source;
+    std::shared_ptr<video_stream_profile> _profile;
+};
+
+template<class T>
+frame_callback_ptr make_frame_callback(T callback)
+{
+    return { new internal_frame_callback<T>(callback), [](rs2_frame_callback* p) { p->release(); } };
+}
+
+// Outputs every frame it is given
+class passthrough_block : public processing_block
+{
+public:
+    passthrough_block()
+    {
+        auto on_frame = [](rs2::frame f, const rs2::frame_source& source) { source.frame_ready(f); };
+        auto callback = new rs2::frame_processor_callback<decltype(on_frame)>(on_frame);
+        set_processing_callback(std::shared_ptr<rs2_frame_processor_callback>(callback));
+    }
+};
+
+// Serves a recording of two streams with a frame every millisecond, alternating between the streams
+class scripted_reader : public device_serializer::reader
+{
+public:
+    scripted_reader(size_t frames)
+        : _frames(frames), _next(0), _fail_at(frames), _file_name("scripted"),
+          _depth(RS2_STREAM_DEPTH), _color(RS2_STREAM_COLOR), reads(0)
+    {
+        _enabled[0] = _enabled[1] = true;
+    }
+
+    static device_serializer::stream_identifier stream_of(size_t frame)
+    {
+        return { 0, 0, frame % 2 ? RS2_STREAM_COLOR : RS2_STREAM_DEPTH, 0 };
+    }
+
+    static size_t frame_at(const device_serializer::nanoseconds& time)
+    {
+        return static_cast<size_t>(std::chrono::duration_cast<std::chrono::milliseconds>(time).count());
+    }
+
+    // Reading this frame, and every one after it until the position changes, fails
+    void fail_at(size_t frame) { _fail_at = frame; }
+
+    device_serializer::device_snapshot query_device_description(const device_serializer::nanoseconds&) override { return {}; }
+
+    std::shared_ptr<device_serializer::serialized_data> read_next_data() override
+    {
+        reads++;
+        while (_next < _frames && !_enabled[_next % 2]) _next++;
+        if (_next >= _frames) return std::make_shared<device_serializer::serialized_end_of_file>();
+        if (_next >= _fail_at) throw io_exception("scripted read failure");
+
+        auto frame = _next++;
+        auto& generator = frame % 2 ? _color : _depth;
+        return std::make_shared<device_serializer::serialized_frame>(std::chrono::milliseconds(frame), stream_of(frame),
+                                                                     generator.make(frame, double(frame)));
+    }
+
+    void seek_to_time(const device_serializer::nanoseconds& time) override
+    {
+        _next = frame_at(time + std::chrono::milliseconds(1) - std::chrono::nanoseconds(1));
+    }
+    device_serializer::nanoseconds query_duration() const override { return std::chrono::milliseconds(_frames); }
+    void reset() override { _next = 0; }
+    void enable_stream(const std::vector<device_serializer::stream_identifier>& ids) override { set_enabled(ids, true); }
+    void disable_stream(const std::vector<device_serializer::stream_identifier>& ids) override { set_enabled(ids, false); }
+    const std::string& get_file_name() const override { return _file_name; }
+    size_t query_frame_count(const device_serializer::stream_identifier&) override { return _frames / 2; }
+    device_serializer::nanoseconds query_frame_time(const device_serializer::stream_identifier& id, size_t number) override
+    {
+        return std::chrono::milliseconds(number * 2 + (id.stream_type == RS2_STREAM_COLOR ? 1 : 0));
+    }
+    size_t query_frame_number(const device_serializer::stream_identifier&, const device_serializer::nanoseconds& time) override
+    {
+        return frame_at(time) / 2;
+    }
+
+private:
+    void set_enabled(const std::vector<device_serializer::stream_identifier>& ids, bool enabled)
+    {
+        for (auto&& id : ids) _enabled[id.stream_type == RS2_STREAM_COLOR ? 1 : 0] = enabled;
+    }
+
+    size_t _frames;
+    size_t _next;
+    std::atomic<size_t> _fail_at;
+    std::string _file_name;
+    frame_generator _depth;
+    frame_generator _color;
+    bool _enabled[2];
+
+public:
+    std::atomic<int> reads;
+};
+
+// A camera of a single sensor, so that generated frames can be recorded like the frames of a device
+class recordable_device : public device
+{
+public:
+    recordable_device() : device(nullptr, {}) {}
+};
+
+class recordable_sensor : public sensor_base
+{
+public:
+    explicit recordable_sensor(device* owner) : sensor_base("Recordable Sensor", owner) {}
+
+    stream_profiles init_stream_profiles() override { return {}; }
+    void open(const stream_profiles&) override {}
+    void close() override {}
+    void start(frame_callback_ptr) override {}
+    void stop() override {}
+};
+
+const device_serializer::stream_identifier recorded_depth{ 0, 0, RS2_STREAM_DEPTH, 0 };
+const device_serializer::stream_identifier recorded_infrared{ 0, 0, RS2_STREAM_INFRARED, 1 };
+
+// Time the n-th depth frame is recorded at, the infrared frame of the same number follows a millisecond later
+device_serializer::nanoseconds recorded_frame_time(size_t n)
+{
+    return std::chrono::milliseconds(1 + 33 * n);
+}
+
+// Records as many depth and infrared frames, whose payload depends on their number
+// The laser power is recorded with every 15th depth frame, at the time of the frame, and the exposure at every whole second
+void record_test_file(const std::string& file, size_t frames, bool compression)
+{
+    auto dev = std::make_shared<recordable_device>();
+    auto sensor = std::make_shared<recordable_sensor>(dev.get());
+    frame_generator depth(RS2_STREAM_DEPTH), infrared(RS2_STREAM_INFRARED, 1);
+    depth.set_sensor(sensor);
+    infrared.set_sensor(sensor);
+
+    // Small chunks, so that the file is made of many
+    ros_writer writer(file, compression, 4096);
+    auto record_option = [&writer](rs2_option id, float value, device_serializer::nanoseconds time)
+    {
+        auto options = std::make_shared<options_container>();
+        options->register_option(id, std::make_shared<const_value_option>("Recorded option", value));
+        writer.write_snapshot(device_serializer::sensor_identifier{ 0, 0 }, time, RS2_EXTENSION_OPTIONS, options);
+    };
+    auto record_frame = [&writer](frame_generator& generator, const device_serializer::stream_identifier& stream,
+                                  size_t n, device_serializer::nanoseconds time)
+    {
+        auto frame = generator.make(n, std::chrono::duration<double, std::milli>(time).count());
+        auto& payload = dynamic_cast<librealsense::frame*>(frame.frame)->data;
+        for (size_t i = 0; i < payload.size(); i++)
+            payload[i] = static_cast<byte>(n + i + stream.stream_type);
+        writer.write_frame(stream, time, std::move(frame));
+    };
+
+    auto second = 1;
+    for (size_t n = 0; n < frames; n++)
+    {
+        auto time = recorded_frame_time(n);
+        if (time >= std::chrono::seconds(second))
+        {
+            record_option(RS2_OPTION_EXPOSURE, float(second), std::chrono::seconds(second));
+            second++;
+        }
+        record_frame(depth, recorded_depth, n, time);
+        if (n % 15 == 0)
+            record_option(RS2_OPTION_LASER_POWER, float(n), time);
+        record_frame(infrared, recorded_infrared, n, time + std::chrono::milliseconds(1));
+    }
+}
+
+// What playing a recording returned, the frame number and payload of frames and the value of options
+struct played_data
+{
+    device_serializer::nanoseconds time;
+    device_serializer::stream_identifier stream; // Of a frame
+    rs2_option option; // RS2_OPTION_COUNT for a frame
+    double value;
+    std::vector<byte> payload;
+
+    bool operator==(const played_data& other) const
+    {
+        return time == other.time && stream == other.stream && option == other.option &&
+               value == other.value && payload == other.payload;
+    }
+};
+
+played_data to_played_data(const device_serializer::serialized_data& data)
+{
+    if (auto frame = data.as<device_serializer::serialized_frame>())
+    {
+        auto f = dynamic_cast<librealsense::frame*>(frame->frame.frame);
+        REQUIRE(f);
+        return { data.get_timestamp(), frame->stream_id, RS2_OPTION_COUNT, double(f->get_frame_number()), f->data };
+    }
+
+    auto option = data.as<device_serializer::serialized_option>();
+    REQUIRE(option);
+    return { data.get_timestamp(), { 0, 0, RS2_STREAM_ANY, 0 }, option->option_id, option->option->query(), {} };
+}
+
+// Reads the data of a recording until its end
+std::vector<played_data> play_until_end(device_serializer::reader& reader)
+{
+    std::vector<played_data> played;
+    while (true)
+    {
+        auto data = reader.read_next_data();
+        if (data->is<device_serializer::serialized_end_of_file>()) return played;
+        played.push_back(to_played_data(*data));
+    }
+}
+
+template<class T>
+bool wait_for(T condition, std::chrono::milliseconds timeout = std::chrono::seconds(10))
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition())
+    {
+        if (std::chrono::steady_clock::now() > deadline) return false;
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return true;
+}
+
+TEST_CASE("Executor keeps tasks while it is reconfigured", "[offline][executor]") {
+    executor ex(4);
+    auto serial = std::make_shared<serial_executor>(ex);
+
+    const int tasks = 10000;
+    std::atomic<int> done(0);
+    std::mutex m;
+    std::vector<int> order;
+
+    // Tasks post from the workers while the workers are being replaced
+    std::atomic<bool> reconfiguring(true);
+    std::thread reconfigure([&]()
+    {
+        for (size_t i = 0; reconfiguring; i++)
+            ex.configure(1 + i % 4, 0);
+    });
+
+    for (auto i = 0; i < tasks; i++)
+    {
+        serial->post([&, i]()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m);
+                order.push_back(i);
+            }
+            ex.post([&]() { done++; });
+        });
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (done < tasks && std::chrono::steady_clock::now() < deadline)
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    reconfiguring = false;
+    reconfigure.join();
+
+    REQUIRE(done == tasks);
+    std::lock_guard<std::mutex> lock(m);
+    REQUIRE(order.size() == tasks);
+    for (auto i = 0; i < tasks; i++)
+        REQUIRE(order[i] == i);
+}
+
+TEST_CASE("Serial executor flush waits for posted tasks", "[offline][executor]") {
+    executor ex(2);
+    auto serial = std::make_shared<serial_executor>(ex);
+
+    std::atomic<int> done(0);
+    for (auto i = 0; i < 100; i++)
+        serial->post([&]() { std::this_thread::sleep_for(std::chrono::microseconds(100)); done++; });
+    serial->flush();
+    REQUIRE(done == 100);
+
+    // Stopping drops what did not start
+    for (auto i = 0; i < 100; i++)
+        serial->post([&]() { std::this_thread::sleep_for(std::chrono::milliseconds(1)); done++; });
+    serial->stop();
+    auto stopped_at = done.load();
+    REQUIRE(stopped_at < 200);
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    REQUIRE(done == stopped_at);
+}
+
+TEST_CASE("Processing graph gives blocks back their outputs", "[offline][processing-graph]") {
+    frame_generator depth(RS2_STREAM_DEPTH);
+    auto block = std::make_shared<passthrough_block>();
+
+    std::atomic<int> own_output(0), graph_output(0);
+    block->set_output_callback(make_frame_callback([&](frame_holder f) { own_output++; }));
+    {
+        processing_graph graph;
+        auto node = graph.add_node(block);
+        graph.connect_input(node, RS2_STREAM_ANY, 4);
+        graph.connect_output(node, RS2_STREAM_ANY);
+        graph.set_output_callback(make_frame_callback([&](frame_holder f) { graph_output++; }));
+
+        graph.invoke(depth.make(1, 1));
+        REQUIRE(wait_for([&]() { return graph_output == 1; }));
+        REQUIRE(own_output == 0);
+
+        // The first frame froze the topology
+        REQUIRE_THROWS(graph.add_node(std::make_shared<passthrough_block>()));
+        REQUIRE_THROWS(graph.connect_output(node, RS2_STREAM_DEPTH));
+    }
+
+    block->invoke(depth.make(2, 2));
+    REQUIRE(own_output == 1);
+    REQUIRE(graph_output == 1);
+}
+
+TEST_CASE("Syncer matches framesets of many streams", "[offline][sync]") {
+    const int streams = 10;
+    const int rounds = 30;
+
+    std::vector<std::unique_ptr<frame_generator>> generators;
+    for (auto i = 0; i < streams; i++)
+        generators.emplace_back(new frame_generator(RS2_STREAM_INFRARED, i + 1));
+
+    syncer_proccess_unit syncer;
+    std::vector<size_t> set_sizes;
+    syncer.set_output_callback(make_frame_callback([&](frame_holder f)
+    {
+        auto composite = dynamic_cast<composite_frame*>(f.frame);
+        set_sizes.push_back(composite ? composite->get_embedded_frames_count() : 1);
+    }));
+
+    for (auto round = 0; round < rounds; round++)
+    {
+        // Streams show up one by one in the first round, every later round completes a set of all of them
+        if (round == 1) set_sizes.clear();
+        for (auto&& g : generators)
+            syncer.invoke(g->make(round, round * 1000. / 30));
+    }
+
+    REQUIRE(set_sizes.size() == rounds - 1);
+    for (auto size : set_sizes)
+        REQUIRE(size == streams);
+}
+
+TEST_CASE("Single producer ring queue keeps the order of items", "[offline][concurrency]") {
+    const int items = 100000;
+    ring_queue<int> queue(16, false, queue_policy::block, 1000);
+
+    std::thread producer([&]()
+    {
+        for (auto i = 0; i < items; i++)
+            queue.enqueue(std::move(i));
+    });
+
+    std::vector<int> received;
+    int item;
+    while (received.size() < items && queue.dequeue(&item, 1000))
+        received.push_back(item);
+    producer.join();
+
+    REQUIRE(received.size() == items);
+    for (auto i = 0; i < items; i++)
+        REQUIRE(received[i] == i);
+    REQUIRE(queue.get_stats().dropped == 0);
+}
+
+TEST_CASE("Multiple producer ring queue delivers every item", "[offline][concurrency]") {
+    const int producers = 4;
+    const int items = 25000;
+    ring_queue<int> queue(16, true, queue_policy::block, 1000);
+
+    std::vector<std::thread> threads;
+    for (auto p = 0; p < producers; p++)
+    {
+        threads.emplace_back([&, p]()
+        {
+            for (auto i = 0; i < items; i++)
+                queue.enqueue(p * items + i);
+        });
+    }
+
+    // Every producer's items come out in the order it enqueued them
+    std::vector<int> next(producers, 0);
+    std::vector<int> batch;
+    size_t received = 0;
+    while (received < producers * items)
+    {
+        batch.clear();
+        if (!queue.dequeue_batch(&batch, 8, 1000)) break;
+        for (auto item : batch)
+        {
+            auto p = item / items;
+            REQUIRE(item % items == next[p]);
+            next[p]++;
+        }
+        received += batch.size();
+    }
+    for (auto&& t : threads) t.join();
+
+    REQUIRE(received == producers * items);
+    REQUIRE(queue.size() == 0);
+}
+
+TEST_CASE("Ring queue wakes parked consumers", "[offline][concurrency]") {
+    using namespace std::chrono;
+    ring_queue<int> queue(4);
+
+    // Nothing arrives
+    int item;
+    auto start = steady_clock::now();
+    REQUIRE_FALSE(queue.dequeue(&item, 20));
+    REQUIRE(steady_clock::now() - start >= milliseconds(15));
+
+    // An item arrives while the consumer is parked
+    std::atomic<bool> got(false);
+    std::thread consumer([&]()
+    {
+        int item;
+        got = queue.dequeue(&item, 5000) && item == 7;
+    });
+    std::this_thread::sleep_for(milliseconds(50));
+    start = steady_clock::now();
+    queue.enqueue(7);
+    consumer.join();
+    REQUIRE(got);
+    REQUIRE(steady_clock::now() - start < seconds(1));
+
+    // Clearing releases a parked consumer without an item
+    std::atomic<bool> returned(false);
+    consumer = std::thread([&]()
+    {
+        int item;
+        got = queue.dequeue(&item, 5000);
+        returned = true;
+    });
+    std::this_thread::sleep_for(milliseconds(50));
+    queue.clear();
+    REQUIRE(wait_for([&]() { return returned.load(); }, seconds(1)));
+    consumer.join();
+    REQUIRE_FALSE(got);
+}
+
+// The implementations that back rs2_frame_queue: locking, single producer ring and multiple producer ring
+std::unique_ptr<bounded_queue<int>> make_queue(rs2_frame_queue_type type, unsigned int cap, queue_policy policy,
+                                               unsigned int block_timeout_ms = 0)
+{
+    switch (type)
+    {
+    case RS2_FRAME_QUEUE_TYPE_SINGLE_PRODUCER: return std::unique_ptr<bounded_queue<int>>(new ring_queue<int>(cap, false, policy, block_timeout_ms));
+    case RS2_FRAME_QUEUE_TYPE_MULTI_PRODUCER: return std::unique_ptr<bounded_queue<int>>(new ring_queue<int>(cap, true, policy, block_timeout_ms));
+    default: return std::unique_ptr<bounded_queue<int>>(new single_consumer_queue<int>(cap, policy, block_timeout_ms));
+    }
+}
+
+std::vector<int> drain(bounded_queue<int>& queue)
+{
+    std::vector<int> items;
+    int item;
+    while (queue.try_dequeue(&item))
+        items.push_back(item);
+    return items;
+}
+
+TEST_CASE("Frame queue policies drop the expected items", "[offline][concurrency]") {
+    for (auto i = 0; i < RS2_FRAME_QUEUE_TYPE_COUNT; i++)
+    {
+        auto type = static_cast<rs2_frame_queue_type>(i);
+        CAPTURE(rs2_frame_queue_type_to_string(type));
+
+        struct expectation { queue_policy policy; std::vector<int> kept; unsigned long long dropped; };
+        std::vector<expectation> expectations = {
+            { queue_policy::drop_oldest, { 2, 3, 4 }, 2 },
+            { queue_policy::drop_newest, { 0, 1, 2 }, 2 },
+            { queue_policy::block,       { 0, 1, 2 }, 2 },
+            { queue_policy::keep_latest, { 4 },       4 },
+        };
+        for (auto&& e : expectations)
+        {
+            CAPTURE(static_cast<int>(e.policy));
+            auto queue = make_queue(type, 3, e.policy, 10);
+            for (auto item = 0; item < 5; item++)
+                queue->enqueue(std::move(item));
+
+            REQUIRE(drain(*queue) == e.kept);
+            auto stats = queue->get_stats();
+            REQUIRE(stats.dropped == e.dropped);
+            REQUIRE(stats.high_water_mark == e.kept.size());
+        }
+    }
+}
+
+TEST_CASE("Blocking frame queue releases the producer once there is room", "[offline][concurrency]") {
+    for (auto i = 0; i < RS2_FRAME_QUEUE_TYPE_COUNT; i++)
+    {
+        auto type = static_cast<rs2_frame_queue_type>(i);
+        CAPTURE(rs2_frame_queue_type_to_string(type));
+
+        auto queue = make_queue(type, 3, queue_policy::block, 5000);
+        for (auto item = 0; item < 3; item++)
+            queue->enqueue(std::move(item));
+
+        std::atomic<bool> enqueued(false);
+        std::thread producer([&]()
+        {
+            queue->enqueue(3);
+            enqueued = true;
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE_FALSE(enqueued);
+
+        int item;
+        REQUIRE(queue->try_dequeue(&item));
+        REQUIRE(item == 0);
+        REQUIRE(wait_for([&]() { return enqueued.load(); }, std::chrono::seconds(1)));
+        producer.join();
+
+        REQUIRE(drain(*queue) == std::vector<int>({ 1, 2, 3 }));
+        REQUIRE(queue->get_stats().dropped == 0);
+    }
+}
+
+TEST_CASE("Frame queues time items only once stats are read", "[offline][concurrency]") {
+    for (auto i = 0; i < RS2_FRAME_QUEUE_TYPE_COUNT; i++)
+    {
+        auto type = static_cast<rs2_frame_queue_type>(i);
+        CAPTURE(rs2_frame_queue_type_to_string(type));
+
+        auto queue = make_queue(type, 3, queue_policy::drop_oldest);
+        queue->enqueue(0);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        drain(*queue);
+        auto stats = queue->get_stats();
+        REQUIRE(stats.enqueued == 1);
+        REQUIRE(stats.average_residency_ms == 0);
+
+        queue->enqueue(1);
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        drain(*queue);
+        stats = queue->get_stats();
+        REQUIRE(stats.enqueued == 2);
+        REQUIRE(stats.average_residency_ms >= 4);
+    }
+}
+
+TEST_CASE("Frame sources measure the latency of frames timestamped by the backend", "[offline][latency]") {
+    environment::get_instance().set_time_service(std::make_shared<platform::os_time_service>());
+    auto ts = environment::get_instance().get_time_service();
+    auto profile = frame_generator(RS2_STREAM_DEPTH).get_profile();
+
+    frame_source source;
+    source.init(std::make_shared<metadata_parser_map>());
+    auto delivered = 0;
+    source.set_callback(make_frame_callback([&](frame_holder f) { delivered++; }));
+
+    // A negative age delivers a frame without a backend timestamp
+    auto deliver = [&](double age_ms)
+    {
+        frame_additional_data data{};
+        data.backend_timestamp = age_ms < 0 ? 0 : ts->get_time() - age_ms;
+        frame_holder frame = source.alloc_frame(RS2_EXTENSION_VIDEO_FRAME, 4 * 4 * 2, data, true);
+        REQUIRE(frame);
+        frame->set_stream(profile);
+        source.invoke_callback(std::move(frame));
+    };
+
+    for (auto i = 0; i < 10; i++)
+        deliver(20);
+    deliver(-1);
+    REQUIRE(delivered == 11);
+
+    auto stats = source.get_latency_stats(profile->get_unique_id());
+    REQUIRE(stats.frames == 10);
+    REQUIRE(stats.min_ms >= 20);
+    REQUIRE(stats.average_ms >= stats.min_ms);
+    REQUIRE(stats.max_ms >= stats.average_ms);
+    REQUIRE(stats.max_ms < 1000);
+    REQUIRE(stats.last_ms >= 20);
+    REQUIRE(source.get_latency_stats(profile->get_unique_id() + 1).frames == 0);
+
+    source.reset_latency_stats();
+    REQUIRE(source.get_latency_stats(profile->get_unique_id()).frames == 0);
+}
+
+TEST_CASE("Device clock model tracks offset and drift", "[offline][multi-device-sync]") {
+    // The device clock runs 100ppm fast and starts 5 seconds behind the host, arrivals jitter by up to a millisecond
+    auto host_time = [](double hw) { return 5000. + hw * 1.0001; };
+    auto jitter = [](int i) { return ((i * 7919) % 11 - 5) / 5.; };
+
+    device_clock_model clock;
+    double hw = 0;
+    for (auto i = 0; i < 3000; i++, hw += 1000. / 30)
+        clock.update(hw, host_time(hw) + jitter(i));
+
+    REQUIRE(std::fabs(clock.to_system_time(hw) - host_time(hw)) < 0.5);
+    REQUIRE(std::fabs(clock.to_system_time(hw + 1000) - host_time(hw + 1000)) < 0.5);
+
+    // The device clock restarts from zero, the model starts over instead of averaging both clocks
+    auto restarted = [](double hw) { return 200000. + hw; };
+    for (auto i = 0; i < 100; i++)
+        clock.update(i * 1000. / 30, restarted(i * 1000. / 30) + jitter(i));
+    REQUIRE(std::fabs(clock.to_system_time(4000) - restarted(4000)) < 1);
+}
+
+TEST_CASE("Multi-device syncer matches frames of several streams", "[offline][multi-device-sync]") {
+    frame_generator depth(RS2_STREAM_DEPTH), color(RS2_STREAM_COLOR);
+    multi_device_syncer syncer(10, 2);
+
+    std::vector<std::vector<int>> sets;
+    syncer.set_output_callback(make_frame_callback([&](frame_holder f)
+    {
+        std::vector<int> streams;
+        if (auto composite = dynamic_cast<composite_frame*>(f.frame))
+        {
+            for (size_t i = 0; i < composite->get_embedded_frames_count(); i++)
+                streams.push_back(composite->get_frame(static_cast<int>(i))->get_stream()->get_unique_id());
+        }
+        sets.push_back(streams);
+    }));
+
+    // Color trails depth by a few milliseconds, within the tolerance
+    const int rounds = 30;
+    for (auto round = 0; round < rounds; round++)
+    {
+        syncer.invoke(depth.make(round, round * 1000. / 30));
+        syncer.invoke(color.make(round, round * 1000. / 30 + 3));
+    }
+    REQUIRE(sets.size() == rounds);
+    for (auto&& set : sets)
+    {
+        REQUIRE(set.size() == 2);
+        REQUIRE(std::count(set.begin(), set.end(), depth.get_profile()->get_unique_id()) == 1);
+        REQUIRE(std::count(set.begin(), set.end(), color.get_profile()->get_unique_id()) == 1);
+    }
+
+    // Once color stops for over a second, depth is no longer held back waiting for it
+    sets.clear();
+    for (auto round = rounds; round < rounds + 60; round++)
+        syncer.invoke(depth.make(round, round * 1000. / 30));
+    REQUIRE(sets.size() > 20);
+    REQUIRE(sets.back().size() == 1);
+}
+
+TEST_CASE("Multi-device syncer waits for every expected stream at startup", "[offline][multi-device-sync]") {
+    frame_generator depth(RS2_STREAM_DEPTH), color(RS2_STREAM_COLOR);
+    // A third stream is expected, but never delivers
+    multi_device_syncer syncer(10, 3);
+
+    std::vector<size_t> sizes;
+    syncer.set_output_callback(make_frame_callback([&](frame_holder f)
+    {
+        auto composite = dynamic_cast<composite_frame*>(f.frame);
+        sizes.push_back(composite ? composite->get_embedded_frames_count() : 1);
+    }));
+
+    // Nothing is emitted with part of the streams while the third one may still come
+    auto round = 0;
+    for (; round * 1000. / 30 + 3 <= 1000; round++)
+    {
+        syncer.invoke(depth.make(round, round * 1000. / 30));
+        syncer.invoke(color.make(round, round * 1000. / 30 + 3));
+    }
+    REQUIRE(sizes.empty());
+
+    // A second after the first frame, the streams seen so far are matched
+    for (auto end = round + 10; round < end; round++)
+    {
+        syncer.invoke(depth.make(round, round * 1000. / 30));
+        syncer.invoke(color.make(round, round * 1000. / 30 + 3));
+    }
+    REQUIRE(sizes.size() >= 10);
+    for (auto size : sizes)
+        REQUIRE(size == 2);
+}
+
+TEST_CASE("Busy-polling consumers receive items and report wake latency", "[offline][concurrency]") {
+    for (auto i = 0; i < RS2_FRAME_QUEUE_TYPE_COUNT; i++)
+    {
+        auto type = static_cast<rs2_frame_queue_type>(i);
+        CAPTURE(rs2_frame_queue_type_to_string(type));
+
+        auto queue = make_queue(type, 3, queue_policy::drop_oldest);
+        queue->set_busy_poll(20000);
+        queue->get_stats(); // Starts timing items
+
+        // The first item arrives while the consumer spins, the second one after it parked
+        for (auto delay : { 1, 50 })
+        {
+            std::atomic<bool> got(false);
+            std::thread consumer([&]()
+            {
+                int item;
+                got = queue->dequeue(&item, 5000) && item == delay;
+            });
+            std::this_thread::sleep_for(std::chrono::milliseconds(delay));
+            queue->enqueue(std::move(delay));
+            consumer.join();
+            REQUIRE(got);
+        }
+
+        auto stats = queue->get_stats();
+        REQUIRE(stats.average_wake_latency_us > 0);
+        REQUIRE(stats.max_wake_latency_us >= stats.average_wake_latency_us);
+    }
+}
+
+TEST_CASE("Latest frameset slot hands over only the newest set", "[offline][pipeline]") {
+    frame_generator depth(RS2_STREAM_DEPTH);
+    latest_frameset latest;
+    latest.set_busy_poll(20000);
+    latest.get_stats(); // Starts timing sets
+
+    std::vector<frame_holder> frames;
+    REQUIRE_FALSE(latest.try_consume(&frames));
+
+    // A set that is overwritten before it is read is dropped
+    for (auto number = 1; number <= 3; number++)
+    {
+        std::vector<frame_holder> set;
+        set.push_back(depth.make(number, number));
+        latest.publish(std::move(set));
+    }
+    REQUIRE(latest.consume(&frames, 100));
+    REQUIRE(frames.size() == 1);
+    REQUIRE(frames[0]->get_frame_number() == 3);
+    REQUIRE_FALSE(latest.try_consume(&frames));
+
+    // A waiting consumer is handed the next set
+    std::atomic<bool> got(false);
+    std::thread consumer([&]()
+    {
+        std::vector<frame_holder> frames;
+        got = latest.consume(&frames, 5000) && frames.size() == 1 && frames[0]->get_frame_number() == 4;
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    std::vector<frame_holder> set;
+    set.push_back(depth.make(4, 4));
+    latest.publish(std::move(set));
+    consumer.join();
+    REQUIRE(got);
+
+    auto stats = latest.get_stats();
+    REQUIRE(stats.enqueued == 4);
+    REQUIRE(stats.dropped == 2);
+    REQUIRE(stats.average_wake_latency_us > 0);
+}
+
+TEST_CASE("Post-processing stage gives blocks back their outputs", "[offline][pipeline]") {
+    frame_generator depth(RS2_STREAM_DEPTH);
+    passthrough_block host;
+    auto block = std::make_shared<passthrough_block>();
+
+    std::atomic<int> own_output(0), stage_output(0);
+    block->set_output_callback(make_frame_callback([&](frame_holder f) { own_output++; }));
+    {
+        post_processing_stage stage({ block }, host.get_source(), [&](std::vector<frame_holder> frames)
+        {
+            if (frames.size() == 1 && frames[0]->get_frame_number() == 1) stage_output++;
+        });
+
+        std::vector<frame_holder> frames;
+        frames.push_back(depth.make(1, 1));
+        stage.invoke(std::move(frames));
+        REQUIRE(wait_for([&]() { return stage_output == 1; }));
+        REQUIRE(own_output == 0);
+    }
+
+    block->invoke(depth.make(2, 2));
+    REQUIRE(own_output == 1);
+    REQUIRE(stage_output == 1);
+}
+
+#ifdef RS2_USE_V4L2_BACKEND
+TEST_CASE("Capture reactor handles every device on one thread at a time", "[offline][v4l2]") {
+    platform::v4l_capture_reactor reactor(4);
+
+    // Event descriptors stand in for the video devices
+    struct device
+    {
+        int fd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        uint64_t id = 0;
+        std::atomic<unsigned long long> events{ 0 };
+        std::atomic<int> calls{ 0 };
+        std::atomic<int> running{ 0 };
+        std::atomic<bool> overlapped{ false };
+        ~device() { close(fd); }
+    };
+    const int devices = 4;
+    const int events = 1000;
+    std::vector<std::unique_ptr<device>> devs;
+    for (auto i = 0; i < devices; i++)
+    {
+        devs.emplace_back(new device());
+        auto d = devs.back().get();
+        REQUIRE(d->fd >= 0);
+        // The last device stops being watched after its first wake-up
+        auto keep_watching = i != devices - 1;
+        d->id = reactor.add(d->fd, [d, keep_watching]()
+        {
+            if (d->running.fetch_add(1)) d->overlapped = true;
+            d->calls++;
+            uint64_t value;
+            while (read(d->fd, &value, sizeof(value)) == sizeof(value))
+                d->events += value;
+            std::this_thread::yield();
+            d->running.fetch_sub(1);
+            return keep_watching;
+        }, []() {});
+    }
+
+    uint64_t one = 1;
+    for (auto i = 0; i < events; i++)
+    {
+        for (auto&& d : devs)
+            REQUIRE(write(d->fd, &one, sizeof(one)) == sizeof(one));
+        if (i % 100 == 0) std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    for (auto i = 0; i < devices - 1; i++)
+    {
+        auto d = devs[i].get();
+        REQUIRE(wait_for([d]() { return d->events == events; }));
+        REQUIRE_FALSE(d->overlapped);
+    }
+    REQUIRE(devs.back()->calls == 1);
+
+    // Removed devices are no longer handled
+    for (auto&& d : devs)
+        reactor.remove(d->id);
+    std::vector<int> calls;
+    for (auto&& d : devs)
+    {
+        calls.push_back(d->calls);
+        REQUIRE(write(d->fd, &one, sizeof(one)) == sizeof(one));
+    }
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    for (auto i = 0; i < devices; i++)
+        REQUIRE(devs[i]->calls == calls[i]);
+}
+
+TEST_CASE("Device watcher rescans only for camera related uevents", "[offline][v4l2]") {
+    auto relevant = [](std::string fields)
+    {
+        std::replace(fields.begin(), fields.end(), '|', '\0');
+        return platform::v4l_uevent_device_watcher::is_relevant_uevent(fields.data(), fields.size());
+    };
+
+    REQUIRE(relevant("add@/devices/usb2/2-1|ACTION=add|DEVPATH=/devices/usb2/2-1|SUBSYSTEM=usb|DEVTYPE=usb_device"));
+    REQUIRE(relevant("remove@/devices/video4linux/video0|ACTION=remove|SUBSYSTEM=video4linux"));
+    REQUIRE(relevant("bind@/devices/hid|SUBSYSTEM=hid|ACTION=bind"));
+    REQUIRE(relevant("unbind@/devices/iio:device0|ACTION=unbind|SUBSYSTEM=iio"));
+
+    REQUIRE_FALSE(relevant("change@/devices/usb2/2-1|ACTION=change|SUBSYSTEM=usb"));
+    REQUIRE_FALSE(relevant("add@/devices/net/eth0|ACTION=add|SUBSYSTEM=net"));
+    REQUIRE_FALSE(relevant("add@/devices/usb2/2-1|ACTION=add"));
+    REQUIRE_FALSE(relevant("add@/devices/usb2/2-1|ACTION=add|SUBSYSTEM=usbmisc"));
+    // A truncated message does not read past its end
+    REQUIRE_FALSE(relevant("add@/devices/usb2/2-1|ACTION=add|SUBSYSTEM=us"));
+}
+
+TEST_CASE("Frame buffers grow only for frames lost while the driver had none queued", "[offline][v4l2]") {
+    platform::v4l_sequence_tracker tracker;
+    tracker.on_buffers_queued(3);
+    REQUIRE_FALSE(tracker.on_frame(10));
+    REQUIRE_FALSE(tracker.on_frame(11));
+
+    // Frames lost on the USB link, more buffers would not have kept them
+    REQUIRE_FALSE(tracker.on_frame(14));
+    REQUIRE(tracker.get_dropped_frames() == 2);
+
+    // Frames lost after the driver ran out of buffers
+    tracker.on_buffers_queued(0);
+    REQUIRE(tracker.on_frame(17));
+    REQUIRE(tracker.get_dropped_frames() == 4);
+
+    // Running out of buffers without losing frames
+    tracker.on_buffers_queued(0);
+    REQUIRE_FALSE(tracker.on_frame(18));
+
+    // A sequence that went back is not a loss
+    tracker.on_buffers_queued(0);
+    REQUIRE_FALSE(tracker.on_frame(5));
+    REQUIRE(tracker.get_dropped_frames() == 4);
+
+    // Streaming again does not compare against the sequence of the last session, which may wrap around
+    tracker.restart();
+    REQUIRE_FALSE(tracker.on_frame(0xFFFFFFFFu));
+    tracker.on_buffers_queued(0);
+    REQUIRE(tracker.on_frame(1));
+    REQUIRE(tracker.get_dropped_frames() == 5);
+}
+#endif
+
+// Reports the devices it is given, and raises the changes the test makes to them
+class scripted_device_watcher : public platform::device_watcher
+{
+public:
+    explicit scripted_device_watcher(const platform::backend* backend) : _backend(backend) {}
+
+    void start(platform::device_changed_callback callback) override
+    {
+        _callback = callback;
+        _devices = { _backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices() };
+    }
+    void stop() override { _callback = nullptr; }
+    platform::backend_device_group get_devices() const override { return _devices; }
+    bool is_event_driven() const override { return true; }
+
+    void raise()
+    {
+        platform::backend_device_group curr(_backend->query_uvc_devices(), _backend->query_usb_devices(), _backend->query_hid_devices());
+        _callback(_devices, curr);
+        _devices = curr;
+    }
+
+private:
+    const platform::backend* _backend;
+    platform::device_changed_callback _callback;
+    platform::backend_device_group _devices;
+};
+
+// A backend of SR300 cameras that are only enumerated, never opened
+class scripted_backend : public platform::backend
+{
+public:
+    scripted_backend() : enumerations(0) {}
+
+    void connect(const std::string& unique_id)
+    {
+        for (uint16_t mi : { 0, 2 })
+        {
+            platform::uvc_device_info uvc;
+            uvc.vid = 0x8086;
+            uvc.pid = SR300_PID;
+            uvc.mi = mi;
+            uvc.unique_id = unique_id;
+            uvc.device_path = unique_id + "/" + std::to_string(mi);
+            _uvc.push_back(uvc);
+        }
+        _usb.push_back({ "", 0x8086, SR300_PID, 4, unique_id });
+    }
+    void disconnect(const std::string& unique_id)
+    {
+        _uvc.erase(std::remove_if(_uvc.begin(), _uvc.end(), [&](const platform::uvc_device_info& i) { return i.unique_id == unique_id; }), _uvc.end());
+        _usb.erase(std::remove_if(_usb.begin(), _usb.end(), [&](const platform::usb_device_info& i) { return i.unique_id == unique_id; }), _usb.end());
+    }
+
+    std::shared_ptr<platform::uvc_device> create_uvc_device(platform::uvc_device_info) const override { throw not_implemented_exception("scripted backend"); }
+    std::vector<platform::uvc_device_info> query_uvc_devices() const override { enumerations++; return _uvc; }
+    std::shared_ptr<platform::usb_device> create_usb_device(platform::usb_device_info) const override { throw not_implemented_exception("scripted backend"); }
+    std::vector<platform::usb_device_info> query_usb_devices() const override { return _usb; }
+    std::shared_ptr<platform::hid_device> create_hid_device(platform::hid_device_info) const override { throw not_implemented_exception("scripted backend"); }
+    std::vector<platform::hid_device_info> query_hid_devices() const override { return {}; }
+    std::shared_ptr<platform::time_service> create_time_service() const override { return std::make_shared<platform::os_time_service>(); }
+    std::shared_ptr<platform::device_watcher> create_device_watcher() const override
+    {
+        watcher = std::make_shared<scripted_device_watcher>(this);
+        return watcher;
+    }
+
+    mutable int enumerations;
+    mutable std::shared_ptr<scripted_device_watcher> watcher;
+
+private:
+    std::vector<platform::uvc_device_info> _uvc;
+    std::vector<platform::usb_device_info> _usb;
+};
+
+TEST_CASE("Device list keeps the device info of cameras that stay connected", "[offline][context]") {
+    auto backend = std::make_shared<scripted_backend>();
+    backend->connect("first");
+    backend->connect("second");
+    auto ctx = std::make_shared<context>(backend);
+
+    // The devices are enumerated once, by the watcher as it starts, and repeated queries use its list
+    auto initial = ctx->query_devices();
+    REQUIRE(initial.size() == 2);
+    REQUIRE(ctx->query_devices() == initial);
+    REQUIRE(backend->enumerations == 1);
+
+    backend->disconnect("second");
+    backend->connect("third");
+    backend->watcher->raise();
+
+    auto changed = ctx->query_devices();
+    REQUIRE(changed.size() == 2);
+    auto data_of = [](const std::shared_ptr<device_info>& info) { return info->get_device_data().uvc_devices.front().unique_id; };
+    auto first = std::find_if(changed.begin(), changed.end(), [&](const std::shared_ptr<device_info>& info) { return data_of(info) == "first"; });
+    auto third = std::find_if(changed.begin(), changed.end(), [&](const std::shared_ptr<device_info>& info) { return data_of(info) == "third"; });
+    REQUIRE(first != changed.end());
+    REQUIRE(third != changed.end());
+    // Only the difference is built anew
+    REQUIRE(std::count(initial.begin(), initial.end(), *first) == 1);
+    REQUIRE(std::count(initial.begin(), initial.end(), *third) == 0);
+
+    ctx->stop();
+}
+
+TEST_CASE("Frames expose the dma-buf of their buffer while it is held", "[offline][dmabuf]") {
+    frame_generator depth(RS2_STREAM_DEPTH);
+
+    // A plain frame is not backed by a dma-buf
+    auto plain = depth.make(1, 1);
+    rs2_error* e = nullptr;
+    REQUIRE_FALSE(rs2_is_frame_extendable_to((rs2_frame*)plain.frame, RS2_EXTENSION_DMABUF_FRAME, &e));
+    REQUIRE(e == nullptr);
+    REQUIRE(rs2_get_frame_dmabuf_fd((rs2_frame*)plain.frame, &e) == -1);
+    REQUIRE(e != nullptr);
+    rs2_free_error(e);
+    e = nullptr;
+
+    // A frame referencing a backend buffer carries its descriptor until the buffer is given back
+    bool released = false;
+    auto frame = depth.make(2, 2);
+    frame_continuation release([&]() { released = true; }, frame->get_frame_data());
+    release.set_dmabuf({ 42, 64, 8 });
+    frame->attach_continuation(std::move(release));
+
+    REQUIRE(rs2_is_frame_extendable_to((rs2_frame*)frame.frame, RS2_EXTENSION_DMABUF_FRAME, &e));
+    REQUIRE(rs2_get_frame_dmabuf_fd((rs2_frame*)frame.frame, &e) == 42);
+    REQUIRE(rs2_get_frame_dmabuf_offset((rs2_frame*)frame.frame, &e) == 64);
+    REQUIRE(rs2_get_frame_dmabuf_stride((rs2_frame*)frame.frame, &e) == 8);
+    REQUIRE(e == nullptr);
+
+    REQUIRE_FALSE(released);
+    frame = frame_holder();
+    REQUIRE(released);
+}
+
+TEST_CASE("Motion batch frames keep every sample and its metadata", "[offline][motion-batch]") {
+    frame_source source;
+    source.init(std::make_shared<metadata_parser_map>());
+
+    const size_t capacity = 4;
+    const size_t metadata_size = 8;
+    frame_additional_data data{};
+    frame_holder frame = source.alloc_frame(RS2_EXTENSION_MOTION_BATCH_FRAME,
+                                            motion_batch_frame::get_data_size(capacity, metadata_size), data, true);
+    REQUIRE(frame);
+    auto batch = dynamic_cast<motion_batch_frame*>(frame.frame);
+    REQUIRE(batch);
+    batch->assign(capacity, metadata_size);
+
+    for (size_t i = 0; i < capacity; i++)
+    {
+        REQUIRE_FALSE(batch->is_full());
+        float xyz[3] = { float(i), float(i) + 0.25f, float(i) + 0.5f };
+        uint8_t metadata[metadata_size];
+        for (size_t b = 0; b < metadata_size; b++)
+            metadata[b] = static_cast<uint8_t>(i * 16 + b);
+        // The third sample arrives without metadata
+        batch->add_sample(xyz, 100. + i, 10 + i, i == 2 ? nullptr : metadata);
+    }
+    REQUIRE(batch->is_full());
+    REQUIRE(batch->get_frame_timestamp() == 103.);
+    REQUIRE(batch->get_frame_number() == 13);
+
+    rs2_error* e = nullptr;
+    REQUIRE(rs2_is_frame_extendable_to((rs2_frame*)frame.frame, RS2_EXTENSION_MOTION_BATCH_FRAME, &e));
+    rs2_motion_batch samples;
+    rs2_get_motion_batch((rs2_frame*)frame.frame, &samples, &e);
+    REQUIRE(e == nullptr);
+
+    REQUIRE(samples.count == capacity);
+    REQUIRE(samples.metadata_size == metadata_size);
+    for (size_t i = 0; i < capacity; i++)
+    {
+        REQUIRE(samples.timestamps[i] == 100. + i);
+        REQUIRE(samples.frame_numbers[i] == 10 + i);
+        REQUIRE(samples.x[i] == float(i));
+        REQUIRE(samples.y[i] == float(i) + 0.25f);
+        REQUIRE(samples.z[i] == float(i) + 0.5f);
+        for (size_t b = 0; b < metadata_size; b++)
+            REQUIRE(samples.metadata[i * metadata_size + b] == (i == 2 ? 0 : i * 16 + b));
+    }
+}
+
+#ifdef __linux__
+TEST_CASE("Library threads do not inherit the placement of the thread creating them", "[offline][thread-roles]") {
+    cpu_set_t process_cpus;
+    REQUIRE(sched_getaffinity(0, sizeof(process_cpus), &process_cpus) == 0);
+    auto first_cpu = 0;
+    while (!CPU_ISSET(first_cpu, &process_cpus)) first_cpu++;
+
+    // A role thread spawned by a pinned, possibly real-time, thread
+    auto spawn_from_pinned_thread = [&](rs2_thread_role role, cpu_set_t* cpus, int* policy)
+    {
+        std::thread creator([&]()
+        {
+            cpu_set_t pinned;
+            CPU_ZERO(&pinned);
+            CPU_SET(first_cpu, &pinned);
+            REQUIRE(pthread_setaffinity_np(pthread_self(), sizeof(pinned), &pinned) == 0);
+            sched_param param = {};
+            param.sched_priority = 1;
+            auto realtime = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0; // Needs privileges
+            CAPTURE(realtime);
+
+            std::thread worker([&]()
+            {
+                apply_thread_role(role);
+                sched_param param;
+                pthread_getaffinity_np(pthread_self(), sizeof(*cpus), cpus);
+                pthread_getschedparam(pthread_self(), policy, &param);
+            });
+            worker.join();
+        });
+        creator.join();
+    };
+
+    cpu_set_t cpus;
+    int policy = -1;
+    spawn_from_pinned_thread(RS2_THREAD_ROLE_DISPATCH, &cpus, &policy);
+    REQUIRE(CPU_EQUAL(&cpus, &process_cpus));
+    REQUIRE(policy == SCHED_OTHER);
+
+    // A role with an affinity of its own is pinned to it
+    if (first_cpu < 64)
+    {
+        thread_roles::get_instance().set_affinity(RS2_THREAD_ROLE_DISPATCH, 1ULL << first_cpu);
+        spawn_from_pinned_thread(RS2_THREAD_ROLE_DISPATCH, &cpus, &policy);
+        thread_roles::get_instance().set_affinity(RS2_THREAD_ROLE_DISPATCH, 0);
+        REQUIRE(CPU_COUNT(&cpus) == 1);
+        REQUIRE(CPU_ISSET(first_cpu, &cpus));
+        REQUIRE(policy == SCHED_OTHER);
+    }
+}
+#endif
+
+// The number of the frame a scripted recording returned, or -1 for the end of the file
+int frame_number_of(const std::shared_ptr<device_serializer::serialized_data>& data)
+{
+    REQUIRE(data);
+    if (data->is<device_serializer::serialized_end_of_file>()) return -1;
+    REQUIRE(data->is<device_serializer::serialized_frame>());
+    return static_cast<int>(scripted_reader::frame_at(data->get_timestamp()));
+}
+
+TEST_CASE("Read-ahead reader delivers the recording in order", "[offline][playback]") {
+    auto file = std::make_shared<scripted_reader>(20);
+    read_ahead_reader reader(file, 4);
+
+    // Nothing is read before playback asks for data
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(file->reads == 0);
+
+    for (auto i = 0; i < 5; i++)
+        REQUIRE(frame_number_of(reader.read_next_data()) == i);
+
+    // Four frames are kept ready, and no more
+    REQUIRE(wait_for([&]() { return file->reads == 9; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(file->reads == 9);
+
+    // Seeking drops what was read ahead
+    reader.seek_to_time(std::chrono::milliseconds(10));
+    REQUIRE(frame_number_of(reader.read_next_data()) == 10);
+    REQUIRE(frame_number_of(reader.read_next_data()) == 11);
+
+    // Without read-ahead, reading continues straight from the file where playback is
+    reader.set_read_ahead(0, DEFAULT_READ_AHEAD_BYTES);
+    auto reads = file->reads.load();
+    REQUIRE(frame_number_of(reader.read_next_data()) == 12);
+    REQUIRE(file->reads == reads + 1);
+
+    reader.set_read_ahead(4, DEFAULT_READ_AHEAD_BYTES);
+    for (auto i = 13; i < 20; i++)
+        REQUIRE(frame_number_of(reader.read_next_data()) == i);
+    REQUIRE(frame_number_of(reader.read_next_data()) == -1);
+    REQUIRE(frame_number_of(reader.read_next_data()) == -1);
+
+    reader.reset();
+    REQUIRE(frame_number_of(reader.read_next_data()) == 0);
+}
+
+TEST_CASE("Read-ahead reader drops disabled streams and reports errors in place", "[offline][playback]") {
+    auto file = std::make_shared<scripted_reader>(20);
+    // Every frame is 32 bytes, so only two fit
+    read_ahead_reader reader(file, 8, 64);
+
+    REQUIRE(frame_number_of(reader.read_next_data()) == 0);
+    REQUIRE(wait_for([&]() { return file->reads == 3; }));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    REQUIRE(file->reads == 3);
+
+    // Color frames already read ahead are dropped with the stream
+    reader.disable_stream({ scripted_reader::stream_of(1) });
+    for (auto i = 2; i < 12; i += 2)
+        REQUIRE(frame_number_of(reader.read_next_data()) == i);
+
+    // Frames read before the failure are still delivered, then the error is reported until the position changes
+    file->fail_at(16);
+    REQUIRE(frame_number_of(reader.read_next_data()) == 12);
+    REQUIRE(frame_number_of(reader.read_next_data()) == 14);
+    REQUIRE_THROWS_AS(reader.read_next_data(), io_exception);
+    REQUIRE_THROWS_AS(reader.read_next_data(), io_exception);
+
+    file->fail_at(20);
+    reader.seek_to_time(std::chrono::milliseconds(16));
+    REQUIRE(frame_number_of(reader.read_next_data()) == 16);
+    REQUIRE(frame_number_of(reader.read_next_data()) == 18);
+    REQUIRE(frame_number_of(reader.read_next_data()) == -1);
+}
+
+TEST_CASE("Read-ahead reader loses no data when rewound while reading", "[offline][playback]") {
+    const size_t frames = 2000;
+    auto file = std::make_shared<scripted_reader>(frames);
+    read_ahead_reader reader(file, 4);
+
+    for (size_t i = 0; i < frames; i++)
+    {
+        // Every rewind races with the read in progress on the read-ahead thread
+        if (i % 2)
+        {
+            reader.enable_stream({ scripted_reader::stream_of(i) });
+        }
+        else
+        {
+            reader.set_read_ahead(0, DEFAULT_READ_AHEAD_BYTES);
+            reader.set_read_ahead(4, DEFAULT_READ_AHEAD_BYTES);
+        }
+        REQUIRE(frame_number_of(reader.read_next_data()) == static_cast<int>(i));
+    }
+    REQUIRE(frame_number_of(reader.read_next_data()) == -1);
+}
+
+TEST_CASE("Recorded frames are found by number and by time", "[offline][playback]") {
+    const std::string file = "offline-frame-index.bag";
+    const size_t frames = 90;
+    record_test_file(file, frames, false);
+
+    {
+        ros_reader reader(file, nullptr);
+        REQUIRE(reader.query_frame_count(recorded_depth) == frames);
+        REQUIRE(reader.query_frame_count(recorded_infrared) == frames);
+        REQUIRE(reader.query_frame_count({ 0, 0, RS2_STREAM_COLOR, 0 }) == 0);
+
+        for (size_t n = 0; n < frames; n++)
+        {
+            auto time = recorded_frame_time(n);
+            REQUIRE(reader.query_frame_time(recorded_depth, n) == time);
+            REQUIRE(reader.query_frame_time(recorded_infrared, n) == time + std::chrono::milliseconds(1));
+
+            // The last frame at or before the time
+            REQUIRE(reader.query_frame_number(recorded_depth, time) == n);
+            REQUIRE(reader.query_frame_number(recorded_depth, time + std::chrono::milliseconds(32)) == n);
+            REQUIRE(reader.query_frame_number(recorded_infrared, time) == (n ? n - 1 : 0));
+        }
+        REQUIRE(reader.query_frame_number(recorded_depth, device_serializer::nanoseconds(0)) == 0);
+        REQUIRE_THROWS_AS(reader.query_frame_time(recorded_depth, frames), invalid_value_exception);
+
+        // Seeking to the time of a frame starts right at it, the time is not rounded past it
+        reader.enable_stream({ recorded_depth });
+        for (size_t n : { 0, 29, 30, 61, 89 })
+        {
+            reader.seek_to_time(reader.query_frame_time(recorded_depth, n));
+            auto data = reader.read_next_data();
+            while (data->is<device_serializer::serialized_option>())
+                data = reader.read_next_data();
+
+            auto played = to_played_data(*data);
+            REQUIRE(played.stream == recorded_depth);
+            REQUIRE(played.value == n);
+        }
+    }
+    std::remove(file.c_str());
+}
+
+TEST_CASE("Batch reading returns the data of a single reader", "[offline][playback]") {
+    const std::string file = "offline-batch-reading.bag";
+    record_test_file(file, 150, false);
+    auto open = [&file]() { return std::make_shared<ros_reader>(file, nullptr); };
+    auto played_after = [](const std::vector<played_data>& played, device_serializer::nanoseconds time)
+    {
+        std::vector<played_data> after;
+        std::copy_if(played.begin(), played.end(), std::back_inserter(after), [time](const played_data& p) { return p.time > time; });
+        return after;
+    };
+
+    {
+        auto single = open();
+        single->enable_stream({ recorded_depth, recorded_infrared });
+        auto expected = play_until_end(*single);
+        REQUIRE(std::any_of(expected.begin(), expected.end(), [](const played_data& p) { return p.option == RS2_OPTION_EXPOSURE; }));
+        REQUIRE(std::any_of(expected.begin(), expected.end(), [](const played_data& p) { return p.option == RS2_OPTION_LASER_POWER; }));
+
+        parallel_reader batch(open(), open);
+        batch.set_readers(4);
+        batch.enable_stream({ recorded_depth, recorded_infrared });
+        REQUIRE(play_until_end(batch) == expected);
+
+        // Every reader seeks into the middle of its segments, and still finds the option changes there
+        single->seek_to_time(std::chrono::milliseconds(1500));
+        batch.seek_to_time(std::chrono::milliseconds(1500));
+        REQUIRE(play_until_end(batch) == play_until_end(*single));
+
+        // Readers that already seeked far into the file are reused once another stream is enabled
+        batch.reset();
+        batch.enable_stream({ recorded_depth });
+        device_serializer::nanoseconds position(0);
+        while (position < std::chrono::milliseconds(2500))
+        {
+            auto data = batch.read_next_data();
+            REQUIRE_FALSE(data->is<device_serializer::serialized_end_of_file>());
+            position = data->get_timestamp();
+        }
+        batch.enable_stream({ recorded_infrared });
+        REQUIRE(played_after(play_until_end(batch), position) == played_after(expected, position));
+    }
+    std::remove(file.c_str());
+}
+
+TEST_CASE("Compressed recordings play back like uncompressed ones", "[offline][playback]") {
+    const std::string compressed = "offline-compressed.bag", uncompressed = "offline-uncompressed.bag";
+    record_test_file(compressed, 150, true);
+    record_test_file(uncompressed, 150, false);
+
+    {
+        ros_reader compressed_reader(compressed, nullptr), uncompressed_reader(uncompressed, nullptr);
+        compressed_reader.enable_stream({ recorded_depth, recorded_infrared });
+        uncompressed_reader.enable_stream({ recorded_depth, recorded_infrared });
+
+        auto played = play_until_end(uncompressed_reader);
+        REQUIRE(played.size() > 300);
+        REQUIRE(play_until_end(compressed_reader) == played);
+    }
+    std::remove(compressed.c_str());
+    std::remove(uncompressed.c_str());
+}
+
+TEST_CASE("Bag chunks compressed in the background are read back in order", "[offline][playback]") {
+    const std::string file = "offline-compression-threads.bag";
+    const std::vector<std::string> topics = { "/first", "/second", "/third" };
+    const uint32_t messages = 3000;
+
+    {
+        rosbag::Bag bag;
+        bag.open(file, rosbag::BagMode::Write);
+        bag.setCompression(rosbag::CompressionType::LZ4);
+        // Many small chunks, so that several threads compress at once
+        bag.setChunkThreshold(1024);
+        bag.setCompressionThreads(4);
+        for (uint32_t i = 0; i < messages; i++)
+        {
+            std_msgs::UInt32 msg;
+            msg.data = i;
+            bag.write(topics[i % topics.size()], ros::Time(1, i * 1000), msg);
+        }
+        bag.close();
+    }
+
+    {
+        rosbag::Bag bag;
+        bag.open(file, rosbag::BagMode::Read);
+        rosbag::View view(bag);
+        uint32_t i = 0;
+        for (auto&& m : view)
+        {
+            REQUIRE(m.getTopic() == topics[i % topics.size()]);
+            REQUIRE(m.getTime() == ros::Time(1, i * 1000));
+            auto msg = m.instantiate<std_msgs::UInt32>();
+            REQUIRE(msg);
+            REQUIRE(msg->data == i);
+            i++;
+        }
+        REQUIRE(i == messages);
+    }
+    std::remove(file.c_str());
+}
@@ -13,6 +13,10 @@
 #include <chrono>
 #include <ctime>
 #include <algorithm>
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 using namespace rs2;
 
@@ -4069,3 +4073,340 @@ TEST_CASE("Pipeline record and playback", "[live]") {
         }
     }
 }
+
+TEST_CASE("Async processing block preserves frame order", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        REQUIRE_NOTHROW(rs2::configure_processing_executor(4));
+        REQUIRE(rs2::get_processing_executor_worker_count() == 4);
+
+        std::mutex m;
+        std::map<int, std::vector<unsigned long long>> frame_numbers;
+        rs2::processing_block block([&](rs2::frame f, const rs2::frame_source& src)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            frame_numbers[f.get_profile().unique_id()].push_back(f.get_frame_number());
+        });
+        REQUIRE_NOTHROW(block.set_async(true));
+
+        rs2::pipeline pipe(ctx);
+        REQUIRE_NOTHROW(pipe.start());
+        for (auto i = 0; i < 100; i++)
+        {
+            rs2::frameset frames;
+            REQUIRE_NOTHROW(frames = pipe.wait_for_frames(10000));
+            for (auto&& f : frames)
+                block.invoke(f);
+        }
+        REQUIRE_NOTHROW(pipe.stop());
+        REQUIRE_NOTHROW(block.set_async(false));
+
+        std::lock_guard<std::mutex> lock(m);
+        REQUIRE(frame_numbers.size() > 0);
+        for (auto&& stream : frame_numbers)
+        {
+            CAPTURE(stream.first);
+            REQUIRE(std::is_sorted(stream.second.begin(), stream.second.end()));
+        }
+
+        REQUIRE_NOTHROW(rs2::configure_processing_executor(0));
+    }
+}
+
+TEST_CASE("Processing graph fan-out and join", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        rs2::pipeline pipe(ctx);
+        rs2::config cfg;
+        cfg.enable_stream(RS2_STREAM_DEPTH);
+        cfg.enable_stream(RS2_STREAM_COLOR);
+        REQUIRE_NOTHROW(pipe.start(cfg));
+
+        rs2::processing_graph graph;
+        rs2::temporal_filter temporal;
+        rs2::colorizer color_map;
+        rs2::pointcloud pc;
+        rs2::align align_to_color(RS2_STREAM_COLOR);
+
+        int temporal_node, colorizer_node, pointcloud_node, join_node, align_node;
+        REQUIRE_NOTHROW(temporal_node = graph.add(temporal));
+        REQUIRE_NOTHROW(colorizer_node = graph.add(color_map));
+        REQUIRE_NOTHROW(pointcloud_node = graph.add(pc));
+        REQUIRE_NOTHROW(join_node = graph.add_join());
+        REQUIRE_NOTHROW(align_node = graph.add(align_to_color));
+
+        REQUIRE_NOTHROW(graph.connect_input(temporal_node, RS2_STREAM_DEPTH));
+        REQUIRE_NOTHROW(graph.connect(temporal_node, colorizer_node));
+        REQUIRE_NOTHROW(graph.connect(temporal_node, pointcloud_node));
+        REQUIRE_NOTHROW(graph.connect(temporal_node, join_node));
+        REQUIRE_NOTHROW(graph.connect_input(join_node, RS2_STREAM_COLOR));
+        REQUIRE_NOTHROW(graph.connect(join_node, align_node));
+        REQUIRE_THROWS(graph.connect(align_node, temporal_node));
+        REQUIRE_NOTHROW(graph.connect_output(colorizer_node));
+        REQUIRE_NOTHROW(graph.connect_output(pointcloud_node));
+        REQUIRE_NOTHROW(graph.connect_output(align_node));
+
+        std::mutex m;
+        bool got_colorized = false, got_points = false, got_aligned = false;
+        graph.start([&](rs2::frame f)
+        {
+            std::lock_guard<std::mutex> lock(m);
+            if (f.is<rs2::points>()) got_points = true;
+            else if (f.is<rs2::frameset>()) got_aligned = true;
+            else if (f.get_profile().format() == RS2_FORMAT_RGB8) got_colorized = true;
+        });
+
+        for (auto i = 0; i < 100; i++)
+        {
+            rs2::frameset frames;
+            REQUIRE_NOTHROW(frames = pipe.wait_for_frames(10000));
+            REQUIRE_NOTHROW(graph.invoke(frames));
+        }
+        REQUIRE_THROWS(graph.connect(temporal_node, align_node));
+        REQUIRE_NOTHROW(pipe.stop());
+        std::this_thread::sleep_for(std::chrono::milliseconds(500));
+
+        std::lock_guard<std::mutex> lock(m);
+        REQUIRE(got_colorized);
+        REQUIRE(got_points);
+        REQUIRE(got_aligned);
+    }
+}
+
+TEST_CASE("Pipeline latest frameset only", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        rs2::pipeline pipe(ctx);
+        rs2::config cfg;
+        cfg.enable_stream(RS2_STREAM_DEPTH);
+        REQUIRE_NOTHROW(cfg.enable_latest_frameset_only());
+        REQUIRE_NOTHROW(pipe.start(cfg));
+
+        unsigned long long prev_number = 0;
+        for (auto i = 0; i < 10; i++)
+        {
+            rs2::frameset frames;
+            REQUIRE_NOTHROW(frames = pipe.wait_for_frames(10000));
+            REQUIRE(frames.size() > 0);
+
+            auto number = frames.get_depth_frame().get_frame_number();
+            REQUIRE(number > prev_number);
+            prev_number = number;
+
+            // While the consumer lags, intermediate sets are overwritten rather than queued
+            std::this_thread::sleep_for(std::chrono::milliseconds(200));
+            REQUIRE(pipe.poll_for_frames(&frames));
+            REQUIRE(frames.get_depth_frame().get_frame_number() > prev_number + 1);
+            prev_number = frames.get_depth_frame().get_frame_number();
+        }
+        REQUIRE_NOTHROW(pipe.stop());
+    }
+}
+
+TEST_CASE("Pipeline post-processing", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        rs2::pipeline pipe(ctx);
+        rs2::config cfg;
+        cfg.enable_stream(RS2_STREAM_DEPTH);
+        cfg.enable_stream(RS2_STREAM_INFRARED, 1);
+
+        auto profile = cfg.resolve(pipe);
+        auto depth_profile = profile.get_stream(RS2_STREAM_DEPTH).as<rs2::video_stream_profile>();
+
+        rs2::decimation_filter decimate;
+        REQUIRE_NOTHROW(cfg.add_post_processing_block(decimate));
+        REQUIRE_NOTHROW(pipe.start(cfg));
+
+        for (auto i = 0; i < 10; i++)
+        {
+            rs2::frameset frames;
+            REQUIRE_NOTHROW(frames = pipe.wait_for_frames(10000));
+
+            // The filtered depth frame replaces the original, the infrared frame passes through
+            REQUIRE(frames.size() == 2);
+            auto depth = frames.get_depth_frame();
+            REQUIRE(depth);
+            REQUIRE(depth.get_width() < depth_profile.width());
+            REQUIRE(frames.first_or_default(RS2_STREAM_INFRARED));
+        }
+        REQUIRE_NOTHROW(pipe.stop());
+    }
+}
+
+TEST_CASE("Thread roles configuration", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        REQUIRE_THROWS(rs2::set_thread_role_scheduling(RS2_THREAD_ROLE_CAPTURE, RS2_SCHEDULING_POLICY_FIFO, 0));
+        REQUIRE_THROWS(rs2::set_thread_role_scheduling(RS2_THREAD_ROLE_COUNT, RS2_SCHEDULING_POLICY_DEFAULT, 0));
+        REQUIRE_NOTHROW(rs2::set_thread_role_name(RS2_THREAD_ROLE_CAPTURE, "test-capture"));
+        REQUIRE_NOTHROW(rs2::set_thread_role_affinity(RS2_THREAD_ROLE_CAPTURE, 1));
+
+        // Threads that can not be given the requested scheduling keep streaming
+        REQUIRE_NOTHROW(rs2::set_thread_role_scheduling(RS2_THREAD_ROLE_CAPTURE, RS2_SCHEDULING_POLICY_FIFO, 10));
+#ifdef __linux__
+        bool realtime = false;
+        std::thread([&]()
+        {
+            sched_param param = {};
+            param.sched_priority = 10;
+            realtime = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param) == 0;
+        }).join();
+#endif
+
+        auto list = ctx.query_devices();
+        REQUIRE(list.size());
+        auto sensor = list[0].query_sensors().front();
+        auto profiles = sensor.get_stream_profiles();
+        auto it = std::find_if(profiles.begin(), profiles.end(), [](const rs2::stream_profile& p) { return p.is_default(); });
+        REQUIRE(it != profiles.end());
+
+        // Frame callbacks run on the capture thread, check that it was given the configuration of its role
+        std::atomic<int> frames(0), placed(0);
+        REQUIRE_NOTHROW(sensor.open(*it));
+        REQUIRE_NOTHROW(sensor.start([&](rs2::frame f)
+        {
+            frames++;
+#ifdef __linux__
+            char name[16] = {};
+            cpu_set_t cpus;
+            int policy;
+            sched_param param;
+            pthread_getname_np(pthread_self(), name, sizeof(name));
+            pthread_getaffinity_np(pthread_self(), sizeof(cpus), &cpus);
+            pthread_getschedparam(pthread_self(), &policy, &param);
+            if (std::string(name) == "test-capture" && CPU_COUNT(&cpus) == 1 && CPU_ISSET(0, &cpus) &&
+                policy == (realtime ? SCHED_FIFO : SCHED_OTHER))
+                placed++;
+#else
+            placed++;
+#endif
+        }));
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+        REQUIRE_NOTHROW(sensor.stop());
+        REQUIRE_NOTHROW(sensor.close());
+        REQUIRE(frames > 0);
+        REQUIRE(placed == frames);
+
+        // The default policy and an empty mask undo the configuration for threads spawned afterwards
+        REQUIRE_NOTHROW(rs2::set_thread_role_scheduling(RS2_THREAD_ROLE_CAPTURE, RS2_SCHEDULING_POLICY_DEFAULT, 0));
+        REQUIRE_NOTHROW(rs2::set_thread_role_affinity(RS2_THREAD_ROLE_CAPTURE, 0));
+        REQUIRE_NOTHROW(rs2::set_thread_role_name(RS2_THREAD_ROLE_CAPTURE, "rs-capture"));
+    }
+}
+
+TEST_CASE("Backend timestamps and stream latency", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        auto list = ctx.query_devices();
+        REQUIRE(list.size());
+
+        auto sensor = list[0].query_sensors().front();
+        auto profiles = sensor.get_stream_profiles();
+        auto it = std::find_if(profiles.begin(), profiles.end(), [](const rs2::stream_profile& p) { return p.is_default(); });
+        REQUIRE(it != profiles.end());
+        auto profile = *it;
+
+        std::atomic<int> timestamped(0);
+        REQUIRE_NOTHROW(sensor.open(profile));
+        REQUIRE_NOTHROW(sensor.start([&](rs2::frame f)
+        {
+            if (f.supports_frame_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP))
+            {
+                timestamped++;
+                REQUIRE(f.get_frame_metadata(RS2_FRAME_METADATA_BACKEND_TIMESTAMP) > 0);
+            }
+        }));
+        std::this_thread::sleep_for(std::chrono::seconds(2));
+        REQUIRE_NOTHROW(sensor.stop());
+
+        // Latency is measured for exactly the frames that carry a backend timestamp
+        auto stats = sensor.get_latency_stats(profile);
+        REQUIRE(stats.frames == static_cast<unsigned long long>(timestamped.load()));
+        if (stats.frames)
+        {
+            REQUIRE(stats.min_ms >= 0);
+            REQUIRE(stats.min_ms <= stats.average_ms);
+            REQUIRE(stats.average_ms <= stats.max_ms);
+        }
+        REQUIRE_NOTHROW(sensor.close());
+    }
+}
+
+TEST_CASE("Warm restart of the same profile", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        auto list = ctx.query_devices();
+        REQUIRE(list.size());
+
+        auto sensor = list[0].query_sensors().front();
+        if (!sensor.supports(RS2_OPTION_WARM_RESTART)) return;
+
+        auto profiles = sensor.get_stream_profiles();
+        auto it = std::find_if(profiles.begin(), profiles.end(), [](const rs2::stream_profile& p) { return p.is_default(); });
+        REQUIRE(it != profiles.end());
+        auto profile = *it;
+
+        REQUIRE_NOTHROW(sensor.set_option(RS2_OPTION_WARM_RESTART, 1));
+        for (auto i = 0; i < 3; i++)
+        {
+            std::atomic<int> frames(0);
+            REQUIRE_NOTHROW(sensor.open(profile));
+            REQUIRE_NOTHROW(sensor.start([&](rs2::frame f) { frames++; }));
+            std::this_thread::sleep_for(std::chrono::seconds(1));
+            REQUIRE_NOTHROW(sensor.stop());
+            REQUIRE_NOTHROW(sensor.close());
+
+            REQUIRE(frames > 0);
+            REQUIRE(sensor.get_option(RS2_OPTION_OPEN_LATENCY) >= 0);
+            REQUIRE(sensor.get_option(RS2_OPTION_START_LATENCY) > 0);
+        }
+
+        auto range = sensor.get_option_range(RS2_OPTION_START_LATENCY);
+        REQUIRE(range.step == 1);
+        REQUIRE(std::isfinite(range.max));
+        REQUIRE(sensor.get_option(RS2_OPTION_START_LATENCY) <= range.max);
+        REQUIRE_NOTHROW(sensor.set_option(RS2_OPTION_WARM_RESTART, 0));
+    }
+}
+
+TEST_CASE("Devices changed callback after repeated queries", "[live]") {
+    rs2::context ctx;
+
+    if (make_context(SECTION_FROM_TEST_NAME, &ctx))
+    {
+        // The first query may start the device watcher, the second must be served from the same list
+        rs2::device_list first, second;
+        REQUIRE_NOTHROW(first = ctx.query_devices());
+        REQUIRE_NOTHROW(second = ctx.query_devices());
+        REQUIRE(first.size());
+        REQUIRE(first.size() == second.size());
+        for (uint32_t i = 0; i < first.size(); i++)
+        {
+            REQUIRE(std::string(first[i].get_info(RS2_CAMERA_INFO_SERIAL_NUMBER)) ==
+                    std::string(second[i].get_info(RS2_CAMERA_INFO_SERIAL_NUMBER)));
+        }
+
+        // Registering a callback on a context that already watches must not restart the watcher
+        REQUIRE_NOTHROW(ctx.set_devices_changed_callback([](rs2::event_information&) {}));
+        REQUIRE_NOTHROW(ctx.set_devices_changed_callback([](rs2::event_information&) {}));
+
+        rs2::device_list third;
+        REQUIRE_NOTHROW(third = ctx.query_devices());
+        REQUIRE(third.size() == first.size());
+    }
+}
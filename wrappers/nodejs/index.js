@@ -4043,6 +4043,11 @@ const frame_metadata = {
      * system clock  <br>Equivalent to its uppercase counterpart
      */
     frame_metadata_time_of_arrival: 'time-of-arrival',
+    /**
+     * String literal of <code>'backend-timestamp'</code>. <br>Time the host driver completed the
+     * frame at, in system clock. usec <br>Equivalent to its uppercase counterpart
+     */
+    frame_metadata_backend_timestamp: 'backend-timestamp',
     /**
      * A sequential index managed per-stream. Integer value <br>Equivalent to its lowercase
      * counterpart.
@@ -4091,6 +4096,12 @@ const frame_metadata = {
      * @type {Integer}
      */
     FRAME_METADATA_TIME_OF_ARRIVAL: RS2.RS2_FRAME_METADATA_TIME_OF_ARRIVAL,
+    /**
+     * Time the host driver completed the frame at, in system clock. usec <br>Equivalent to its
+     * lowercase counterpart.
+     * @type {Integer}
+     */
+    FRAME_METADATA_BACKEND_TIMESTAMP: RS2.RS2_FRAME_METADATA_BACKEND_TIMESTAMP,
     /**
      * Number of enumeration values. Not a valid input: intended to be used in for-loops.
      * @type {Integer}
@@ -4128,6 +4139,8 @@ const frame_metadata = {
             return this.frame_metadata_white_balance;
           case this.FRAME_METADATA_TIME_OF_ARRIVAL:
             return this.frame_metadata_time_of_arrival;
+          case this.FRAME_METADATA_BACKEND_TIMESTAMP:
+            return this.frame_metadata_backend_timestamp;
         }
       }
     },
@@ -4360,6 +4373,12 @@ const timestamp_domain = {
      * to the OS system clock <br>Equivalent to its uppercase counterpart.
      */
     timestamp_domain_system_time: 'system-time',
+    /**
+     * String literal of <code>'backend-time'</code>. <br>Frame timestamp was taken by the host
+     * driver when the frame completed, in OS system clock <br>Equivalent to its uppercase
+     * counterpart.
+     */
+    timestamp_domain_backend_time: 'backend-time',
 
     /**
      * Frame timestamp was measured in relation to the camera clock <br>Equivalent to its lowercase
@@ -4373,6 +4392,12 @@ const timestamp_domain = {
      * @type {Integer}
      */
     TIMESTAMP_DOMAIN_SYSTEM_TIME: RS2.RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME,
+    /**
+     * Frame timestamp was taken by the host driver when the frame completed, in OS system clock
+     * <br>Equivalent to its lowercase counterpart.
+     * @type {Integer}
+     */
+    TIMESTAMP_DOMAIN_BACKEND_TIME: RS2.RS2_TIMESTAMP_DOMAIN_BACKEND_TIME,
     /**
      * Number of enumeration values. Not a valid input: intended to be used in for-loops.
      * @type {Integer}
@@ -4397,6 +4422,8 @@ const timestamp_domain = {
           return this.timestamp_domain_hardware_clock;
         case this.TIMESTAMP_DOMAIN_SYSTEM_TIME:
           return this.timestamp_domain_system_time;
+        case this.TIMESTAMP_DOMAIN_BACKEND_TIME:
+          return this.timestamp_domain_backend_time;
         default:
           throw new TypeError('timestamp_domain.timestampDomainToString() expects a valid value as the 1st argument'); // eslint-disable-line
       }
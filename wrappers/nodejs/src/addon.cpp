@@ -3748,6 +3748,7 @@ void InitModule(v8::Local<v8::Object> exports) {
   _FORCE_SET_ENUM(RS2_FRAME_METADATA_AUTO_EXPOSURE);
   _FORCE_SET_ENUM(RS2_FRAME_METADATA_WHITE_BALANCE);
   _FORCE_SET_ENUM(RS2_FRAME_METADATA_TIME_OF_ARRIVAL);
+  _FORCE_SET_ENUM(RS2_FRAME_METADATA_BACKEND_TIMESTAMP);
   _FORCE_SET_ENUM(RS2_FRAME_METADATA_COUNT);
 
   // rs2_distortion
@@ -3826,6 +3827,7 @@ void InitModule(v8::Local<v8::Object> exports) {
   // rs2_timestamp_domain
   _FORCE_SET_ENUM(RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK);
   _FORCE_SET_ENUM(RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME);
+  _FORCE_SET_ENUM(RS2_TIMESTAMP_DOMAIN_BACKEND_TIME);
   _FORCE_SET_ENUM(RS2_TIMESTAMP_DOMAIN_COUNT);
 
   // rs2_recording_mode
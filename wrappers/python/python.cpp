@@ -89,6 +89,7 @@ PYBIND11_PLUGIN(NAME) {
                   .value("auto_exposure", RS2_FRAME_METADATA_AUTO_EXPOSURE)
                   .value("white_balance", RS2_FRAME_METADATA_WHITE_BALANCE)
                   .value("time_of_arrival", RS2_FRAME_METADATA_TIME_OF_ARRIVAL)
+                  .value("backend_timestamp", RS2_FRAME_METADATA_BACKEND_TIMESTAMP)
                   .value("count", RS2_FRAME_METADATA_COUNT);
 
     py::enum_<rs2_stream> stream(m, "stream");
@@ -201,6 +202,7 @@ PYBIND11_PLUGIN(NAME) {
     py::enum_<rs2_timestamp_domain> ts_domain(m, "timestamp_domain");
     ts_domain.value("hardware_clock", RS2_TIMESTAMP_DOMAIN_HARDWARE_CLOCK)
              .value("system_time", RS2_TIMESTAMP_DOMAIN_SYSTEM_TIME)
+             .value("backend_time", RS2_TIMESTAMP_DOMAIN_BACKEND_TIME)
              .value("count", RS2_TIMESTAMP_DOMAIN_COUNT);
 
     py::enum_<rs2_distortion> distortion(m, "distortion");